@@ -0,0 +1,443 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the BatchPipeline class defined in
+    BatchPipeline.h, and needs C++20. The read stage reads each
+    line and parses its operands into LargeNumber values, the
+    compute stage applies the parsed operation to the current
+    number and passes on a copy of the result (the copy shares
+    the number's blocks), and the write stage formats that copy
+    and writes it out. Every stage coroutine is resumed only on
+    its own StageThread. A channel between two stages holds up to
+    its capacity of lines; pushing into a full channel or popping
+    from an empty one suspends the coroutine and records its
+    handle in the channel, and the stage on the other side
+    schedules that handle back onto its thread once it has taken
+    a line or supplied one. Closing a channel ends the stage
+    after it; a stage that stops early cancels its input channel,
+    so the stage before it is never left waiting.
+    It requires BatchPipeline.h, ProgramManager.h, <chrono>,
+    <condition_variable>, <coroutine>, <deque>, <exception>,
+    <mutex>, <optional>, <string>, <thread>, and <utility> to run.
+-------------------------------------------------- */
+
+#include "BatchPipeline.h"
+#include "ProgramManager.h"
+#include <chrono> // For throughput (steady_clock)
+#include <condition_variable>
+#include <coroutine> // For the stages (coroutine_handle and suspend_always)
+#include <deque>
+#include <exception> // For stage failures (exception_ptr)
+#include <mutex>
+#include <optional> // For the end of a channel (optional)
+#include <string>
+#include <thread>
+#include <utility> // For moving lines (move() and exchange())
+
+using namespace std;
+
+const size_t BatchPipeline::DEFAULT_CAPACITY;
+
+namespace {
+
+    // Output is written once it passes this many bytes, as in runBatch()
+    const size_t FLUSH_BYTES = 1 << 16;
+
+    // A thread that resumes the coroutine handles scheduled on it, in order
+    class StageThread {
+    public:
+        StageThread() : stopping(false), worker([this]() { run(); }) {
+        }
+
+        ~StageThread() {
+            {
+                lock_guard<mutex> guard(lock);
+                stopping = true;
+            }
+            ready.notify_one();
+            worker.join();
+        }
+
+        StageThread(const StageThread&) = delete;
+        StageThread& operator=(const StageThread&) = delete;
+
+        void schedule(coroutine_handle<> handle) {
+            {
+                lock_guard<mutex> guard(lock);
+                handles.push_back(handle);
+            }
+            ready.notify_one();
+        }
+
+    private:
+        mutex lock;
+        condition_variable ready;
+        deque<coroutine_handle<>> handles;
+        bool stopping;
+        thread worker; // Declared last, so it starts once the members above exist
+
+        void run() {
+            while (true) {
+                coroutine_handle<> handle;
+                {
+                    unique_lock<mutex> guard(lock);
+                    ready.wait(guard, [this]() { return stopping || !handles.empty(); });
+                    if (handles.empty()) {
+                        return;
+                    }
+                    handle = handles.front();
+                    handles.pop_front();
+                }
+                handle.resume();
+            }
+        }
+    };
+
+    // Stages still running, which the caller waits on
+    class Completion {
+    public:
+        explicit Completion(int stages) : remaining(stages) {
+        }
+
+        void finish() {
+            lock_guard<mutex> guard(lock);
+            if (--remaining == 0) {
+                done.notify_all();
+            }
+        }
+
+        void wait() {
+            unique_lock<mutex> guard(lock);
+            done.wait(guard, [this]() { return remaining == 0; });
+        }
+
+    private:
+        mutex lock;
+        condition_variable done;
+        int remaining;
+    };
+
+    // Coroutine of one stage: it runs once started on its thread and reports to a Completion when done
+    class StageTask {
+    public:
+        struct promise_type {
+            Completion* completion = nullptr;
+            exception_ptr error;
+
+            // Report only once suspended for the last time, so the frame may be destroyed right away
+            struct FinalAwaiter {
+                bool await_ready() noexcept { return false; }
+                void await_suspend(coroutine_handle<promise_type> handle) noexcept { handle.promise().completion->finish(); }
+                void await_resume() noexcept {}
+            };
+
+            StageTask get_return_object() { return StageTask(coroutine_handle<promise_type>::from_promise(*this)); }
+            suspend_always initial_suspend() noexcept { return {}; }
+            FinalAwaiter final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { error = current_exception(); }
+        };
+
+        explicit StageTask(coroutine_handle<promise_type> handle) : handle(handle) {
+        }
+
+        StageTask(StageTask&& other) noexcept : handle(exchange(other.handle, nullptr)) {
+        }
+
+        ~StageTask() {
+            if (handle) {
+                handle.destroy();
+            }
+        }
+
+        StageTask(const StageTask&) = delete;
+        StageTask& operator=(const StageTask&) = delete;
+
+        void start(StageThread& thread, Completion& completion) {
+            handle.promise().completion = &completion;
+            thread.schedule(handle);
+        }
+
+        // Rethrow what ended the stage early, if anything
+        void check() const {
+            if (handle.promise().error) {
+                rethrow_exception(handle.promise().error);
+            }
+        }
+
+    private:
+        coroutine_handle<promise_type> handle;
+    };
+
+    // Bounded queue between two stages, each running on its own StageThread
+    template <typename T>
+    class Channel {
+    public:
+        class PopAwaiter;
+
+        // Awaitable push: suspends while the channel is full, and yields false once the consumer is gone
+        class PushAwaiter {
+        public:
+            PushAwaiter(Channel& channel, T&& item, StageThread& thread)
+                : channel(channel), item(move(item)), thread(thread), accepted(true) {
+            }
+
+            bool await_ready() { return false; }
+
+            bool await_suspend(coroutine_handle<> handle) {
+                lock_guard<mutex> guard(channel.lock);
+                if (channel.cancelled) {
+                    accepted = false;
+                    return false;
+                }
+
+                // A waiting consumer has an empty channel, so the item goes straight to it
+                if (channel.waitingPop) {
+                    PopAwaiter* pop = exchange(channel.waitingPop, nullptr);
+                    pop->item = move(item);
+                    pop->thread.schedule(pop->handle);
+                    return false;
+                }
+                if (channel.items.size() < channel.capacity) {
+                    channel.items.push_back(move(item));
+                    return false;
+                }
+                this->handle = handle;
+                channel.waitingPush = this;
+                return true;
+            }
+
+            bool await_resume() { return accepted; }
+
+        private:
+            friend class Channel;
+            friend class PopAwaiter;
+            Channel& channel;
+            T item;
+            StageThread& thread;
+            coroutine_handle<> handle;
+            bool accepted;
+        };
+
+        // Awaitable pop: suspends while the channel is empty, and yields nothing once it is closed or cancelled
+        class PopAwaiter {
+        public:
+            PopAwaiter(Channel& channel, StageThread& thread) : channel(channel), thread(thread) {
+            }
+
+            bool await_ready() { return false; }
+
+            bool await_suspend(coroutine_handle<> handle) {
+                lock_guard<mutex> guard(channel.lock);
+                if (!channel.items.empty()) {
+                    item = move(channel.items.front());
+                    channel.items.pop_front();
+
+                    // The line just taken made room for the one a waiting producer holds
+                    if (channel.waitingPush) {
+                        PushAwaiter* push = exchange(channel.waitingPush, nullptr);
+                        channel.items.push_back(move(push->item));
+                        push->thread.schedule(push->handle);
+                    }
+                    return false;
+                }
+                if (channel.closed || channel.cancelled) {
+                    return false;
+                }
+                this->handle = handle;
+                channel.waitingPop = this;
+                return true;
+            }
+
+            optional<T> await_resume() { return move(item); }
+
+        private:
+            friend class Channel;
+            friend class PushAwaiter;
+            Channel& channel;
+            StageThread& thread;
+            coroutine_handle<> handle;
+            optional<T> item;
+        };
+
+        explicit Channel(size_t capacity) : capacity(capacity > 0 ? capacity : 1) {
+        }
+
+        PushAwaiter push(T&& item, StageThread& thread) { return PushAwaiter(*this, move(item), thread); }
+        PopAwaiter pop(StageThread& thread) { return PopAwaiter(*this, thread); }
+
+        // Producer side: no more lines will come
+        void close() {
+            lock_guard<mutex> guard(lock);
+            closed = true;
+            if (waitingPop) {
+                PopAwaiter* pop = exchange(waitingPop, nullptr);
+                pop->thread.schedule(pop->handle);
+            }
+        }
+
+        // Consumer side: no more lines will be taken, so a waiting producer is let go
+        void cancel() {
+            lock_guard<mutex> guard(lock);
+            cancelled = true;
+            items.clear();
+            if (waitingPush) {
+                PushAwaiter* push = exchange(waitingPush, nullptr);
+                push->accepted = false;
+                push->thread.schedule(push->handle);
+            }
+        }
+
+    private:
+        mutex lock;
+        deque<T> items;
+        size_t capacity;
+        bool closed = false;
+        bool cancelled = false;
+        PushAwaiter* waitingPush = nullptr;
+        PopAwaiter* waitingPop = nullptr;
+    };
+
+    // Ends a stage's channels however the stage finishes: its output is closed, and
+    // its input is cancelled in case it stopped before reading everything
+    template <typename In, typename Out>
+    class ChannelEnds {
+    public:
+        ChannelEnds(Channel<In>* input, Channel<Out>* output) : input(input), output(output) {
+        }
+
+        ~ChannelEnds() {
+            if (input) {
+                input->cancel();
+            }
+            if (output) {
+                output->close();
+            }
+        }
+
+        ChannelEnds(const ChannelEnds&) = delete;
+        ChannelEnds& operator=(const ChannelEnds&) = delete;
+
+    private:
+        Channel<In>* input;
+        Channel<Out>* output;
+    };
+}
+
+// Run a batch with reading, computing, and writing on their own threads
+size_t BatchPipeline::run(istream& input, ostream& output, ostream& log, size_t capacity) {
+
+    // One batch line on its way through the stages
+    struct Line {
+        size_t number = 0;
+        ProgramManager::BatchStep step;
+        LargeNumber result; // The number after this line; a copy that shares its blocks
+        string error;
+    };
+
+    Channel<Line> parsed(capacity);
+    Channel<Line> computed(capacity);
+    size_t operations = 0;
+    size_t errors = 0;
+    size_t bytes = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    // Declared before the tasks, so their frames are destroyed before the threads stop
+    StageThread readThread;
+    StageThread computeThread;
+    StageThread writeThread;
+
+    // Read and parse lines, so operands are converted while earlier lines compute
+    auto readStage = [&]() -> StageTask {
+        ChannelEnds<Line, Line> ends(nullptr, &parsed);
+        string text;
+        ProgramManager::Tokens tokens;
+        size_t lineNumber = 0;
+        while (getline(input, text)) {
+            lineNumber++;
+            bytes += text.size() + 1;
+            ProgramManager::splitTokens(text, tokens);
+            if (tokens.empty() || text[tokens[0].first] == '#') {
+                continue;
+            }
+            Line line;
+            line.number = lineNumber;
+            try {
+                ProgramManager::parseBatchOperation(text, tokens, line.step);
+            }
+            catch (const exception& e) {
+                line.error = e.what();
+            }
+            if (!co_await parsed.push(move(line), readThread)) {
+                break;
+            }
+        }
+    };
+
+    // Apply each parsed line to the current number, leaving failed lines for the writer to report
+    auto computeStage = [&]() -> StageTask {
+        ChannelEnds<Line, Line> ends(&parsed, &computed);
+        LargeNumber number("0");
+        while (optional<Line> line = co_await parsed.pop(computeThread)) {
+            if (line->error.empty()) {
+                try {
+                    ProgramManager::applyBatchOperation(line->step, number);
+                    if (!ProgramManager::isFileOperation(line->step.operation)) {
+                        line->result = number;
+                    }
+                }
+                catch (const exception& e) {
+                    line->error = e.what();
+                }
+            }
+            line->step.operands.clear();
+            if (!co_await computed.push(move(*line), computeThread)) {
+                break;
+            }
+        }
+    };
+
+    // Format the results in line order and write them in large chunks
+    auto writeStage = [&]() -> StageTask {
+        ChannelEnds<Line, Line> ends(&computed, nullptr);
+        string buffer;
+        while (optional<Line> line = co_await computed.pop(writeThread)) {
+            operations++;
+            if (line->error.empty()) {
+                try {
+                    ProgramManager::formatBatchResult(line->step, line->result, buffer);
+                }
+                catch (const exception& e) {
+                    line->error = e.what();
+                }
+            }
+            if (!line->error.empty()) {
+                errors++;
+                buffer += "error line " + to_string(line->number) + ": " + line->error + "\n";
+            }
+            if (buffer.size() >= FLUSH_BYTES) {
+                output.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+                buffer.clear();
+            }
+        }
+        output.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+        output.flush();
+    };
+
+    Completion completion(3);
+    StageTask reader = readStage();
+    StageTask computer = computeStage();
+    StageTask writer = writeStage();
+    reader.start(readThread, completion);
+    computer.start(computeThread, completion);
+    writer.start(writeThread, completion);
+    completion.wait();
+    reader.check();
+    computer.check();
+    writer.check();
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    ProgramManager::reportBatch(log, "Pipelined batch", operations, errors, bytes, seconds);
+    return errors;
+}
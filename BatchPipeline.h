@@ -0,0 +1,43 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the BatchPipeline class, which runs
+    a batch of calculator operations like ProgramManager::runBatch
+    but with reading and parsing, arithmetic, and formatting and
+    writing the results on three threads at once. Each stage is a
+    C++20 coroutine with a thread of its own, and the stages pass
+    lines along through bounded queues: a stage that finds the
+    next queue full or its input queue empty is suspended until
+    the neighbouring stage makes room or supplies a line, so a
+    slow stage holds back the ones before it instead of letting
+    work pile up. Lines keep their order through every stage, so
+    the output matches runBatch() line for line.
+    The header itself needs only C++14; BatchPipeline.cpp is
+    built as C++20, and LARGE_NUMBER_PIPELINE is defined for the
+    code that uses it when the compiler supports coroutines.
+    This file requires <cstddef> and <iostream>.
+-------------------------------------------------- */
+
+#ifndef BATCH_PIPELINE_H
+#define BATCH_PIPELINE_H
+
+#include <cstddef>
+#include <iostream>
+
+class BatchPipeline {
+public:
+
+    // Lines each queue between two stages holds before the stage feeding it waits
+    static const size_t DEFAULT_CAPACITY = 64;
+
+    // Run operations from input, writing the results to output and the throughput to log
+    // exactly as ProgramManager::runBatch() does; returns the number of lines that failed
+    static size_t run(std::istream& input, std::ostream& output, std::ostream& log,
+        size_t capacity = DEFAULT_CAPACITY);
+
+private:
+    BatchPipeline() = delete;
+};
+
+#endif // BATCH_PIPELINE_H
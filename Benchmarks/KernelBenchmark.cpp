@@ -0,0 +1,127 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file benchmarks the LimbKernels add and subtract
+    kernels. For each operand size it times every kernel set
+    the processor supports, first on raw limb arrays and then
+    through LargeNumber's + and - operators, and prints the
+    time per limb next to the speedup over the scalar loop.
+    Build it with the KernelBenchmark CMake target.
+    It requires LargeNumber.h, LimbKernels.h, <chrono>, <iomanip>,
+    <iostream>, <random>, <string>, and <vector> to run.
+-------------------------------------------------- */
+
+#include "../LargeNumber.h"
+#include "../LimbKernels.h"
+#include <chrono> // For timing (steady_clock)
+#include <iomanip> // For formatting (setw() and setprecision())
+#include <iostream>
+#include <random> // For operands (mt19937_64)
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+    const uint64_t LIMB_BASE = 1000000000000000000ULL;
+    const LimbKernelSet KERNEL_SETS[] = { LimbKernelSet::Scalar, LimbKernelSet::SSE42, LimbKernelSet::AVX2 };
+
+    // Repeat an operation until enough time has passed, returning nanoseconds per call
+    template <typename Operation>
+    double timePerCall(Operation operation) {
+        using Clock = chrono::steady_clock;
+
+        // Warm caches and clocks before measuring
+        Clock::time_point warmUp = Clock::now();
+        while (Clock::now() - warmUp < chrono::milliseconds(50)) {
+            operation();
+        }
+
+        long long calls = 0;
+        Clock::time_point start = Clock::now();
+        Clock::duration elapsed{};
+        do {
+            for (int i = 0; i < 8; i++) {
+                operation();
+            }
+            calls += 8;
+            elapsed = Clock::now() - start;
+        } while (elapsed < chrono::milliseconds(200));
+        return chrono::duration<double, nano>(elapsed).count() / static_cast<double>(calls);
+    }
+
+    vector<uint64_t> randomLimbs(size_t count, mt19937_64& generator) {
+        vector<uint64_t> limbs(count);
+        for (uint64_t& limb : limbs) {
+            limb = generator() % LIMB_BASE;
+        }
+        return limbs;
+    }
+
+    string randomDigits(size_t count, mt19937_64& generator) {
+        string digits(count, '0');
+        for (char& digit : digits) {
+            digit = static_cast<char>('0' + generator() % 10);
+        }
+        digits[0] = '9';
+        return digits;
+    }
+
+    // Print one row: ns per limb for each kernel set and the speedup over scalar
+    template <typename Operation>
+    void printRow(const string& label, size_t limbs, Operation operation) {
+        cout << left << setw(12) << label << right << setw(10) << limbs;
+        double scalar = 0;
+        for (LimbKernelSet kernelSet : KERNEL_SETS) {
+            if (!LimbKernels::setKernelSet(kernelSet)) {
+                cout << setw(20) << "n/a";
+                continue;
+            }
+            double perLimb = timePerCall(operation) / static_cast<double>(limbs);
+            if (kernelSet == LimbKernelSet::Scalar) {
+                scalar = perLimb;
+            }
+            cout << fixed << setprecision(3) << setw(11) << perLimb << " (" << setprecision(2) << setw(5)
+                << scalar / perLimb << "x)";
+        }
+        cout << endl;
+    }
+}
+
+int main() {
+    LimbKernelSet detected = LimbKernels::detectKernelSet();
+    mt19937_64 generator(2024);
+
+    cout << "Detected kernel set: " << LimbKernels::getKernelSetName(detected) << endl;
+    cout << "Times are ns per limb (speedup over scalar)" << endl;
+    cout << left << setw(12) << "operation" << right << setw(10) << "limbs";
+    for (LimbKernelSet kernelSet : KERNEL_SETS) {
+        cout << setw(20) << LimbKernels::getKernelSetName(kernelSet);
+    }
+    cout << endl;
+
+    // Raw kernels on contiguous arrays
+    for (size_t limbs : { 8, 32, 128, 1024, 16384, 262144 }) {
+        vector<uint64_t> a = randomLimbs(limbs, generator);
+        vector<uint64_t> b = randomLimbs(limbs, generator);
+        vector<uint64_t> out(limbs);
+        int count = static_cast<int>(limbs);
+        printRow("add", limbs, [&]() { LimbKernels::add(out.data(), a.data(), b.data(), count, 0); });
+        printRow("subtract", limbs, [&]() { LimbKernels::subtract(out.data(), a.data(), b.data(), count, 0); });
+    }
+
+    // Whole LargeNumber operations, including block walking and result allocation
+    for (size_t digits : { 1000, 100000, 10000000 }) {
+        LargeNumber a(randomDigits(digits, generator));
+        LargeNumber b(randomDigits(digits, generator));
+        size_t limbs = (digits + 17) / 18;
+        printRow("operator+", limbs, [&]() { LargeNumber sum = a + b; });
+        printRow("operator-", limbs, [&]() { LargeNumber difference = a - b; });
+        printRow("operator+=", limbs, [&]() { a += b; a -= b; });
+    }
+
+    LimbKernels::setKernelSet(detected);
+    return 0;
+}
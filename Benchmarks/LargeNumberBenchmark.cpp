@@ -0,0 +1,445 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file benchmarks the everyday LargeNumber operations at
+    every power of ten from 10 to 10^8 digits: construction
+    from a string, +, -, magnitude comparison, printing through
+    operator<<, copying (alone and followed by the node edit
+    that makes the copy take its own blocks), encoding and
+    decoding a binary record, hashing, + answered by a
+    ResultCache (a hit takes no nodes, though it takes longer
+    than the sum), * directly and answered by a ResultCache
+    (up to 10^6 digits), a four-operand chain of + and -
+    both with operators and through an ExpressionGraph, totals of
+    1000 operands with +=, a LargeNumberAccumulator, and its
+    threaded sum() (up to 10^5 digits), and
+    inserting, deleting, and modifying a node at the front,
+    middle, and back. At 10, 100,
+    and 1000 digits it also times FixedLargeNumber parsing, +, -,
+    and magnitude comparison for the same operands, and at 1000
+    digits modular exponentiation with Montgomery and Barrett
+    reduction. Each row reports the time per operation and per
+    limb, heap allocations and NodePool nodes per operation, and
+    the process memory high-water mark. Rows are printed as a
+    table, as CSV, or as JSON so results can be stored and
+    compared between builds.
+    Usage: LargeNumberBenchmark [--format table|csv|json]
+        [--max-digits N] [--min-time-ms N]
+    Build it with the LargeNumberBenchmark CMake target.
+    It requires ExpressionGraph.h, FixedLargeNumber.h, LargeNumber.h,
+    LargeNumberAccumulator.h, LimbKernels.h, ModularContext.h, NodePool.h, ResultCache.h, ThreadPool.h,
+    <atomic>, <chrono>, <cstdlib>, <cstring>, <iomanip>,
+    <iostream>, <new>, <random>, <streambuf>, <string>, <vector>, and <sys/resource.h> where available to run.
+-------------------------------------------------- */
+
+#include "../ExpressionGraph.h"
+#include "../FixedLargeNumber.h"
+#include "../LargeNumber.h"
+#include "../LargeNumberAccumulator.h"
+#include "../LimbKernels.h"
+#include "../ModularContext.h"
+#include "../NodePool.h"
+#include "../ResultCache.h"
+#include "../ThreadPool.h"
+#include <atomic> // For the allocation counter (atomic)
+#include <chrono> // For timing (steady_clock)
+#include <cstdlib> // For raw allocation (malloc() and free())
+#include <cstring> // For argument comparison (strcmp())
+#include <iomanip> // For formatting (setw() and setprecision())
+#include <iostream>
+#include <new> // For replacing global allocation (bad_alloc and nothrow_t)
+#include <random> // For operands (mt19937_64)
+#include <streambuf> // For discarded output (streambuf)
+#include <string>
+#include <vector>
+
+#ifdef __unix__
+#include <sys/resource.h> // For the memory high-water mark (getrusage())
+#endif
+
+using namespace std;
+
+// Count every heap allocation made by the process; every replaceable form of the global
+// operator new and operator delete is replaced, so each allocation is counted once and
+// released by the function matching the one that made it
+static atomic<size_t> heapAllocations{ 0 };
+
+static void* countedAllocate(size_t size) noexcept {
+    heapAllocations.fetch_add(1, memory_order_relaxed);
+    return malloc(size ? size : 1);
+}
+
+// Kept out of line: GCC otherwise inlines the free() into callers whose pointer came from
+// operator new and reports the pair as mismatched (-Wmismatched-new-delete)
+#ifdef __GNUC__
+__attribute__((noinline))
+#endif
+static void countedRelease(void* memory) noexcept {
+    free(memory);
+}
+
+void* operator new(size_t size) {
+    void* memory = countedAllocate(size);
+    if (!memory) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](size_t size) {
+    void* memory = countedAllocate(size);
+    if (!memory) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept {
+    countedRelease(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    countedRelease(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    countedRelease(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+    countedRelease(memory);
+}
+
+void operator delete(void* memory, const nothrow_t&) noexcept {
+    countedRelease(memory);
+}
+
+void operator delete[](void* memory, const nothrow_t&) noexcept {
+    countedRelease(memory);
+}
+
+namespace {
+
+    // One measured operation
+    struct Result {
+        string operation;
+        string position;
+        size_t digits;
+        size_t limbs;
+        double nanosecondsPerOperation;
+        double heapAllocationsPerOperation;
+        double nodesPerOperation;
+        long peakMemoryKilobytes;
+        long long calls;
+    };
+
+    enum class Format {
+        Table,
+        Csv,
+        Json
+    };
+
+    // Options from the command line
+    Format format = Format::Table;
+    size_t maxDigits = 100000000;
+    chrono::milliseconds minTime(200);
+
+    // Operands per sum row, and the longest operands they are built at
+    const size_t SUM_OPERANDS = 1000;
+    const size_t SUM_MAX_DIGITS = 100000;
+
+    // Longest operands the multiply rows are built at
+    const size_t MULTIPLY_MAX_DIGITS = 1000000;
+
+    // Process memory high-water mark in kilobytes (0 where unsupported)
+    long peakMemoryKilobytes() {
+#ifdef __unix__
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+#else
+        return 0;
+#endif
+    }
+
+    // Stream buffer that accepts and drops everything, so printing is timed without storage costs
+    class DiscardBuffer : public streambuf {
+    protected:
+        streamsize xsputn(const char*, streamsize count) override { return count; }
+        int_type overflow(int_type character) override { return traits_type::not_eof(character); }
+    };
+
+    string randomDigits(size_t count, mt19937_64& generator) {
+        string digits(count, '0');
+        for (char& digit : digits) {
+            digit = static_cast<char>('0' + generator() % 10);
+        }
+        digits[0] = '9';
+        return digits;
+    }
+
+    // Time calls of an operation, running it at least three times and for at least minTime,
+    // or exactly exactCalls times without a warm-up call when that is given
+    template <typename Operation>
+    Result measure(const string& operation, const string& position, size_t digits, Operation run,
+        long long exactCalls = 0) {
+        using Clock = chrono::steady_clock;
+
+        // Warm caches and the node pool once before counting
+        if (exactCalls == 0) {
+            run();
+        }
+
+        size_t heapBefore = heapAllocations.load(memory_order_relaxed);
+        size_t nodesBefore = NodePool::getStats().nodesAllocated;
+        long long calls = 0;
+        Clock::time_point start = Clock::now();
+        Clock::duration elapsed{};
+        do {
+            run();
+            calls++;
+            elapsed = Clock::now() - start;
+        } while (exactCalls > 0 ? calls < exactCalls : (calls < 3 || elapsed < minTime));
+
+        double perCall = static_cast<double>(calls);
+        Result result;
+        result.operation = operation;
+        result.position = position;
+        result.digits = digits;
+        result.limbs = (digits + 17) / 18;
+        result.nanosecondsPerOperation = chrono::duration<double, nano>(elapsed).count() / perCall;
+        result.heapAllocationsPerOperation = (heapAllocations.load(memory_order_relaxed) - heapBefore) / perCall;
+        result.nodesPerOperation = (NodePool::getStats().nodesAllocated - nodesBefore) / perCall;
+        result.peakMemoryKilobytes = peakMemoryKilobytes();
+        result.calls = calls;
+        return result;
+    }
+
+    // Time FixedLargeNumber on the same operands; one spare digit holds any carry, and the
+    // operands are reached through volatile pointers so no call can be folded away
+    template <size_t Digits>
+    void measureFixed(const string& textA, const string& textB, vector<Result>& results) {
+        typedef FixedLargeNumber<Digits + 1> Fixed;
+        Fixed a(textA), b(textB), out;
+        Fixed* volatile left = &a;
+        Fixed* volatile right = &b;
+        Fixed* volatile result = &out;
+        results.push_back(measure("fixed-parse", "-", Digits, [&]() { *result = Fixed(textA); }));
+        results.push_back(measure("fixed-add", "-", Digits, [&]() { *result = *left + *right; }));
+        results.push_back(measure("fixed-sub", "-", Digits, [&]() { *result = *left - *right; }));
+        results.push_back(measure("fixed-cmp", "-", Digits, [&]() {
+            volatile int order = left->compareMagnitude(*right);
+            (void)order;
+        }));
+    }
+
+    void printHeader() {
+        if (format == Format::Csv) {
+            cout << "operation,position,digits,limbs,ns_per_op,ns_per_limb,heap_allocs_per_op,nodes_per_op,peak_rss_kb\n";
+        }
+        else if (format == Format::Json) {
+            cout << "{\n  \"kernel_set\": \"" << LimbKernels::getKernelSetName(LimbKernels::getKernelSet())
+                << "\",\n  \"threads\": " << ThreadPool::getDefaultThreadCount() << ",\n  \"results\": [";
+        }
+        else {
+            cout << "Kernel set: " << LimbKernels::getKernelSetName(LimbKernels::getKernelSet()) << endl;
+            cout << left << setw(12) << "operation" << setw(8) << "position" << right << setw(11) << "digits"
+                << setw(16) << "ns/op" << setw(12) << "ns/limb" << setw(12) << "allocs/op" << setw(12) << "nodes/op"
+                << setw(14) << "peak RSS KB" << endl;
+        }
+    }
+
+    void printResult(const Result& result, bool first) {
+        double perLimb = result.nanosecondsPerOperation / static_cast<double>(result.limbs);
+        if (format == Format::Csv) {
+            cout << result.operation << ',' << result.position << ',' << result.digits << ',' << result.limbs << ','
+                << fixed << setprecision(1) << result.nanosecondsPerOperation << ',' << setprecision(4) << perLimb << ','
+                << setprecision(2) << result.heapAllocationsPerOperation << ',' << result.nodesPerOperation << ','
+                << result.peakMemoryKilobytes << '\n';
+        }
+        else if (format == Format::Json) {
+            cout << (first ? "\n" : ",\n") << "    {\"operation\": \"" << result.operation << "\", \"position\": \""
+                << result.position << "\", \"digits\": " << result.digits << ", \"limbs\": " << result.limbs
+                << ", \"ns_per_op\": " << fixed << setprecision(1) << result.nanosecondsPerOperation
+                << ", \"ns_per_limb\": " << setprecision(4) << perLimb
+                << ", \"heap_allocs_per_op\": " << setprecision(2) << result.heapAllocationsPerOperation
+                << ", \"nodes_per_op\": " << result.nodesPerOperation
+                << ", \"peak_rss_kb\": " << result.peakMemoryKilobytes << "}";
+        }
+        else {
+            cout << left << setw(12) << result.operation << setw(8) << result.position << right << setw(11)
+                << result.digits << fixed << setprecision(1) << setw(16) << result.nanosecondsPerOperation
+                << setprecision(4) << setw(12) << perLimb << setprecision(2) << setw(12)
+                << result.heapAllocationsPerOperation << setw(12) << result.nodesPerOperation << setw(14)
+                << result.peakMemoryKilobytes << endl;
+        }
+        cout.flush();
+    }
+
+    void printFooter() {
+        if (format == Format::Json) {
+            cout << "\n  ]\n}" << endl;
+        }
+    }
+
+    bool parseArguments(int argc, char* argv[]) {
+        for (int i = 1; i < argc; i++) {
+            bool hasValue = i + 1 < argc;
+            if (strcmp(argv[i], "--format") == 0 && hasValue) {
+                string name = argv[++i];
+                if (name == "table") {
+                    format = Format::Table;
+                }
+                else if (name == "csv") {
+                    format = Format::Csv;
+                }
+                else if (name == "json") {
+                    format = Format::Json;
+                }
+                else {
+                    return false;
+                }
+            }
+            else if (strcmp(argv[i], "--max-digits") == 0 && hasValue) {
+                maxDigits = strtoull(argv[++i], nullptr, 10);
+            }
+            else if (strcmp(argv[i], "--min-time-ms") == 0 && hasValue) {
+                minTime = chrono::milliseconds(strtoll(argv[++i], nullptr, 10));
+            }
+            else {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (!parseArguments(argc, argv)) {
+        cerr << "Usage: " << argv[0] << " [--format table|csv|json] [--max-digits N] [--min-time-ms N]" << endl;
+        return 1;
+    }
+
+    mt19937_64 generator(2024);
+    bool first = true;
+    printHeader();
+    for (size_t digits = 10; digits <= maxDigits; digits *= 10) {
+        string textA = randomDigits(digits, generator);
+        string textB = randomDigits(digits, generator);
+        LargeNumber a(textA);
+        LargeNumber b(textB);
+        vector<Result> results;
+
+        results.push_back(measure("construct", "-", digits, [&]() { LargeNumber parsed(textA); }));
+        results.push_back(measure("add", "-", digits, [&]() { LargeNumber sum = a + b; }));
+        results.push_back(measure("subtract", "-", digits, [&]() { LargeNumber difference = a - b; }));
+        results.push_back(measure("compare", "-", digits, [&]() { volatile int order = a.compareMagnitude(b); (void)order; }));
+        results.push_back(measure("hash", "-", digits, [&]() { volatile size_t hash = a.getHash(); (void)hash; }));
+
+        // The same sum again and again, answered by a ResultCache after the first time
+        ResultCache cache;
+        results.push_back(measure("add", "cached", digits, [&]() { LargeNumber sum = cache.add(a, b); }));
+
+        // The same product, where a hit replaces the multiplication with two linear hashes
+        if (digits <= MULTIPLY_MAX_DIGITS) {
+            results.push_back(measure("multiply", "-", digits, [&]() { LargeNumber product = a * b; }));
+            results.push_back(measure("multiply", "cached", digits, [&]() { LargeNumber product = cache.multiply(a, b); }));
+        }
+        DiscardBuffer discard;
+        ostream sink(&discard);
+        results.push_back(measure("print", "-", digits, [&]() { sink << a; }));
+        results.push_back(measure("copy", "-", digits, [&]() { LargeNumber copy(a); }));
+        results.push_back(measure("copy-edit", "-", digits, [&]() {
+            LargeNumber copy(a);
+            copy.modifyNode(0, 1);
+        }));
+        string record = a.toBinary();
+        results.push_back(measure("to-binary", "-", digits, [&]() { string encoded = a.toBinary(); }));
+        results.push_back(measure("from-binary", "-", digits, [&]() {
+            size_t used;
+            LargeNumber decoded = LargeNumber::fromBinary(record.data(), record.size(), used);
+        }));
+
+        // a + b - c + d one operator at a time, then as one graph evaluation with the cache cleared
+        LargeNumber c(b);
+        LargeNumber d(a);
+        results.push_back(measure("chain4", "-", digits, [&]() { LargeNumber total = a + b - c + d; }));
+        ExpressionGraph graph;
+        Expression chain = graph.variable(a) + graph.variable(b) - graph.variable(c) + graph.variable(d);
+        results.push_back(measure("chain4", "graph", digits, [&]() {
+            graph.invalidate();
+            LargeNumber total = chain.evaluate();
+        }));
+
+        // Totals of 1000 operands: one += at a time, through an accumulator, and the threaded sum()
+        if (digits <= SUM_MAX_DIGITS) {
+            vector<LargeNumber> operands;
+            for (size_t i = 0; i < SUM_OPERANDS; i++) {
+                operands.push_back(i % 2 == 0 ? a : b);
+            }
+            results.push_back(measure("sum1000", "operator", digits, [&]() {
+                LargeNumber total;
+                for (const LargeNumber& operand : operands) {
+                    total += operand;
+                }
+            }));
+            results.push_back(measure("sum1000", "accumulator", digits, [&]() {
+                LargeNumberAccumulator total;
+                for (const LargeNumber& operand : operands) {
+                    total += operand;
+                }
+                LargeNumber value = total.getValue();
+            }));
+            results.push_back(measure("sum1000", "parallel", digits, [&]() {
+                LargeNumber total = LargeNumberAccumulator::sum(operands);
+            }));
+        }
+        if (digits == 10) {
+            measureFixed<10>(textA, textB, results);
+        }
+        else if (digits == 100) {
+            measureFixed<100>(textA, textB, results);
+        }
+        else if (digits == 1000) {
+            measureFixed<1000>(textA, textB, results);
+
+            // A 1000-digit (about 3300-bit) odd modulus is in range for both reductions
+            LargeNumber modulus(textA.substr(0, digits - 1) + "7");
+            ModularContext montgomery(modulus, ModularReduction::Montgomery);
+            ModularContext barrett(modulus, ModularReduction::Barrett);
+            results.push_back(measure("powmod", "montgomery", digits, [&]() { LargeNumber power = montgomery.pow(b, a); }));
+            results.push_back(measure("powmod", "barrett", digits, [&]() { LargeNumber power = barrett.pow(b, a); }));
+        }
+
+        // Node edits at both ends and in the middle; the deletes undo every insert, warm-up included
+        struct Place {
+            const char* name;
+            int index;
+        };
+        int groups = b.getSize();
+        Place places[] = { { "front", 0 }, { "middle", groups / 2 }, { "back", groups - 1 } };
+        for (const Place& place : places) {
+            int index = place.index;
+            results.push_back(measure("insert", place.name, digits, [&]() { b.insertNode(index + 1, 123); }));
+            results.push_back(measure("delete", place.name, digits, [&]() { b.deleteNode(index + 1); },
+                results.back().calls + 1));
+            results.push_back(measure("modify", place.name, digits, [&]() { b.modifyNode(index, 456); }));
+        }
+
+        for (const Result& result : results) {
+            printResult(result, first);
+            first = false;
+        }
+    }
+    printFooter();
+    return 0;
+}
@@ -0,0 +1,222 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file drives a CalculatorService with many concurrent
+    clients and reports its throughput and latency. Each client
+    thread opens its own connection and keeps up to --pipeline
+    requests in flight, cycling through add, mul, mod, and sub
+    with operands of --digits digits, so its number stays about
+    twice that long. The latency of a request runs from the
+    moment it is sent to the moment its reply arrives. Without
+    --socket, the generator starts a service of its own on a
+    temporary socket path, so it runs entirely on one machine
+    with no setup.
+    Usage: ServiceLoadGenerator [--socket PATH] [--workers N]
+        [--clients N] [--requests N] [--pipeline N] [--digits N]
+    Build it with the ServiceLoadGenerator CMake target (Unix-like
+    systems only).
+    It requires CalculatorService.h, <algorithm>, <atomic>,
+    <chrono>, <cstdint>, <cstdlib>, <cstring>, <deque>,
+    <exception>, <iomanip>, <iostream>, <memory>, <random>,
+    <stdexcept>, <string>, <thread>, <vector>, <sys/socket.h>, and <unistd.h>
+    to run.
+-------------------------------------------------- */
+
+#include "../CalculatorService.h"
+#include <algorithm> // For percentiles (sort())
+#include <atomic> // For the error count (atomic)
+#include <chrono> // For timing (steady_clock)
+#include <cstdint>
+#include <cstdlib> // For argument conversion (strtoull())
+#include <cstring> // For argument comparison (strcmp())
+#include <deque>
+#include <exception>
+#include <iomanip> // For formatting (setprecision())
+#include <iostream>
+#include <memory> // For the optional local service (unique_ptr)
+#include <random> // For operands (mt19937_64)
+#include <stdexcept> // For exceptions (runtime_error)
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h> // For replies (recv())
+#include <unistd.h> // For closing sockets and the process id (close() and getpid())
+
+using namespace std;
+
+namespace {
+
+    using Clock = chrono::steady_clock;
+
+    // Options from the command line
+    string socketPath;
+    size_t workers = thread::hardware_concurrency() > 0 ? thread::hardware_concurrency() : 1;
+    size_t clients = 8;
+    size_t requestsPerClient = 10000;
+    size_t pipeline = 8;
+    size_t digits = 100;
+
+    atomic<size_t> failures{ 0 };
+
+    // Random digits without a leading zero
+    string randomDigits(size_t count, mt19937_64& generator) {
+        string text(count, '0');
+        for (size_t i = 0; i < count; i++) {
+            text[i] = static_cast<char>('0' + generator() % 10);
+        }
+        text[0] = static_cast<char>('1' + generator() % 9);
+        return text;
+    }
+
+    // Run one client's requests, recording the latency of each in nanoseconds
+    void runClient(size_t index, vector<uint64_t>& latencies) {
+        mt19937_64 generator(2024 + index);
+        string a = randomDigits(digits, generator);
+        string b = randomDigits(digits, generator);
+        const string operations[] = { "add " + a, "mul " + b, "mod " + a, "sub " + b };
+
+        int socket = CalculatorService::connectTo(socketPath);
+        deque<Clock::time_point> inFlight;
+        string outgoing;
+        string incoming;
+        string reply;
+        vector<char> chunk(1 << 16);
+        size_t sent = 0;
+        size_t received = 0;
+        latencies.reserve(requestsPerClient);
+        while (received < requestsPerClient) {
+
+            // Top up the pipeline, sending the new requests in one write
+            outgoing.clear();
+            while (sent < requestsPerClient && sent - received < pipeline) {
+                const string& request = operations[sent % 4];
+                CalculatorService::appendFrame(outgoing, request.data(), request.size());
+                inFlight.push_back(Clock::now());
+                sent++;
+            }
+            if (!outgoing.empty()) {
+                CalculatorService::sendAll(socket, outgoing.data(), outgoing.size());
+            }
+
+            // Replies arrive in request order, so each one answers the oldest request in flight
+            ssize_t count = recv(socket, chunk.data(), chunk.size(), 0);
+            if (count <= 0) {
+                close(socket);
+                throw runtime_error("Connection closed by the service");
+            }
+            incoming.append(chunk.data(), static_cast<size_t>(count));
+            size_t offset = 0;
+            while (CalculatorService::takeFrame(incoming, offset, reply)) {
+                latencies.push_back(static_cast<uint64_t>(
+                    chrono::duration_cast<chrono::nanoseconds>(Clock::now() - inFlight.front()).count()));
+                inFlight.pop_front();
+                received++;
+                if (reply.empty() || reply[0] != CalculatorService::REPLY_OK) {
+                    failures++;
+                }
+            }
+            incoming.erase(0, offset);
+        }
+        close(socket);
+    }
+
+    // Latency at a fraction of the sorted samples, in microseconds
+    double percentileMicroseconds(const vector<uint64_t>& sorted, double fraction) {
+        if (sorted.empty()) {
+            return 0;
+        }
+        size_t rank = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[rank] / 1000.0;
+    }
+
+    // Read the options, returning false if any is unknown or out of range
+    bool parseArguments(int argc, char* argv[]) {
+        for (int i = 1; i < argc; i++) {
+            bool hasValue = i + 1 < argc;
+            if (strcmp(argv[i], "--socket") == 0 && hasValue) {
+                socketPath = argv[++i];
+            }
+            else if (strcmp(argv[i], "--workers") == 0 && hasValue) {
+                workers = strtoull(argv[++i], nullptr, 10);
+            }
+            else if (strcmp(argv[i], "--clients") == 0 && hasValue) {
+                clients = strtoull(argv[++i], nullptr, 10);
+            }
+            else if (strcmp(argv[i], "--requests") == 0 && hasValue) {
+                requestsPerClient = strtoull(argv[++i], nullptr, 10);
+            }
+            else if (strcmp(argv[i], "--pipeline") == 0 && hasValue) {
+                pipeline = strtoull(argv[++i], nullptr, 10);
+            }
+            else if (strcmp(argv[i], "--digits") == 0 && hasValue) {
+                digits = strtoull(argv[++i], nullptr, 10);
+            }
+            else {
+                return false;
+            }
+        }
+        return workers > 0 && clients > 0 && pipeline > 0 && digits > 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (!parseArguments(argc, argv)) {
+        cerr << "Usage: " << argv[0] << " [--socket PATH] [--workers N] [--clients N] [--requests N]"
+            << " [--pipeline N] [--digits N]" << endl;
+        return 1;
+    }
+
+    // Without a socket to connect to, serve locally for the length of the run
+    unique_ptr<CalculatorService> localService;
+    if (socketPath.empty()) {
+        socketPath = "/tmp/large-number-service-" + to_string(getpid()) + ".sock";
+        localService.reset(new CalculatorService(socketPath, workers));
+        try {
+            localService->start();
+        }
+        catch (const exception& e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+    }
+
+    vector<vector<uint64_t>> latencies(clients);
+    vector<thread> threads;
+    atomic<size_t> brokenClients{ 0 };
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < clients; i++) {
+        threads.emplace_back([i, &latencies, &brokenClients]() {
+            try {
+                runClient(i, latencies[i]);
+            }
+            catch (const exception& e) {
+                brokenClients++;
+                cerr << "Client " << i << ": " << e.what() << endl;
+            }
+        });
+    }
+    for (thread& client : threads) {
+        client.join();
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+
+    vector<uint64_t> all;
+    for (const vector<uint64_t>& samples : latencies) {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    sort(all.begin(), all.end());
+    cout << "Clients: " << clients << ", pipeline: " << pipeline << ", digits: " << digits;
+    if (localService) {
+        cout << ", local workers: " << workers;
+    }
+    cout << "\n" << fixed << setprecision(3)
+        << "Requests: " << all.size() << " (" << failures.load() << " failed) in " << seconds << " s, "
+        << setprecision(0) << (seconds > 0 ? all.size() / seconds : 0) << " ops/s\n"
+        << setprecision(1) << "Latency: p50 " << percentileMicroseconds(all, 0.5) << " us, p99 "
+        << percentileMicroseconds(all, 0.99) << " us, max " << (all.empty() ? 0.0 : all.back() / 1000.0) << " us" << endl;
+    if (localService) {
+        localService->stop();
+    }
+    return brokenClients.load() == 0 && failures.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the BlockIndex class defined in
+    BlockIndex.h. The tree links live in the blocks themselves
+    next to the list links. Priorities come from a xorshift
+    generator, the initial tree is built as a Cartesian tree
+    in one left-to-right pass, and later changes keep the heap
+    order with single rotations.
+    It requires BlockIndex.h, LargeNumber.h, and LargeNumberStats.h
+    to run.
+-------------------------------------------------- */
+
+#include "BlockIndex.h"
+#include "LargeNumber.h"
+#include "LargeNumberStats.h"
+
+using namespace std;
+
+void BlockIndex::build(Node* head) {
+    spine.clear();
+    for (Node* node = head; node; node = node->next) {
+        node->priority = nextPriority();
+        node->right = nullptr;
+
+        // Blocks with lower priority than the new one become its left subtree
+        Node* last = nullptr;
+        while (!spine.empty() && spine.back()->priority < node->priority) {
+            last = spine.back();
+            spine.pop_back();
+        }
+        node->left = last;
+        if (last) {
+            last->parent = node;
+        }
+        node->parent = spine.empty() ? nullptr : spine.back();
+        if (node->parent) {
+            node->parent->right = node;
+        }
+        spine.push_back(node);
+    }
+    root = spine.empty() ? nullptr : spine.front();
+    refreshSubtree(root);
+    valid = true;
+}
+
+Node* BlockIndex::locate(size_t position, int& offset) const {
+    Node* node = root;
+    while (node) {
+        LARGE_NUMBER_STATS_ADD(LargeNumberCounter::LookupHops, 1);
+        size_t leftGroups = totalOf(node->left);
+        if (position < leftGroups) {
+            node = node->left;
+        }
+        else if (position < leftGroups + static_cast<size_t>(node->groups)) {
+            offset = static_cast<int>(position - leftGroups);
+            return node;
+        }
+        else {
+            position -= leftGroups + static_cast<size_t>(node->groups);
+            node = node->right;
+        }
+    }
+    offset = 0;
+    return nullptr;
+}
+
+void BlockIndex::update(Node* node) {
+    for (; node; node = node->parent) {
+        refresh(node);
+    }
+}
+
+void BlockIndex::insertBefore(Node* node, Node* block) {
+    block->priority = nextPriority();
+    block->left = block->right = nullptr;
+
+    // The new block goes right after the in-order predecessor of node
+    if (!node->left) {
+        node->left = block;
+        block->parent = node;
+    }
+    else {
+        Node* predecessor = node->left;
+        while (predecessor->right) {
+            predecessor = predecessor->right;
+        }
+        predecessor->right = block;
+        block->parent = predecessor;
+    }
+    update(block);
+    while (block->parent && block->priority > block->parent->priority) {
+        rotateUp(block);
+    }
+}
+
+void BlockIndex::remove(Node* node) {
+
+    // Rotate the block down to a leaf, then cut it off
+    while (node->left || node->right) {
+        Node* child;
+        if (!node->left || (node->right && node->right->priority > node->left->priority)) {
+            child = node->right;
+        }
+        else {
+            child = node->left;
+        }
+        rotateUp(child);
+    }
+    Node* parent = node->parent;
+    if (!parent) {
+        root = nullptr;
+    }
+    else {
+        if (parent->left == node) {
+            parent->left = nullptr;
+        }
+        else {
+            parent->right = nullptr;
+        }
+        update(parent);
+    }
+    node->parent = nullptr;
+}
+
+uint32_t BlockIndex::nextPriority() {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return static_cast<uint32_t>(seed >> 32);
+}
+
+// Swap a block with its parent, keeping the in-order sequence
+void BlockIndex::rotateUp(Node* node) {
+    Node* parent = node->parent;
+    Node* grandparent = parent->parent;
+    if (parent->left == node) {
+        parent->left = node->right;
+        if (node->right) {
+            node->right->parent = parent;
+        }
+        node->right = parent;
+    }
+    else {
+        parent->right = node->left;
+        if (node->left) {
+            node->left->parent = parent;
+        }
+        node->left = parent;
+    }
+    parent->parent = node;
+    node->parent = grandparent;
+    if (!grandparent) {
+        root = node;
+    }
+    else if (grandparent->left == parent) {
+        grandparent->left = node;
+    }
+    else {
+        grandparent->right = node;
+    }
+    refresh(parent);
+    refresh(node);
+}
+
+size_t BlockIndex::totalOf(const Node* node) {
+    return node ? node->subtreeGroups : 0;
+}
+
+void BlockIndex::refresh(Node* node) {
+    node->subtreeGroups = totalOf(node->left) + static_cast<size_t>(node->groups) + totalOf(node->right);
+}
+
+// Recompute every total below node (the tree depth is logarithmic in expectation)
+void BlockIndex::refreshSubtree(Node* node) {
+    if (!node) {
+        return;
+    }
+    refreshSubtree(node->left);
+    refreshSubtree(node->right);
+    refresh(node);
+}
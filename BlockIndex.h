@@ -0,0 +1,62 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the BlockIndex class, an implicit
+    treap laid over the blocks of one LargeNumber list. Each
+    block is a tree node keyed by its place in the list, and
+    every subtree records how many 3-digit groups it holds, so
+    finding the block that holds a group position, splitting a
+    block, removing a block, or changing a block's group count
+    costs O(log n) expected time instead of a walk along the
+    list. The index is built in one O(n) pass the first time
+    it is needed after arithmetic has rebuilt the list.
+    This file requires <cstddef>, <cstdint>, and <vector>.
+-------------------------------------------------- */
+
+#ifndef BLOCK_INDEX_H
+#define BLOCK_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct Node;
+
+class BlockIndex {
+public:
+    BlockIndex() : root(nullptr), valid(false), seed(0x9E3779B97F4A7C15ULL) {}
+
+    // A stale index must be rebuilt before use; arithmetic marks it stale
+    bool isValid() const { return valid; }
+    void invalidate() { valid = false; root = nullptr; }
+
+    // Build the tree over the list starting at head
+    void build(Node* head);
+
+    // Block holding a group position (counted from the most significant group) and the offset inside it
+    Node* locate(size_t position, int& offset) const;
+
+    // Refresh the group totals above a block whose group count changed
+    void update(Node* node);
+
+    // Add a block that was just linked into the list in front of node
+    void insertBefore(Node* node, Node* block);
+
+    // Take a block out of the tree before it is unlinked from the list
+    void remove(Node* node);
+
+private:
+    Node* root;
+    bool valid;
+    uint64_t seed;
+    std::vector<Node*> spine; // Right spine used while building
+
+    uint32_t nextPriority();
+    void rotateUp(Node* node);
+    static size_t totalOf(const Node* node);
+    static void refresh(Node* node);
+    static void refreshSubtree(Node* node);
+};
+
+#endif // BLOCK_INDEX_H
@@ -0,0 +1,87 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file contains the main function of the calculator
+    service. It starts a CalculatorService on the given Unix
+    domain socket path and serves until it receives SIGINT or
+    SIGTERM, then stops the service, removes the socket file,
+    and reports the connections and requests it served on
+    standard error. With --cache, requests share a ResultCache
+    that answers repeated products, and its counters are
+    reported as well.
+    Usage: CalculatorServer <socket path> [--workers N] [--cache]
+    Build it with the CalculatorServer CMake target (Unix-like
+    systems only).
+    It requires CalculatorService.h, NumberInterner.h,
+    ResultCache.h, <csignal>, <cstdlib>, <cstring>, <exception>,
+    <iostream>, <thread>, and <pthread.h> to run.
+-------------------------------------------------- */
+
+#include "CalculatorService.h"
+#include "NumberInterner.h"
+#include "ResultCache.h"
+#include <csignal> // For shutdown signals (sigset_t, sigwait())
+#include <cstdlib> // For argument conversion (strtoull())
+#include <cstring> // For argument comparison (strcmp() and strncmp())
+#include <exception>
+#include <iostream>
+#include <thread> // For the default worker count (hardware_concurrency())
+#include <pthread.h> // For the signal mask (pthread_sigmask())
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    size_t workers = thread::hardware_concurrency();
+    bool cached = false;
+    bool valid = argc >= 2 && strncmp(argv[1], "--", 2) != 0;
+    for (int i = 2; valid && i < argc; i++) {
+        if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            workers = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--cache") == 0) {
+            cached = true;
+        }
+        else {
+            valid = false;
+        }
+    }
+    if (!valid || workers == 0) {
+        cerr << "Usage: " << argv[0] << " <socket path> [--workers N] [--cache]" << endl;
+        return 1;
+    }
+
+    // Block the shutdown signals before any thread starts, so only sigwait() receives them
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    NumberInterner interner;
+    ResultCache cache(ResultCache::DEFAULT_MAX_BYTES, &interner);
+    if (cached) {
+        ResultCache::install(&cache);
+    }
+    CalculatorService service(argv[1], workers);
+    try {
+        service.start();
+    }
+    catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    cerr << "Serving on " << argv[1] << " with " << workers << " worker(s)" << endl;
+
+    int received;
+    sigwait(&signals, &received);
+    service.stop();
+    cerr << "Served " << service.getRequestCount() << " requests (" << service.getErrorCount() << " failed) on "
+        << service.getConnectionCount() << " connection(s)" << endl;
+    if (cached) {
+        cerr << "Result cache: " << cache.getHitCount() << " hits, " << cache.getMissCount() << " misses, "
+            << cache.getEvictionCount() << " evictions" << endl;
+        ResultCache::install(nullptr);
+    }
+    return 0;
+}
@@ -0,0 +1,566 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the CalculatorService class defined in
+    CalculatorService.h. The I/O thread polls the listening
+    socket, a self-pipe used to wake it, and every session that
+    is not paused or has replies waiting. It appends whatever a
+    session sends to that session's inbox and moves each complete
+    frame onto the session's request queue; a session with
+    requests is put on the shared ready queue unless a worker
+    already has it. A worker takes a session, runs the requests
+    queued so far against the session's number through
+    ProgramManager::runOperation(), with file operations refused
+    so clients cannot read or write the service's files, and
+    queues the replies on the session, sending what the socket
+    takes without blocking. The I/O thread sends the rest when
+    the socket has room. If too many replies wait, the worker
+    leaves the session stalled until the I/O thread has sent
+    them; if more requests arrived meanwhile, the session goes to
+    the back of the ready queue. A session that hangs up stays
+    until the replies for requests already read are sent.
+    It requires CalculatorService.h, ProgramManager.h, <algorithm>,
+    <cerrno>, <cstring>, <stdexcept>, <fcntl.h>, <poll.h>,
+    <sys/socket.h>, <sys/stat.h>, <sys/un.h>, and <unistd.h> to run.
+-------------------------------------------------- */
+
+#include "CalculatorService.h"
+#include "ProgramManager.h"
+#include <algorithm> // For the worker count (max())
+#include <cerrno> // For error codes (errno)
+#include <cstring> // For socket addresses and errors (memcpy(), memset(), and strerror())
+#include <stdexcept> // For exceptions (runtime_error, invalid_argument, and length_error)
+#include <fcntl.h> // For descriptor flags (fcntl())
+#include <poll.h> // For waiting on many sockets (poll())
+#include <sys/socket.h> // For sockets (socket(), accept(), recv(), and send())
+#include <sys/stat.h> // For the socket file's mode (umask() and chmod())
+#include <sys/un.h> // For Unix domain addresses (sockaddr_un)
+#include <unistd.h> // For descriptors (close(), pipe(), and unlink())
+
+// Writes to a closed connection report EPIPE instead of raising SIGPIPE where the flag exists
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+using namespace std;
+
+const size_t CalculatorService::FRAME_HEADER_BYTES;
+const size_t CalculatorService::MAX_FRAME_BYTES;
+const size_t CalculatorService::MAX_REQUEST_BYTES;
+const char CalculatorService::REPLY_OK;
+const char CalculatorService::REPLY_ERROR;
+const size_t CalculatorService::MAX_PENDING_REQUESTS;
+const size_t CalculatorService::MAX_PENDING_REQUEST_BYTES;
+const size_t CalculatorService::MAX_PENDING_REPLY_BYTES;
+
+// Bytes read from a socket per call
+static const size_t READ_CHUNK_BYTES = 1 << 16;
+
+// Replies gathered before a worker queues and sends them
+static const size_t REPLY_FLUSH_BYTES = 1 << 16;
+
+// Build the address of a socket path; throws invalid_argument if it does not fit
+static sockaddr_un socketAddress(const string& path) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        throw invalid_argument("Socket path must have 1 to " + to_string(sizeof(address.sun_path) - 1) + " characters");
+    }
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return address;
+}
+
+// Set or clear O_NONBLOCK and set FD_CLOEXEC on a descriptor
+static void setFlags(int descriptor, bool nonBlocking) {
+    int flags = fcntl(descriptor, F_GETFL);
+    fcntl(descriptor, F_SETFL, nonBlocking ? flags | O_NONBLOCK : flags & ~O_NONBLOCK);
+    fcntl(descriptor, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+    int on = 1;
+    setsockopt(descriptor, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+}
+
+// A new session starts from 0, like a batch
+CalculatorService::Session::Session(int socket)
+    : socket(socket), number("0"), requestBytes(0), outboxSent(0), scheduled(false), paused(false), stalled(false),
+    closed(false), broken(false) {
+}
+
+CalculatorService::Session::~Session() {
+    close(socket);
+}
+
+// Service on a socket path; nothing is opened until start()
+CalculatorService::CalculatorService(const string& socketPath, size_t workerCount)
+    : socketPath(socketPath), workerCount(max<size_t>(workerCount, 1)), listener(-1), wakeRead(-1), wakeWrite(-1),
+    stopping(false), connections(0), requests(0), errors(0) {
+}
+
+CalculatorService::~CalculatorService() {
+    stop();
+}
+
+// Listen on the socket path and start the I/O thread and the workers
+void CalculatorService::start() {
+    if (listener >= 0) {
+        throw runtime_error("Service is already running");
+    }
+    sockaddr_un address = socketAddress(socketPath);
+    const sockaddr* socketName = reinterpret_cast<const sockaddr*>(&address);
+
+    // A path that still accepts connections belongs to a running service; a stale one is removed
+    int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe >= 0) {
+        bool live = connect(probe, socketName, sizeof(address)) == 0;
+        close(probe);
+        if (live) {
+            throw runtime_error("A service is already listening on " + socketPath);
+        }
+    }
+    unlink(socketPath.c_str());
+
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        throw runtime_error(string("Could not create a socket: ") + strerror(errno));
+    }
+
+    // Only the owner may connect: the socket file is created with mode 0600, and chmod()
+    // makes sure of it on systems that ignore the umask for sockets
+    mode_t mask = umask(0177);
+    bool bound = bind(listener, socketName, sizeof(address)) == 0;
+    umask(mask);
+    int pipeEnds[2];
+    if (!bound || chmod(socketPath.c_str(), 0600) != 0 || listen(listener, SOMAXCONN) != 0 || pipe(pipeEnds) != 0) {
+        string reason = strerror(errno);
+        close(listener);
+        listener = -1;
+        unlink(socketPath.c_str());
+        throw runtime_error("Could not listen on " + socketPath + ": " + reason);
+    }
+    setFlags(listener, true);
+    wakeRead = pipeEnds[0];
+    wakeWrite = pipeEnds[1];
+    setFlags(wakeRead, true);
+    setFlags(wakeWrite, true);
+
+    stopping = false;
+    connections = 0;
+    requests = 0;
+    errors = 0;
+    ioThread = thread(&CalculatorService::ioLoop, this);
+    for (size_t i = 0; i < workerCount; i++) {
+        workers.emplace_back(&CalculatorService::workerLoop, this);
+    }
+}
+
+// Stop the threads, dropping requests not yet run, and release the socket
+void CalculatorService::stop() {
+    if (listener < 0) {
+        return;
+    }
+    {
+        lock_guard<mutex> guard(queueLock);
+        stopping = true;
+    }
+    queueReady.notify_all();
+    wake();
+    ioThread.join();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    ready.clear();
+    close(listener);
+    close(wakeRead);
+    close(wakeWrite);
+    listener = wakeRead = wakeWrite = -1;
+    unlink(socketPath.c_str());
+}
+
+// Get the connections accepted
+size_t CalculatorService::getConnectionCount() const {
+    return connections.load();
+}
+
+// Get the requests run
+size_t CalculatorService::getRequestCount() const {
+    return requests.load();
+}
+
+// Get the requests answered with an error
+size_t CalculatorService::getErrorCount() const {
+    return errors.load();
+}
+
+// Append a length header and a payload
+void CalculatorService::appendFrame(string& out, const char* payload, size_t length) {
+    if (length > MAX_FRAME_BYTES) {
+        throw length_error("Frame of " + to_string(length) + " bytes is too long");
+    }
+    char header[FRAME_HEADER_BYTES];
+    for (size_t i = 0; i < FRAME_HEADER_BYTES; i++) {
+        header[i] = static_cast<char>((length >> (8 * i)) & 0xFF);
+    }
+    out.append(header, FRAME_HEADER_BYTES);
+    out.append(payload, length);
+}
+
+// Take the frame starting at offset if all of it has arrived
+bool CalculatorService::takeFrame(const string& buffer, size_t& offset, string& payload, size_t limit) {
+    if (buffer.size() - offset < FRAME_HEADER_BYTES) {
+        return false;
+    }
+    size_t length = 0;
+    for (size_t i = 0; i < FRAME_HEADER_BYTES; i++) {
+        length |= static_cast<size_t>(static_cast<unsigned char>(buffer[offset + i])) << (8 * i);
+    }
+    if (length > limit) {
+        throw runtime_error("Frame of " + to_string(length) + " bytes is too long");
+    }
+    if (buffer.size() - offset - FRAME_HEADER_BYTES < length) {
+        return false;
+    }
+    payload.assign(buffer, offset + FRAME_HEADER_BYTES, length);
+    offset += FRAME_HEADER_BYTES + length;
+    return true;
+}
+
+// Open a connection to a service
+int CalculatorService::connectTo(const string& socketPath) {
+    sockaddr_un address = socketAddress(socketPath);
+    int descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (descriptor < 0) {
+        throw runtime_error(string("Could not create a socket: ") + strerror(errno));
+    }
+    if (connect(descriptor, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        string reason = strerror(errno);
+        close(descriptor);
+        throw runtime_error("Could not connect to " + socketPath + ": " + reason);
+    }
+    setFlags(descriptor, false);
+    return descriptor;
+}
+
+// Write a whole buffer to a socket, retrying short and interrupted writes
+void CalculatorService::sendAll(int socket, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t sent = send(socket, data, length, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw runtime_error(string("Could not send: ") + strerror(errno));
+        }
+        data += sent;
+        length -= static_cast<size_t>(sent);
+    }
+}
+
+// Wait for connections, requests, and room to send replies until the service stops
+void CalculatorService::ioLoop() {
+    vector<shared_ptr<Session>> sessions;
+    vector<pollfd> polls;
+    while (!stopping) {
+
+        // A session that is neither read nor sent to gets a negative descriptor, which poll() skips
+        polls.clear();
+        polls.push_back(pollfd{ wakeRead, POLLIN, 0 });
+        polls.push_back(pollfd{ listener, POLLIN, 0 });
+        for (const shared_ptr<Session>& session : sessions) {
+            lock_guard<mutex> guard(session->lock);
+            short events = 0;
+            if (!session->closed && !session->paused) {
+                events |= POLLIN;
+            }
+            if (session->outboxSent < session->outbox.size()) {
+                events |= POLLOUT;
+            }
+            polls.push_back(pollfd{ events != 0 ? session->socket : -1, events, 0 });
+        }
+        if (poll(polls.data(), polls.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (polls[0].revents != 0) {
+            char drained[64];
+            while (read(wakeRead, drained, sizeof(drained)) > 0) {
+            }
+        }
+
+        // Read from and send to every session that is ready, keeping the ones not yet finished
+        size_t polled = sessions.size();
+        size_t kept = 0;
+        for (size_t i = 0; i < polled; i++) {
+            const pollfd& state = polls[i + 2];
+            if (state.revents != 0 && (state.events & POLLIN) != 0 && !readRequests(sessions[i])) {
+                lock_guard<mutex> guard(sessions[i]->lock);
+                sessions[i]->closed = true;
+            }
+            if (state.revents != 0 && (state.events & POLLOUT) != 0) {
+                sendReplies(sessions[i]);
+            }
+            bool finished;
+            {
+                lock_guard<mutex> guard(sessions[i]->lock);
+                finished = isFinished(*sessions[i]);
+            }
+            if (!finished) {
+                sessions[kept++].swap(sessions[i]);
+            }
+        }
+        sessions.resize(kept);
+        if (polls[1].revents != 0) {
+            acceptConnections(sessions);
+        }
+    }
+}
+
+// Take sessions off the ready queue until the service stops
+void CalculatorService::workerLoop() {
+    while (true) {
+        shared_ptr<Session> session;
+        {
+            unique_lock<mutex> guard(queueLock);
+            queueReady.wait(guard, [this]() { return stopping || !ready.empty(); });
+            if (stopping) {
+                return;
+            }
+            session = move(ready.front());
+            ready.pop_front();
+        }
+        serve(session);
+    }
+}
+
+// Accept every waiting connection
+void CalculatorService::acceptConnections(vector<shared_ptr<Session>>& sessions) {
+    while (true) {
+        int descriptor = accept(listener, nullptr, nullptr);
+        if (descriptor < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            return;
+        }
+
+        // Neither workers nor the I/O thread may block on a client
+        setFlags(descriptor, true);
+        sessions.push_back(make_shared<Session>(descriptor));
+        connections++;
+    }
+}
+
+// Read what a session sent and queue its complete requests; returns false once it is closed
+bool CalculatorService::readRequests(const shared_ptr<Session>& session) {
+    bool open = true;
+    bool paused = false;
+    bool wanted = false;
+    char chunk[READ_CHUNK_BYTES];
+    while (open && !paused) {
+        ssize_t received = recv(session->socket, chunk, sizeof(chunk), MSG_DONTWAIT);
+        if (received <= 0) {
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            open = received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+            break;
+        }
+        session->inbox.append(chunk, static_cast<size_t>(received));
+
+        // Frames are taken as each chunk arrives, so the inbox never holds more than one partial
+        // request; a request over the limit closes the session after the requests before it
+        {
+            lock_guard<mutex> guard(session->lock);
+            size_t offset = 0;
+            string payload;
+            try {
+                while (takeFrame(session->inbox, offset, payload, MAX_REQUEST_BYTES)) {
+                    session->requestBytes += payload.size();
+                    session->requests.push_back(move(payload));
+                }
+            }
+            catch (const runtime_error&) {
+                errors++;
+                open = false;
+            }
+            session->inbox.erase(0, offset);
+            paused = session->paused = hasRequestBacklog(*session);
+            if (!session->requests.empty() && !session->scheduled && !session->stalled && !session->broken) {
+                session->scheduled = true;
+                wanted = true;
+            }
+        }
+        if (static_cast<size_t>(received) < sizeof(chunk)) {
+            break;
+        }
+    }
+    if (wanted) {
+        schedule(session);
+    }
+    return open;
+}
+
+// Send what a session's socket takes of its waiting replies, and run it again once they drain
+void CalculatorService::sendReplies(const shared_ptr<Session>& session) {
+    bool wanted = false;
+    {
+        lock_guard<mutex> guard(session->lock);
+        writeReplies(*session);
+        if (session->stalled && session->outbox.size() - session->outboxSent < MAX_PENDING_REPLY_BYTES) {
+            session->stalled = false;
+            session->scheduled = true;
+            wanted = true;
+        }
+    }
+    if (wanted) {
+        schedule(session);
+    }
+}
+
+// Put a session at the back of the ready queue
+void CalculatorService::schedule(const shared_ptr<Session>& session) {
+    {
+        lock_guard<mutex> guard(queueLock);
+        ready.push_back(session);
+    }
+    queueReady.notify_one();
+}
+
+// Run the requests a session has queued so far and queue their replies
+void CalculatorService::serve(const shared_ptr<Session>& session) {
+    size_t batch;
+    {
+        lock_guard<mutex> guard(session->lock);
+        batch = session->requests.size();
+    }
+
+    // Each reply is built in place after its status byte, so long results are not copied again
+    string replies;
+    string request;
+    string reply;
+    for (size_t i = 0; i < batch; i++) {
+        bool resume = false;
+        {
+            lock_guard<mutex> guard(session->lock);
+
+            // Requests are dropped when the client goes away, and wait while too many replies do
+            if (session->requests.empty()) {
+                break;
+            }
+            if (session->outbox.size() - session->outboxSent >= MAX_PENDING_REPLY_BYTES) {
+                session->stalled = true;
+                break;
+            }
+            request = move(session->requests.front());
+            session->requests.pop_front();
+            session->requestBytes -= request.size();
+            if (session->paused && !hasRequestBacklog(*session)) {
+                session->paused = false;
+                resume = true;
+            }
+        }
+        if (resume) {
+            wake();
+        }
+
+        reply.assign(1, REPLY_OK);
+        try {
+            ProgramManager::runOperation(request, session->number, reply, false);
+            if (reply.back() == '\n') {
+                reply.pop_back();
+            }
+            appendFrame(replies, reply.data(), reply.size());
+        }
+        catch (const exception& e) {
+            errors++;
+            reply.assign(1, REPLY_ERROR);
+            reply += e.what();
+            appendFrame(replies, reply.data(), reply.size());
+        }
+        requests++;
+        if (replies.size() >= REPLY_FLUSH_BYTES) {
+            lock_guard<mutex> guard(session->lock);
+            session->outbox += replies;
+            writeReplies(*session);
+            replies.clear();
+        }
+    }
+
+    // Requests that came in meanwhile wait behind the other sessions; the I/O thread is woken
+    // to send the replies the socket did not take, or to drop a session that is finished
+    bool again;
+    bool waiting;
+    {
+        lock_guard<mutex> guard(session->lock);
+        if (!replies.empty()) {
+            session->outbox += replies;
+            writeReplies(*session);
+        }
+        again = !session->requests.empty() && !session->stalled;
+        session->scheduled = again;
+        waiting = session->outboxSent < session->outbox.size() || session->closed || session->broken;
+    }
+    if (again) {
+        schedule(session);
+    }
+    if (waiting) {
+        wake();
+    }
+}
+
+// Check whether a session has too many requests waiting to read any more
+bool CalculatorService::hasRequestBacklog(const Session& session) {
+    return session.requests.size() >= MAX_PENDING_REQUESTS || session.requestBytes >= MAX_PENDING_REQUEST_BYTES;
+}
+
+// Check whether a session has nothing left to read, run, or send
+bool CalculatorService::isFinished(const Session& session) {
+    if (session.scheduled || session.stalled) {
+        return false;
+    }
+    return session.broken || (session.closed && session.requests.empty() && session.outboxSent == session.outbox.size());
+}
+
+// Send as much of a session's waiting replies as its socket takes without blocking
+void CalculatorService::writeReplies(Session& session) {
+    while (session.outboxSent < session.outbox.size() && !session.broken) {
+        ssize_t sent = send(session.socket, session.outbox.data() + session.outboxSent,
+            session.outbox.size() - session.outboxSent, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent >= 0) {
+            session.outboxSent += static_cast<size_t>(sent);
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        else if (errno != EINTR) {
+
+            // A client that went away gets no more replies, and its waiting requests are dropped
+            session.broken = true;
+            session.requests.clear();
+            session.requestBytes = 0;
+            session.stalled = false;
+        }
+    }
+
+    // Sent bytes are dropped once they are half the buffer, so a long reply is not moved repeatedly
+    if (session.broken || session.outboxSent == session.outbox.size()) {
+        session.outbox.clear();
+        session.outboxSent = 0;
+    }
+    else if (session.outboxSent > session.outbox.size() / 2) {
+        session.outbox.erase(0, session.outboxSent);
+        session.outboxSent = 0;
+    }
+}
+
+// Interrupt the I/O thread's poll()
+void CalculatorService::wake() {
+    char signal = 0;
+    ssize_t written = write(wakeWrite, &signal, 1);
+    (void)written;
+}
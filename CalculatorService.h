@@ -0,0 +1,158 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the CalculatorService class, which
+    serves the batch operations of ProgramManager over a Unix
+    domain socket. Every connection is a session with its own
+    current LargeNumber, starting at 0, exactly like one batch
+    file. Messages in both directions are frames: a 4-byte
+    little-endian payload length followed by the payload. A
+    request payload is one batch line, such as "add 123"; the
+    reply payload is a status byte (REPLY_OK or REPLY_ERROR)
+    followed by the result line or the error message, without
+    a newline. The file operations (load, save, loadbin, and
+    savebin) are refused with an error reply, and the socket file
+    is created with mode 0600, so only its owner can connect.
+    Clients may pipeline, sending many requests before reading any
+    replies; each session's requests run in order and its replies
+    come back in that order. A pipelining client must keep reading
+    replies while it sends, since the service stops reading from a
+    session that has too many requests waiting until a worker
+    catches up, and stops running a session's requests while too
+    many of its replies wait to be sent.
+    One I/O thread accepts connections and reads requests from
+    every session with poll(); a fixed pool of worker threads
+    runs them, one session per worker at a time. No thread ever
+    blocks on a client: replies are queued on their session and
+    sent as the socket takes them, so one busy or stalled session
+    never holds up the others.
+    The service uses POSIX sockets, so it is built on Unix-like
+    systems only. The framing helpers are public for clients
+    such as the ServiceLoadGenerator benchmark.
+    This file requires LargeNumber.h, <atomic>, <condition_variable>,
+    <cstddef>, <cstdint>, <deque>, <memory>, <mutex>, <string>,
+    <thread>, and <vector>.
+-------------------------------------------------- */
+
+#ifndef CALCULATOR_SERVICE_H
+#define CALCULATOR_SERVICE_H
+
+#include "LargeNumber.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class CalculatorService {
+public:
+
+    // Protocol constants
+    static const size_t FRAME_HEADER_BYTES = 4;
+    static const size_t MAX_FRAME_BYTES = 0xFFFFFFFF;
+    static const size_t MAX_REQUEST_BYTES = 64 * 1024 * 1024; // Longer requests close the connection
+    static const char REPLY_OK = 0;
+    static const char REPLY_ERROR = 1;
+
+    // Requests, and bytes of requests, a session may have waiting before the service
+    // stops reading from it
+    static const size_t MAX_PENDING_REQUESTS = 1024;
+    static const size_t MAX_PENDING_REQUEST_BYTES = 64 * 1024 * 1024;
+
+    // Bytes of replies a session may have waiting to be sent before its requests stop
+    // running (a single longer reply is still sent whole)
+    static const size_t MAX_PENDING_REPLY_BYTES = 1024 * 1024;
+
+    // Service on a socket path with a fixed number of worker threads (at least one)
+    CalculatorService(const std::string& socketPath, size_t workerCount);
+    ~CalculatorService();
+    CalculatorService(const CalculatorService&) = delete;
+    CalculatorService& operator=(const CalculatorService&) = delete;
+
+    // Bind the socket and start the threads; throws runtime_error if the socket cannot
+    // be created or another service is listening on the path
+    void start();
+
+    // Close every connection, stop the threads, and remove the socket file
+    void stop();
+
+    // Counters since start()
+    size_t getConnectionCount() const;
+    size_t getRequestCount() const;
+    size_t getErrorCount() const;
+
+    // Framing shared with clients: append one frame (throws length_error for a payload
+    // over MAX_FRAME_BYTES), or take the next complete frame from a buffer starting at
+    // offset (returns false if it is not all there yet; throws runtime_error for a
+    // frame longer than limit)
+    static void appendFrame(std::string& out, const char* payload, size_t length);
+    static bool takeFrame(const std::string& buffer, size_t& offset, std::string& payload,
+        size_t limit = MAX_FRAME_BYTES);
+
+    // Socket helpers shared with clients; both throw runtime_error on failure
+    static int connectTo(const std::string& socketPath);
+    static void sendAll(int socket, const char* data, size_t length);
+
+private:
+
+    // One client connection and its current number
+    struct Session {
+        int socket;
+        LargeNumber number;
+        std::string inbox;                 // Bytes read but not yet framed, at most one partial
+                                           // request (I/O thread only)
+        std::mutex lock;
+        std::deque<std::string> requests;  // Framed requests waiting for a worker
+        size_t requestBytes;               // Bytes of those requests
+        std::string outbox;                // Framed replies, sent from outboxSent on
+        size_t outboxSent;
+        bool scheduled;                    // Queued for or held by a worker
+        bool paused;                       // Not read until its requests drain
+        bool stalled;                      // Not run until its replies drain
+        bool closed;                       // No more requests will be read
+        bool broken;                       // A reply could not be sent
+
+        explicit Session(int socket);
+        ~Session();
+    };
+
+    std::string socketPath;
+    size_t workerCount;
+    int listener;
+    int wakeRead;  // Self-pipe that interrupts poll()
+    int wakeWrite;
+    std::atomic<bool> stopping;
+    std::thread ioThread;
+    std::vector<std::thread> workers;
+
+    std::mutex queueLock;
+    std::condition_variable queueReady;
+    std::deque<std::shared_ptr<Session>> ready; // Sessions with requests, oldest first
+
+    std::atomic<size_t> connections;
+    std::atomic<size_t> requests;
+    std::atomic<size_t> errors;
+
+    // Helper methods
+    void ioLoop();
+    void workerLoop();
+    void acceptConnections(std::vector<std::shared_ptr<Session>>& sessions);
+    bool readRequests(const std::shared_ptr<Session>& session);
+    void sendReplies(const std::shared_ptr<Session>& session);
+    void schedule(const std::shared_ptr<Session>& session);
+    void serve(const std::shared_ptr<Session>& session);
+    void wake();
+
+    // Session state helpers; the session's lock must be held
+    static bool hasRequestBacklog(const Session& session);
+    static bool isFinished(const Session& session);
+    static void writeReplies(Session& session);
+};
+
+#endif // CALCULATOR_SERVICE_H
@@ -0,0 +1,277 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the Combinatorics class defined in
+    Combinatorics.h. The product tree stops splitting at runs
+    of LEAF_FACTORS factors, which are multiplied in one word at a
+    time after packing as many factors into each word as fit
+    below the word base.
+    Factorials and binomial coefficients sieve the primes up to
+    n when n is at most SIEVE_LIMIT. A factorial is then squared
+    up bit by bit from the prime exponents, so its long operands
+    come only from the last few steps. Past the limit, a factorial
+    is the product tree of 2..n, and a binomial coefficient
+    multiplies out the k factors of n!/(n-k)! and divides by k!.
+    Result lengths are estimated with lgamma() (and log10() for
+    Fibonacci numbers and powers) before anything is computed.
+    It requires Combinatorics.h, Division.h, Multiplication.h,
+    WordArithmetic.h, <algorithm>, <cmath>, <cstdint>, <stdexcept>,
+    <string>, <utility>, and <vector> to run.
+-------------------------------------------------- */
+
+#include "Combinatorics.h"
+#include "Division.h"
+#include "Multiplication.h"
+#include "WordArithmetic.h"
+#include <algorithm> // For the shorter side of a binomial (min())
+#include <cmath> // For length estimates (lgamma() and log10())
+#include <cstdint>
+#include <stdexcept> // For exceptions (length_error)
+#include <string>
+#include <utility> // For moving words (move())
+#include <vector>
+
+using namespace std;
+
+const uint64_t Combinatorics::MAX_DIGITS;
+
+namespace {
+
+    // Factors multiplied one at a time at the leaves of a product tree
+    const uint64_t LEAF_FACTORS = 32;
+
+    // Largest n whose primes a factorial or binomial coefficient sieves (an odd-only sieve of n/2 bits)
+    const uint64_t SIEVE_LIMIT = 1ULL << 28;
+
+    const double LOG10_E = 0.43429448190325182765;
+    const double LOG10_GOLDEN_RATIO = 0.20898764024997873377;
+
+    // Reject a result estimated to be longer than a LargeNumber can hold
+    void checkDigits(double digits) {
+        if (digits > static_cast<double>(Combinatorics::MAX_DIGITS)) {
+            throw length_error("Result would have more than " + to_string(Combinatorics::MAX_DIGITS) + " digits");
+        }
+    }
+
+    // Multiply words by one factor of any size (multiplySmall() takes factors below one word)
+    void multiplyBy(Words& words, uint64_t factor) {
+        if (factor < WordArithmetic::BASE) {
+            words = WordArithmetic::multiplySmall(words, static_cast<uint32_t>(factor));
+            return;
+        }
+        Words factorWords;
+        for (; factor > 0; factor /= WordArithmetic::BASE) {
+            factorWords.push_back(static_cast<uint32_t>(factor % WordArithmetic::BASE));
+        }
+        Multiplication::multiply(words, factorWords, words);
+    }
+
+    // Product of factor(i) for i in [from, to), split in halves so both sides of each
+    // multiplication are about the same length (factors must be nonzero)
+    template <typename Factor>
+    Words productOf(uint64_t from, uint64_t to, const Factor& factor) {
+        if (to - from <= LEAF_FACTORS) {
+            Words product(1, 1);
+            uint64_t packed = 1;
+            for (uint64_t i = from; i < to; i++) {
+                uint64_t value = factor(i);
+                if (packed > (WordArithmetic::BASE - 1) / value) {
+                    multiplyBy(product, packed);
+                    packed = 1;
+                }
+                packed *= value;
+            }
+            multiplyBy(product, packed);
+            return product;
+        }
+        uint64_t middle = from + (to - from) / 2;
+        Words product;
+        Multiplication::multiply(productOf(from, middle, factor), productOf(middle, to, factor), product);
+        return product;
+    }
+
+    // Primes up to limit
+    vector<uint64_t> primesUpTo(uint64_t limit) {
+        vector<uint64_t> primes;
+        if (limit < 2) {
+            return primes;
+        }
+        primes.push_back(2);
+
+        // composite[i] marks the odd number 2i + 1
+        vector<bool> composite(limit / 2 + 1, false);
+        for (uint64_t i = 1; 2 * i + 1 <= limit; i++) {
+            if (composite[i]) {
+                continue;
+            }
+            uint64_t prime = 2 * i + 1;
+            primes.push_back(prime);
+            for (uint64_t multiple = prime * prime; multiple <= limit; multiple += 2 * prime) {
+                composite[multiple / 2] = true;
+            }
+        }
+        return primes;
+    }
+
+    // Index of the highest set bit of a nonzero value
+    int topBit(uint64_t value) {
+        int bit = 63;
+        while (!((value >> bit) & 1)) {
+            bit--;
+        }
+        return bit;
+    }
+}
+
+// n! from its prime factors, or as the product tree of 2..n when n is too large to sieve
+void Combinatorics::factorial(uint64_t n, Words& result) {
+    checkDigits(lgamma(static_cast<double>(n) + 1) * LOG10_E);
+    if (n < 2) {
+        result.assign(1, 1);
+        return;
+    }
+    if (n > SIEVE_LIMIT) {
+        result = productOf(2, n + 1, [](uint64_t i) { return i; });
+        return;
+    }
+
+    // By Legendre's formula p appears in n! n/p + n/p^2 + ... times
+    vector<uint64_t> primes = primesUpTo(n);
+    vector<uint64_t> exponents(primes.size());
+    for (size_t i = 0; i < primes.size(); i++) {
+        for (uint64_t quotient = n / primes[i]; quotient > 0; quotient /= primes[i]) {
+            exponents[i] += quotient;
+        }
+    }
+
+    // Square once per exponent bit, from the top, multiplying in the primes whose
+    // exponent has that bit; only the last few products and squares are long
+    Words value(1, 1);
+    vector<uint64_t> selected;
+    for (int bit = topBit(exponents[0]); bit >= 0; bit--) {
+        Multiplication::multiply(value, value, value);
+        selected.clear();
+        for (size_t i = 0; i < primes.size() && exponents[i] >= (1ULL << bit); i++) {
+            if ((exponents[i] >> bit) & 1) {
+                selected.push_back(primes[i]);
+            }
+        }
+        Multiplication::multiply(value, productOf(0, selected.size(), [&selected](uint64_t i) { return selected[i]; }), value);
+    }
+    result = move(value);
+}
+
+// n choose k from its prime factors, or as n!/(n-k)! divided by k! when n is too large to sieve
+void Combinatorics::binomial(uint64_t n, uint64_t k, Words& result) {
+    if (k > n) {
+        result.clear();
+        return;
+    }
+    k = min(k, n - k);
+    checkDigits((lgamma(static_cast<double>(n) + 1) - lgamma(static_cast<double>(k) + 1)
+        - lgamma(static_cast<double>(n - k) + 1)) * LOG10_E);
+    if (k == 0) {
+        result.assign(1, 1);
+        return;
+    }
+
+    if (n > SIEVE_LIMIT) {
+        Words numerator = productOf(0, k, [n](uint64_t i) { return n - i; });
+        Words denominator;
+        Words remainder;
+        factorial(k, denominator);
+        Division::divide(numerator, denominator, result, remainder);
+        return;
+    }
+
+    // By Kummer's theorem, p divides n choose k once per borrow when subtracting k from n
+    // in base p, so each prime power factor is at most n
+    vector<uint64_t> factors;
+    for (uint64_t prime : primesUpTo(n)) {
+        uint64_t power = 1;
+        uint64_t borrow = 0;
+        for (uint64_t high = n, low = k; high > 0; high /= prime, low /= prime) {
+            uint64_t digit = low % prime + borrow;
+            borrow = digit > high % prime ? 1 : 0;
+            if (borrow) {
+                power *= prime;
+            }
+        }
+        if (power > 1) {
+            factors.push_back(power);
+        }
+    }
+    result = productOf(0, factors.size(), [&factors](uint64_t i) { return factors[i]; });
+}
+
+// F(n) by doubling from F(k-1) and F(k): F(2k-1) = F(k)^2 + F(k-1)^2 and
+// F(2k+1) = 4F(k)^2 - F(k-1)^2 + 2(-1)^k, with F(2k) their difference
+void Combinatorics::fibonacci(uint64_t n, Words& result) {
+    checkDigits(static_cast<double>(n) * LOG10_GOLDEN_RATIO);
+    if (n == 0) {
+        result.clear();
+        return;
+    }
+    Words previous;
+    Words current(1, 1);
+    uint64_t k = 1;
+    for (int bit = topBit(n) - 1; bit >= 0; bit--) {
+        Words previousSquare;
+        Words currentSquare;
+        Multiplication::multiply(previous, previous, previousSquare);
+        Multiplication::multiply(current, current, currentSquare);
+
+        Words odd = WordArithmetic::multiplySmall(currentSquare, 4);
+        WordArithmetic::subtractInPlace(odd, previousSquare);
+        if (k % 2 == 0) {
+            WordArithmetic::increment(odd);
+            WordArithmetic::increment(odd);
+        }
+        else {
+            WordArithmetic::decrement(odd);
+            WordArithmetic::decrement(odd);
+        }
+        Words before = WordArithmetic::add(currentSquare, previousSquare);
+        Words even(odd);
+        WordArithmetic::subtractInPlace(even, before);
+
+        // Step to 2k + 1 for a set bit, to 2k otherwise
+        if ((n >> bit) & 1) {
+            previous = move(even);
+            current = move(odd);
+            k = 2 * k + 1;
+        }
+        else {
+            previous = move(before);
+            current = move(even);
+            k = 2 * k;
+        }
+    }
+    result = move(current);
+}
+
+// base^exponent by squaring from the top bit of the exponent, multiplying in the base at each set bit
+void Combinatorics::power(const Words& base, uint64_t exponent, Words& result) {
+    Words factor(base);
+    WordArithmetic::trim(factor);
+    if (exponent == 0 || (factor.size() == 1 && factor[0] == 1)) {
+        result.assign(1, 1);
+        return;
+    }
+    if (factor.empty()) {
+        result.clear();
+        return;
+    }
+    checkDigits((log10(static_cast<double>(factor.back())) + 9.0 * static_cast<double>(factor.size() - 1))
+        * static_cast<double>(exponent));
+
+    Words value(factor);
+    for (int bit = topBit(exponent) - 1; bit >= 0; bit--) {
+        Multiplication::multiply(value, value, value);
+        if ((exponent >> bit) & 1) {
+            Multiplication::multiply(value, factor, value);
+        }
+    }
+    result = move(value);
+}
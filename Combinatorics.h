@@ -0,0 +1,52 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the Combinatorics class, which
+    builds factorials, binomial coefficients, Fibonacci numbers,
+    and powers as base 10^9 words (least significant first)
+    without adding anything up one step at a time. Products of
+    many factors are split in halves recursively (a product
+    tree), so every multiplication joins two operands of about
+    the same length and the large ones run on the fast
+    Multiplication algorithms; small factors are first packed
+    into single words. A factorial is built from its prime
+    factors by squaring, with exponents from Legendre's formula,
+    and a binomial coefficient is the product of its prime
+    factors, whose exponents come from Kummer's theorem, so no
+    division is needed. Fibonacci numbers use
+    doubling formulas with two squarings per bit of n, and powers
+    square and multiply. Results that would be too long to hold
+    in a LargeNumber are rejected before any work is done.
+    This file requires WordArithmetic.h and <cstdint>.
+-------------------------------------------------- */
+
+#ifndef COMBINATORICS_H
+#define COMBINATORICS_H
+
+#include "WordArithmetic.h"
+#include <cstdint>
+
+class Combinatorics {
+public:
+
+    // Longest result accepted, in decimal digits (LargeNumber counts 3-digit groups in an int)
+    static const uint64_t MAX_DIGITS = 6000000000ULL;
+
+    // n!
+    static void factorial(uint64_t n, Words& result);
+
+    // n choose k (zero when k > n)
+    static void binomial(uint64_t n, uint64_t k, Words& result);
+
+    // The nth Fibonacci number, with F(0) = 0 and F(1) = 1
+    static void fibonacci(uint64_t n, Words& result);
+
+    // base^exponent, with anything to the power 0 being 1
+    static void power(const Words& base, uint64_t exponent, Words& result);
+
+private:
+    Combinatorics() = delete;
+};
+
+#endif // COMBINATORICS_H
@@ -0,0 +1,343 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the Division class defined in
+    Division.h. Operands are base 10^9 words, least significant
+    first. Schoolbook division is Knuth's Algorithm D with
+    64-bit quotient estimates. Burnikel-Ziegler normalizes the
+    divisor, pads it to a block size that halves cleanly, and
+    divides block by block with the 2n/1n and 3n/2n recursion.
+    The reciprocal path builds BASE^k / divisor from below with
+    Newton's iteration, doubling the precision each step, then
+    multiplies and corrects the quotient by a few units.
+    It requires Division.h, Multiplication.h, WordArithmetic.h,
+    <algorithm>, <atomic>, and <stdexcept> to run.
+-------------------------------------------------- */
+
+#include "Division.h"
+#include "Multiplication.h"
+#include "WordArithmetic.h"
+#include <algorithm> // For element ranges (copy(), max(), and min())
+#include <atomic> // For thresholds shared between threads (atomic)
+#include <stdexcept> // For exception handling (domain_error)
+
+using namespace std;
+
+namespace {
+
+    const uint32_t BASE = WordArithmetic::BASE;
+
+    // Active thresholds
+    atomic<size_t> burnikelZieglerThreshold{ DivisionThresholds().burnikelZiegler };
+    atomic<size_t> newtonReciprocalThreshold{ DivisionThresholds().newtonReciprocal };
+
+    // Precision, in words, below which a reciprocal is computed exactly
+    const size_t RECIPROCAL_BASE_WORDS = 32;
+
+    Words product(const Words& a, const Words& b) {
+        Words result;
+        Multiplication::multiply(a, b, result);
+        return result;
+    }
+
+    // BASE^exponent
+    Words power(size_t exponent) {
+        Words result(exponent + 1, 0);
+        result.back() = 1;
+        return result;
+    }
+
+    // Knuth's Algorithm D
+    void divideSchoolbook(const Words& a, const Words& b, Words& quotient, Words& remainder) {
+        if (WordArithmetic::compare(a, b) < 0) {
+            quotient.clear();
+            remainder = a;
+            return;
+        }
+        if (b.size() == 1) {
+            uint32_t rest = WordArithmetic::divideSmall(a, b[0], quotient);
+            remainder.clear();
+            if (rest != 0) {
+                remainder.push_back(rest);
+            }
+            return;
+        }
+
+        // Scale so the top divisor word is at least BASE / 2
+        uint32_t scale = BASE / (b.back() + 1);
+        Words v = WordArithmetic::multiplySmall(b, scale);
+        Words u = WordArithmetic::multiplySmall(a, scale);
+        u.resize(a.size() + 1, 0);
+        size_t n = v.size();
+        size_t m = u.size() - n;
+        uint64_t top = v[n - 1];
+        uint64_t second = v[n - 2];
+
+        quotient.assign(m, 0);
+        for (size_t j = m; j-- > 0;) {
+            // Estimate from the top two words, then refine with the third
+            uint64_t numerator = static_cast<uint64_t>(u[j + n]) * BASE + u[j + n - 1];
+            uint64_t estimate = numerator / top;
+            uint64_t rest = numerator % top;
+            while (estimate >= BASE || estimate * second > rest * BASE + u[j + n - 2]) {
+                estimate--;
+                rest += top;
+                if (rest >= BASE) {
+                    break;
+                }
+            }
+
+            // Subtract estimate * v from the current window
+            uint64_t carry = 0;
+            int64_t borrow = 0;
+            for (size_t i = 0; i < n; i++) {
+                uint64_t partial = estimate * v[i] + carry;
+                carry = partial / BASE;
+                int64_t difference = static_cast<int64_t>(u[i + j]) - static_cast<int64_t>(partial % BASE) - borrow;
+                borrow = difference < 0 ? 1 : 0;
+                u[i + j] = static_cast<uint32_t>(borrow ? difference + BASE : difference);
+            }
+            int64_t difference = static_cast<int64_t>(u[j + n]) - static_cast<int64_t>(carry) - borrow;
+
+            // The estimate was one too large: add the divisor back
+            if (difference < 0) {
+                u[j + n] = static_cast<uint32_t>(difference + BASE);
+                estimate--;
+                uint32_t addCarry = 0;
+                for (size_t i = 0; i < n; i++) {
+                    uint32_t sum = u[i + j] + v[i] + addCarry;
+                    addCarry = sum >= BASE ? 1 : 0;
+                    u[i + j] = addCarry ? sum - BASE : sum;
+                }
+                u[j + n] = (u[j + n] + addCarry) % BASE;
+            }
+            else {
+                u[j + n] = static_cast<uint32_t>(difference);
+            }
+            quotient[j] = static_cast<uint32_t>(estimate);
+        }
+        WordArithmetic::trim(quotient);
+
+        // Undo the scaling on the remainder
+        u.resize(n);
+        WordArithmetic::trim(u);
+        WordArithmetic::divideSmall(u, scale, remainder);
+    }
+
+    void divide3n2n(const Words& a, const Words& b, size_t half, Words& quotient, Words& remainder);
+
+    // Divide a < b * BASE^n by a normalized divisor of exactly n words
+    void divide2n1n(const Words& a, const Words& b, size_t n, Words& quotient, Words& remainder) {
+        if (n % 2 != 0 || n < burnikelZieglerThreshold.load(memory_order_relaxed)) {
+            divideSchoolbook(a, b, quotient, remainder);
+            return;
+        }
+        size_t half = n / 2;
+
+        // Upper three halves first, then the remainder joined with the last half
+        Words high, partial;
+        divide3n2n(WordArithmetic::shiftRight(a, half), b, half, high, partial);
+        Words next = WordArithmetic::shiftLeft(partial, half);
+        WordArithmetic::addInPlace(next, WordArithmetic::slice(a, 0, half));
+        Words low;
+        divide3n2n(next, b, half, low, remainder);
+
+        quotient = WordArithmetic::shiftLeft(high, half);
+        WordArithmetic::addInPlace(quotient, low);
+    }
+
+    // Divide a < b * BASE^half by a normalized divisor of exactly 2 * half words
+    void divide3n2n(const Words& a, const Words& b, size_t half, Words& quotient, Words& remainder) {
+        Words b1 = WordArithmetic::shiftRight(b, half);
+        Words b2 = WordArithmetic::slice(b, 0, half);
+
+        // Estimate the quotient from the top two halves of a and the top half of b
+        Words a12 = WordArithmetic::shiftRight(a, half);
+        Words partial;
+        if (WordArithmetic::compare(WordArithmetic::shiftRight(a, 2 * half), b1) < 0) {
+            divide2n1n(a12, b1, half, quotient, partial);
+        }
+        else {
+            quotient.assign(half, BASE - 1);
+            partial = WordArithmetic::add(a12, b1);
+            WordArithmetic::subtractInPlace(partial, WordArithmetic::shiftLeft(b1, half));
+        }
+
+        // Account for the low half of b; the estimate is at most two too large
+        Words correction = product(quotient, b2);
+        remainder = WordArithmetic::shiftLeft(partial, half);
+        WordArithmetic::addInPlace(remainder, WordArithmetic::slice(a, 0, half));
+        while (WordArithmetic::compare(remainder, correction) < 0) {
+            WordArithmetic::addInPlace(remainder, b);
+            WordArithmetic::decrement(quotient);
+        }
+        WordArithmetic::subtractInPlace(remainder, correction);
+    }
+
+    void divideBurnikelZiegler(const Words& a, const Words& b, Words& quotient, Words& remainder) {
+        if (WordArithmetic::compare(a, b) < 0) {
+            quotient.clear();
+            remainder = a;
+            return;
+        }
+
+        // Pad the divisor to m * 2^k words with m at most the threshold, so every halving is exact
+        size_t threshold = burnikelZieglerThreshold.load(memory_order_relaxed);
+        size_t blockSize = b.size();
+        size_t doublings = 0;
+        while (blockSize > threshold) {
+            blockSize = (blockSize + 1) / 2;
+            doublings++;
+        }
+        blockSize <<= doublings;
+        size_t shift = blockSize - b.size();
+        uint32_t scale = BASE / (b.back() + 1);
+        Words divisor = WordArithmetic::shiftLeft(WordArithmetic::multiplySmall(b, scale), shift);
+        Words dividend = WordArithmetic::shiftLeft(WordArithmetic::multiplySmall(a, scale), shift);
+
+        // Leave the top block smaller than the divisor
+        size_t blocks = max<size_t>(2, (dividend.size() + blockSize) / blockSize);
+        quotient.assign((blocks - 1) * blockSize, 0);
+        Words window = WordArithmetic::slice(dividend, (blocks - 2) * blockSize, dividend.size());
+        for (size_t i = blocks - 1; i-- > 0;) {
+            Words digit, rest;
+            divide2n1n(window, divisor, blockSize, digit, rest);
+            copy(digit.begin(), digit.end(), quotient.begin() + i * blockSize);
+            if (i > 0) {
+                window = WordArithmetic::shiftLeft(rest, blockSize);
+                WordArithmetic::addInPlace(window, WordArithmetic::slice(dividend, (i - 1) * blockSize, i * blockSize));
+            }
+            else {
+                remainder = rest;
+            }
+        }
+        WordArithmetic::trim(quotient);
+        WordArithmetic::divideSmall(WordArithmetic::shiftRight(remainder, shift), scale, remainder);
+    }
+
+    // BASE^(b.size() + precision) / b, from below and within a few units
+    Words reciprocal(const Words& b, size_t precision) {
+        size_t n = b.size();
+        if (precision <= RECIPROCAL_BASE_WORDS) {
+            Words exact, rest;
+            divideSchoolbook(power(n + precision), b, exact, rest);
+            return exact;
+        }
+
+        // The half-precision estimate only needs the top words of b; truncating b can
+        // raise it by less than one unit, so step it down to stay below the true value
+        size_t lower = precision / 2 + 1;
+        Words estimate;
+        if (n > lower + 2) {
+            estimate = reciprocal(WordArithmetic::shiftRight(b, n - (lower + 2)), lower);
+            WordArithmetic::decrement(estimate);
+        }
+        else {
+            estimate = reciprocal(b, lower);
+        }
+
+        // x' = x + x * (BASE^k - b * x) / BASE^k at double the precision of x
+        Words x = WordArithmetic::shiftLeft(estimate, precision - lower);
+        Words residual = power(n + precision);
+        WordArithmetic::subtractInPlace(residual, product(b, x));
+        WordArithmetic::addInPlace(x, WordArithmetic::shiftRight(product(x, residual), n + precision));
+        return x;
+    }
+
+    void divideNewtonReciprocal(const Words& a, const Words& b, Words& quotient, Words& remainder) {
+        if (WordArithmetic::compare(a, b) < 0) {
+            quotient.clear();
+            remainder = a;
+            return;
+        }
+
+        // Only the top words of a long divisor affect the quotient estimate
+        size_t precision = a.size() - b.size() + 2;
+        size_t drop = b.size() > precision ? b.size() - precision : 0;
+        Words divisorTop = WordArithmetic::shiftRight(b, drop);
+        Words dividendTop = WordArithmetic::shiftRight(a, drop);
+        Words inverse = reciprocal(divisorTop, precision);
+        quotient = WordArithmetic::shiftRight(product(dividendTop, inverse), divisorTop.size() + precision);
+
+        // Correct the estimate against the full operands
+        Words multiple = product(quotient, b);
+        while (WordArithmetic::compare(multiple, a) > 0) {
+            WordArithmetic::decrement(quotient);
+            WordArithmetic::subtractInPlace(multiple, b);
+        }
+        remainder = a;
+        WordArithmetic::subtractInPlace(remainder, multiple);
+        while (WordArithmetic::compare(remainder, b) >= 0) {
+            WordArithmetic::increment(quotient);
+            WordArithmetic::subtractInPlace(remainder, b);
+        }
+    }
+
+    void run(const Words& a, const Words& b, Words& quotient, Words& remainder, DivisionAlgorithm algorithm) {
+        switch (algorithm) {
+        case DivisionAlgorithm::NewtonReciprocal:
+            divideNewtonReciprocal(a, b, quotient, remainder);
+            break;
+        case DivisionAlgorithm::BurnikelZiegler:
+            divideBurnikelZiegler(a, b, quotient, remainder);
+            break;
+        default:
+            divideSchoolbook(a, b, quotient, remainder);
+            break;
+        }
+    }
+}
+
+// Divide two magnitudes, choosing the algorithm by size
+void Division::divide(const vector<uint32_t>& dividend, const vector<uint32_t>& divisor,
+    vector<uint32_t>& quotient, vector<uint32_t>& remainder) {
+    Words a(dividend), b(divisor);
+    WordArithmetic::trim(a);
+    WordArithmetic::trim(b);
+    if (b.empty()) {
+        throw domain_error("Division by zero");
+    }
+    run(a, b, quotient, remainder, selectAlgorithm(a.size(), b.size()));
+}
+
+// Divide with a fixed top-level algorithm
+void Division::divide(const vector<uint32_t>& dividend, const vector<uint32_t>& divisor,
+    vector<uint32_t>& quotient, vector<uint32_t>& remainder, DivisionAlgorithm algorithm) {
+    Words a(dividend), b(divisor);
+    WordArithmetic::trim(a);
+    WordArithmetic::trim(b);
+    if (b.empty()) {
+        throw domain_error("Division by zero");
+    }
+    run(a, b, quotient, remainder, algorithm);
+}
+
+// Pick the algorithm by the shorter of divisor and quotient
+DivisionAlgorithm Division::selectAlgorithm(size_t dividendWords, size_t divisorWords) {
+    if (divisorWords > dividendWords) {
+        return DivisionAlgorithm::Schoolbook;
+    }
+    size_t shorter = min(divisorWords, dividendWords - divisorWords + 1);
+    if (shorter >= newtonReciprocalThreshold.load(memory_order_relaxed)) {
+        return DivisionAlgorithm::NewtonReciprocal;
+    }
+    if (shorter >= burnikelZieglerThreshold.load(memory_order_relaxed)) {
+        return DivisionAlgorithm::BurnikelZiegler;
+    }
+    return DivisionAlgorithm::Schoolbook;
+}
+
+// Get the active thresholds
+DivisionThresholds Division::getThresholds() {
+    DivisionThresholds current;
+    current.burnikelZiegler = burnikelZieglerThreshold.load(memory_order_relaxed);
+    current.newtonReciprocal = newtonReciprocalThreshold.load(memory_order_relaxed);
+    return current;
+}
+
+// Replace the active thresholds (the recursion needs two words to split)
+void Division::setThresholds(const DivisionThresholds& newThresholds) {
+    burnikelZieglerThreshold.store(max<size_t>(newThresholds.burnikelZiegler, 2), memory_order_relaxed);
+    newtonReciprocalThreshold.store(max<size_t>(newThresholds.newtonReciprocal, 2), memory_order_relaxed);
+}
@@ -0,0 +1,58 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the Division class, which divides
+    magnitudes stored as base 10^9 words (least significant
+    first) and returns both quotient and remainder. It picks an
+    algorithm by operand size: schoolbook long division for
+    short divisors or short quotients, Burnikel-Ziegler recursive
+    division in the middle, and Newton iteration on the divisor's
+    reciprocal for the largest inputs. The two fast paths run on
+    top of Multiplication, so they inherit its speed.
+    This file requires <cstddef>, <cstdint>, and <vector>.
+-------------------------------------------------- */
+
+#ifndef DIVISION_H
+#define DIVISION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Division algorithms in order of increasing operand size
+enum class DivisionAlgorithm {
+    Schoolbook,
+    BurnikelZiegler,
+    NewtonReciprocal
+};
+
+// Smallest divisor and quotient length, in base 10^9 words, at which each algorithm takes over
+struct DivisionThresholds {
+    size_t burnikelZiegler = 48;
+    size_t newtonReciprocal = 49152;
+};
+
+class Division {
+public:
+
+    // Divide two magnitudes, choosing the algorithm by size (divisor must be nonzero)
+    static void divide(const std::vector<uint32_t>& dividend, const std::vector<uint32_t>& divisor,
+        std::vector<uint32_t>& quotient, std::vector<uint32_t>& remainder);
+
+    // Divide with a fixed top-level algorithm
+    static void divide(const std::vector<uint32_t>& dividend, const std::vector<uint32_t>& divisor,
+        std::vector<uint32_t>& quotient, std::vector<uint32_t>& remainder, DivisionAlgorithm algorithm);
+
+    // Algorithm the size-based selection would use for these operand lengths
+    static DivisionAlgorithm selectAlgorithm(size_t dividendWords, size_t divisorWords);
+
+    // Threshold configuration
+    static DivisionThresholds getThresholds();
+    static void setThresholds(const DivisionThresholds& newThresholds);
+
+private:
+    Division() = delete;
+};
+
+#endif // DIVISION_H
@@ -0,0 +1,198 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the ExpressionGraph and Expression
+    classes defined in ExpressionGraph.h. Nodes are looked up by
+    operation and operands before one is added, with the operands
+    of + and * put in order first, so the graph never holds the
+    same subexpression twice. To evaluate an addition or
+    subtraction, the chain below it is flattened into signed
+    operands: the walk goes through +/- nodes used only by that
+    chain and stops at variables, products, and shared nodes,
+    which are evaluated (and stored) on their own. Operands that
+    appear with both signs cancel before the single
+    LargeNumber::sum() pass. Every computed node keeps its value;
+    marking a variable as changed clears the nodes above it.
+    It requires ExpressionGraph.h, <algorithm>, <map>,
+    <stdexcept>, and <utility> to run.
+-------------------------------------------------- */
+
+#include "ExpressionGraph.h"
+#include <algorithm> // For operand order (swap())
+#include <map> // For operand multiplicities (map)
+#include <stdexcept> // For exceptions (invalid_argument)
+#include <utility> // For signed operands (pair)
+
+using namespace std;
+
+// Add a node for the sum of two expressions of one graph
+Expression Expression::operator+(const Expression& other) const {
+    checkGraph(other);
+    return Expression(graph, graph->addNode(ExpressionGraph::Operation::Add, node, other.node));
+}
+
+// Add a node for the difference of two expressions of one graph
+Expression Expression::operator-(const Expression& other) const {
+    checkGraph(other);
+    return Expression(graph, graph->addNode(ExpressionGraph::Operation::Subtract, node, other.node));
+}
+
+// Add a node for the product of two expressions of one graph
+Expression Expression::operator*(const Expression& other) const {
+    checkGraph(other);
+    return Expression(graph, graph->addNode(ExpressionGraph::Operation::Multiply, node, other.node));
+}
+
+// Make sure two expressions can be combined
+void Expression::checkGraph(const Expression& other) const {
+    if (graph != other.graph) {
+        throw invalid_argument("Expressions belong to different graphs");
+    }
+}
+
+// Compute the value through the owning graph
+LargeNumber Expression::evaluate() const {
+    return graph->evaluate(*this);
+}
+
+// Get the node reading a variable, adding it the first time
+Expression ExpressionGraph::variable(const LargeNumber& number) {
+    unordered_map<const LargeNumber*, int>::iterator found = variables.find(&number);
+    if (found != variables.end()) {
+        stats.sharedBuilds++;
+        return Expression(this, found->second);
+    }
+    ExpressionNode node{ Operation::Variable, -1, -1, &number, 0, false, LargeNumber() };
+    nodes.push_back(move(node));
+    int id = static_cast<int>(nodes.size()) - 1;
+    variables[&number] = id;
+    return Expression(this, id);
+}
+
+// Compute an expression, or return its stored result
+LargeNumber ExpressionGraph::evaluate(const Expression& expression) {
+    if (expression.graph != this) {
+        throw invalid_argument("Expression belongs to another graph");
+    }
+    return valueOf(expression.node);
+}
+
+// Clear the stored results of every node that depends on a variable
+void ExpressionGraph::invalidate(const LargeNumber& number) {
+    unordered_map<const LargeNumber*, int>::iterator found = variables.find(&number);
+    if (found == variables.end()) {
+        return;
+    }
+
+    // Operands come before their users, so one forward sweep reaches every dependent
+    vector<char> changed(nodes.size(), 0);
+    changed[found->second] = 1;
+    for (size_t i = static_cast<size_t>(found->second) + 1; i < nodes.size(); i++) {
+        ExpressionNode& node = nodes[i];
+        if (node.operation != Operation::Variable && (changed[node.left] || changed[node.right])) {
+            changed[i] = 1;
+            node.cached = false;
+            node.value = LargeNumber();
+        }
+    }
+}
+
+// Clear every stored result
+void ExpressionGraph::invalidate() {
+    for (ExpressionNode& node : nodes) {
+        node.cached = false;
+        node.value = LargeNumber();
+    }
+}
+
+// Get the counters
+ExpressionGraphStats ExpressionGraph::getStats() const {
+    ExpressionGraphStats current = stats;
+    current.nodes = nodes.size();
+    return current;
+}
+
+// Get the node for an operation, adding it only if no equal node exists
+int ExpressionGraph::addNode(Operation operation, int left, int right) {
+    // Addition and multiplication commute, so their operands are kept in order
+    if ((operation == Operation::Add || operation == Operation::Multiply) && left > right) {
+        swap(left, right);
+    }
+    uint64_t key = (static_cast<uint64_t>(operation) << 62) | (static_cast<uint64_t>(left) << 31) | static_cast<uint64_t>(right);
+    unordered_map<uint64_t, int>::iterator found = operations.find(key);
+    if (found != operations.end()) {
+        stats.sharedBuilds++;
+        return found->second;
+    }
+
+    ExpressionNode node{ operation, left, right, nullptr, 0, false, LargeNumber() };
+    nodes.push_back(move(node));
+    nodes[left].uses++;
+    nodes[right].uses++;
+    int id = static_cast<int>(nodes.size()) - 1;
+    operations[key] = id;
+    return id;
+}
+
+// Get the value of a node, computing and storing it if needed
+const LargeNumber& ExpressionGraph::valueOf(int id) {
+    if (nodes[id].operation == Operation::Variable) {
+        return *nodes[id].number;
+    }
+    if (nodes[id].cached) {
+        stats.cacheHits++;
+        return nodes[id].value;
+    }
+
+    LargeNumber value;
+    if (nodes[id].operation == Operation::Multiply) {
+        const LargeNumber& left = valueOf(nodes[id].left);
+        value = left * valueOf(nodes[id].right);
+    }
+    else {
+        vector<pair<int, bool>> found;
+        collectTerms(nodes[id].left, false, found);
+        collectTerms(nodes[id].right, nodes[id].operation == Operation::Subtract, found);
+
+        // Count each operand once per sign it carries, so x - x cancels before any limbs are read
+        map<int, long long> counts;
+        for (const pair<int, bool>& term : found) {
+            counts[term.first] += term.second ? -1 : 1;
+        }
+        vector<SumTerm> terms;
+        for (const pair<const int, long long>& count : counts) {
+            const LargeNumber& operand = valueOf(count.first);
+            for (long long i = 0; i < (count.second < 0 ? -count.second : count.second); i++) {
+                terms.push_back(SumTerm{ &operand, count.second < 0 });
+            }
+        }
+        value = LargeNumber::sum(terms);
+        stats.fusedSums++;
+        stats.fusedTerms += terms.size();
+    }
+
+    nodes[id].value = move(value);
+    nodes[id].cached = true;
+    return nodes[id].value;
+}
+
+// Flatten the chain of additions and subtractions below a node into signed operands,
+// stopping at variables, products, and nodes that other operations share
+void ExpressionGraph::collectTerms(int id, bool subtract, vector<pair<int, bool>>& terms) {
+
+    // Walk with an explicit stack, since chains can be far deeper than the call stack allows
+    vector<pair<int, bool>> pending(1, make_pair(id, subtract));
+    while (!pending.empty()) {
+        pair<int, bool> current = pending.back();
+        pending.pop_back();
+        const ExpressionNode& node = nodes[current.first];
+        bool chain = node.operation == Operation::Add || node.operation == Operation::Subtract;
+        if (!chain || node.uses > 1 || node.cached) {
+            terms.push_back(current);
+            continue;
+        }
+        pending.emplace_back(node.right, node.operation == Operation::Subtract ? !current.second : current.second);
+        pending.emplace_back(node.left, current.second);
+    }
+}
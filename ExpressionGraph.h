@@ -0,0 +1,109 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the ExpressionGraph class, a small
+    expression DAG over LargeNumber variables, and the Expression
+    handle used to build it with +, -, and *. Nothing is computed
+    while an expression is built. Asking for the same operation on
+    the same operands returns the existing node, so common
+    subexpressions are shared. Evaluation folds each chain of
+    additions and subtractions into one LargeNumber::sum() pass
+    over its operands, and keeps every computed node so that later
+    evaluations reuse it until a variable it depends on is marked
+    as changed.
+    This file requires LargeNumber.h, <cstddef>, <cstdint>,
+    <unordered_map>, <utility>, and <vector>.
+-------------------------------------------------- */
+
+#ifndef EXPRESSION_GRAPH_H
+#define EXPRESSION_GRAPH_H
+
+#include "LargeNumber.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class ExpressionGraph;
+
+// Counters for the expression graph
+struct ExpressionGraphStats {
+    size_t nodes;        // Distinct nodes, variables included
+    size_t sharedBuilds; // Operations that returned an existing node
+    size_t fusedSums;    // LargeNumber::sum() passes run
+    size_t fusedTerms;   // Operands read by those passes
+    size_t cacheHits;    // Evaluations answered from a stored result
+};
+
+// A node of an ExpressionGraph; combining two expressions adds a node to their graph
+class Expression {
+public:
+    Expression operator+(const Expression& other) const;
+    Expression operator-(const Expression& other) const;
+    Expression operator*(const Expression& other) const;
+
+    // Compute the value, reusing any stored results
+    LargeNumber evaluate() const;
+
+private:
+    friend class ExpressionGraph;
+    Expression(ExpressionGraph* owner, int id) : graph(owner), node(id) {}
+    void checkGraph(const Expression& other) const;
+
+    ExpressionGraph* graph;
+    int node;
+};
+
+class ExpressionGraph {
+public:
+
+    // Default constructor
+    ExpressionGraph() = default;
+
+    // A variable reads number when evaluated; number must outlive the graph
+    Expression variable(const LargeNumber& number);
+
+    // Compute an expression of this graph
+    LargeNumber evaluate(const Expression& expression);
+
+    // Drop stored results that depend on a changed variable, or all of them
+    void invalidate(const LargeNumber& number);
+    void invalidate();
+
+    // Counters
+    ExpressionGraphStats getStats() const;
+
+private:
+    friend class Expression;
+
+    enum class Operation {
+        Variable,
+        Add,
+        Subtract,
+        Multiply
+    };
+
+    struct ExpressionNode {
+        Operation operation;
+        int left;
+        int right;
+        const LargeNumber* number; // Variables only
+        int uses;                  // Operations that take this node as an operand
+        bool cached;
+        LargeNumber value;         // Stored result while cached is set
+    };
+
+    std::vector<ExpressionNode> nodes; // Operands always come before the nodes using them
+    std::unordered_map<uint64_t, int> operations;
+    std::unordered_map<const LargeNumber*, int> variables;
+    ExpressionGraphStats stats = {};
+
+    // Helper methods
+    int addNode(Operation operation, int left, int right);
+    const LargeNumber& valueOf(int node);
+    void collectTerms(int node, bool subtract, std::vector<std::pair<int, bool>>& terms);
+};
+
+#endif // EXPRESSION_GRAPH_H
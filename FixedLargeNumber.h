@@ -0,0 +1,315 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the FixedLargeNumber class
+    template, a signed number of at most Digits decimal digits
+    held in a fixed array of base 10^18 limbs on the stack.
+    With no list, pool, or heap behind it, construction from
+    digits, addition, subtraction, and comparison are constexpr
+    and loop over a limb count known at compile time, so the
+    compiler can unroll them completely. It keeps the LargeNumber
+    interface for those operations and for printing, and
+    converts to and from LargeNumber so both can be used in one
+    calculation. A value that needs more than Digits digits
+    throws overflow_error (at compile time, a constant expression
+    that overflows does not compile).
+    This file requires LargeNumber.h, <cstddef>, <cstdint>,
+    <iostream>, <stdexcept>, <string>, and <vector>.
+-------------------------------------------------- */
+
+#ifndef FIXED_LARGE_NUMBER_H
+#define FIXED_LARGE_NUMBER_H
+
+#include "LargeNumber.h"
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+template <std::size_t Digits>
+class FixedLargeNumber {
+    static_assert(Digits > 0, "FixedLargeNumber needs at least one digit");
+
+public:
+
+    // Limb layout, the same as LargeNumber's
+    static constexpr uint64_t LIMB_BASE = 1000000000000000000ULL;
+    static constexpr int LIMB_DIGITS = 18;
+    static constexpr int LIMBS = static_cast<int>((Digits + LIMB_DIGITS - 1) / LIMB_DIGITS);
+
+    // Constructors
+    constexpr FixedLargeNumber() : limbs{}, negative(false) {}
+    constexpr FixedLargeNumber(const char* digits, std::size_t length);
+    explicit FixedLargeNumber(const std::string& number) : FixedLargeNumber(number.data(), number.length()) {}
+    explicit FixedLargeNumber(const LargeNumber& number);
+
+    // Arithmetic operations
+    constexpr FixedLargeNumber operator+(const FixedLargeNumber& other) const;
+    constexpr FixedLargeNumber operator-(const FixedLargeNumber& other) const;
+    constexpr FixedLargeNumber& operator+=(const FixedLargeNumber& other);
+    constexpr FixedLargeNumber& operator-=(const FixedLargeNumber& other);
+
+    // Compare magnitudes, ignoring signs: negative, zero, or positive
+    constexpr int compareMagnitude(const FixedLargeNumber& other) const;
+
+    // Signed comparison operators
+    constexpr bool operator==(const FixedLargeNumber& other) const { return compare(other) == 0; }
+    constexpr bool operator!=(const FixedLargeNumber& other) const { return compare(other) != 0; }
+    constexpr bool operator<(const FixedLargeNumber& other) const { return compare(other) < 0; }
+    constexpr bool operator<=(const FixedLargeNumber& other) const { return compare(other) <= 0; }
+    constexpr bool operator>(const FixedLargeNumber& other) const { return compare(other) > 0; }
+    constexpr bool operator>=(const FixedLargeNumber& other) const { return compare(other) >= 0; }
+
+    // Overloaded output stream operator, printing like LargeNumber
+    friend std::ostream& operator<<(std::ostream& os, const FixedLargeNumber& num) {
+        return os << num.toString();
+    }
+    std::string toString() const;
+
+    // Conversion to the dynamic LargeNumber
+    LargeNumber toLargeNumber() const;
+
+    // Accessor methods
+    constexpr bool isNegative() const { return negative; }
+    constexpr bool isZero() const;
+
+private:
+    uint64_t limbs[LIMBS]; // Limbs in base 10^18, least significant first
+    bool negative;
+
+    // Helper methods for internal operations
+    static constexpr uint64_t topLimit();
+    static constexpr uint64_t parseDigits(const char* digits, std::size_t length);
+    constexpr int compare(const FixedLargeNumber& other) const;
+    constexpr void combine(const FixedLargeNumber& other, bool otherNegative);
+    constexpr void addMagnitude(const FixedLargeNumber& other);
+    constexpr void subtractMagnitude(const FixedLargeNumber& other, bool reversed);
+};
+
+// Limb layout constants
+template <std::size_t Digits>
+constexpr uint64_t FixedLargeNumber<Digits>::LIMB_BASE;
+template <std::size_t Digits>
+constexpr int FixedLargeNumber<Digits>::LIMB_DIGITS;
+template <std::size_t Digits>
+constexpr int FixedLargeNumber<Digits>::LIMBS;
+
+// Constructor from a digit buffer with an optional leading minus sign
+template <std::size_t Digits>
+constexpr FixedLargeNumber<Digits>::FixedLargeNumber(const char* digits, std::size_t length) : limbs{}, negative(false) {
+    std::size_t start = 0;
+    bool isNegative = length > 0 && digits[0] == '-';
+    if (isNegative) {
+        start = 1;
+        if (length == 1) {
+            throw std::invalid_argument("Invalid digit in number");
+        }
+    }
+    while (start < length && digits[start] == '0') {
+        start++;
+    }
+    if (length - start > Digits) {
+        throw std::overflow_error("Number exceeds the fixed width");
+    }
+
+    // Read 18 digits per limb from the least significant end, as two independent 9-digit halves
+    std::size_t end = length;
+    for (int limb = 0; end > start; limb++) {
+        std::size_t first = end - start > static_cast<std::size_t>(LIMB_DIGITS) ? end - LIMB_DIGITS : start;
+        std::size_t middle = end - first > 9 ? end - 9 : first;
+        limbs[limb] = parseDigits(digits + first, middle - first) * 1000000000ULL + parseDigits(digits + middle, end - middle);
+        end = first;
+    }
+    negative = isNegative && !isZero();
+}
+
+// Constructor from a LargeNumber; throws overflow_error if it has more than Digits digits
+template <std::size_t Digits>
+FixedLargeNumber<Digits>::FixedLargeNumber(const LargeNumber& number) : limbs{}, negative(number.isNegative()) {
+    std::vector<uint32_t> words = number.toWords();
+    if (words.size() > static_cast<std::size_t>(LIMBS) * 2) {
+        throw std::overflow_error("Number exceeds the fixed width");
+    }
+    for (std::size_t i = 0; i < words.size(); i += 2) {
+        uint64_t high = i + 1 < words.size() ? words[i + 1] : 0;
+        limbs[i / 2] = high * 1000000000ULL + words[i];
+    }
+    if (limbs[LIMBS - 1] >= topLimit()) {
+        throw std::overflow_error("Number exceeds the fixed width");
+    }
+}
+
+// Overloaded addition (+) operator
+template <std::size_t Digits>
+constexpr FixedLargeNumber<Digits> FixedLargeNumber<Digits>::operator+(const FixedLargeNumber& other) const {
+    FixedLargeNumber result(*this);
+    result.combine(other, other.negative);
+    return result;
+}
+
+// Overloaded subtraction (-) operator
+template <std::size_t Digits>
+constexpr FixedLargeNumber<Digits> FixedLargeNumber<Digits>::operator-(const FixedLargeNumber& other) const {
+    FixedLargeNumber result(*this);
+    result.combine(other, !other.negative);
+    return result;
+}
+
+// Overloaded compound addition (+=) operator
+template <std::size_t Digits>
+constexpr FixedLargeNumber<Digits>& FixedLargeNumber<Digits>::operator+=(const FixedLargeNumber& other) {
+    combine(other, other.negative);
+    return *this;
+}
+
+// Overloaded compound subtraction (-=) operator
+template <std::size_t Digits>
+constexpr FixedLargeNumber<Digits>& FixedLargeNumber<Digits>::operator-=(const FixedLargeNumber& other) {
+    combine(other, !other.negative);
+    return *this;
+}
+
+// Compare magnitudes from the most significant limb
+template <std::size_t Digits>
+constexpr int FixedLargeNumber<Digits>::compareMagnitude(const FixedLargeNumber& other) const {
+    for (int i = LIMBS - 1; i >= 0; i--) {
+        if (limbs[i] != other.limbs[i]) {
+            return limbs[i] < other.limbs[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+// Format as comma-separated 3-digit groups
+template <std::size_t Digits>
+std::string FixedLargeNumber<Digits>::toString() const {
+    int top = LIMBS - 1;
+    while (top > 0 && limbs[top] == 0) {
+        top--;
+    }
+    std::string digits = std::to_string(limbs[top]);
+    for (int i = top - 1; i >= 0; i--) {
+        std::string limb = std::to_string(limbs[i]);
+        digits.append(LIMB_DIGITS - limb.size(), '0');
+        digits += limb;
+    }
+
+    std::string text = negative ? "-" : "";
+    std::size_t lead = digits.size() % 3 == 0 ? 3 : digits.size() % 3;
+    text.append(digits, 0, lead);
+    for (std::size_t i = lead; i < digits.size(); i += 3) {
+        text += ',';
+        text.append(digits, i, 3);
+    }
+    return text;
+}
+
+// Convert to a LargeNumber through base 10^9 words
+template <std::size_t Digits>
+LargeNumber FixedLargeNumber<Digits>::toLargeNumber() const {
+    std::vector<uint32_t> words(static_cast<std::size_t>(LIMBS) * 2);
+    for (int i = 0; i < LIMBS; i++) {
+        words[2 * i] = static_cast<uint32_t>(limbs[i] % 1000000000ULL);
+        words[2 * i + 1] = static_cast<uint32_t>(limbs[i] / 1000000000ULL);
+    }
+    while (!words.empty() && words.back() == 0) {
+        words.pop_back();
+    }
+    return LargeNumber::fromWords(words, negative);
+}
+
+// Check for zero
+template <std::size_t Digits>
+constexpr bool FixedLargeNumber<Digits>::isZero() const {
+    for (int i = 0; i < LIMBS; i++) {
+        if (limbs[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Smallest top limb that needs more than Digits digits
+template <std::size_t Digits>
+constexpr uint64_t FixedLargeNumber<Digits>::topLimit() {
+    uint64_t limit = 1;
+    for (std::size_t i = static_cast<std::size_t>(LIMB_DIGITS) * (LIMBS - 1); i < Digits; i++) {
+        limit *= 10;
+    }
+    return limit;
+}
+
+// Convert a run of at most 18 ASCII digits; throws invalid_argument for any other character
+template <std::size_t Digits>
+constexpr uint64_t FixedLargeNumber<Digits>::parseDigits(const char* digits, std::size_t length) {
+    uint64_t value = 0;
+    for (std::size_t i = 0; i < length; i++) {
+        unsigned digit = static_cast<unsigned char>(digits[i]) - '0';
+        if (digit > 9) {
+            throw std::invalid_argument("Invalid digit in number");
+        }
+        value = value * 10 + digit;
+    }
+    return value;
+}
+
+// Compare signed values: negative, zero, or positive
+template <std::size_t Digits>
+constexpr int FixedLargeNumber<Digits>::compare(const FixedLargeNumber& other) const {
+    if (negative != other.negative) {
+        return negative ? -1 : 1;
+    }
+    int order = compareMagnitude(other);
+    return negative ? -order : order;
+}
+
+// Add another value, given the sign to use for it, into this one
+template <std::size_t Digits>
+constexpr void FixedLargeNumber<Digits>::combine(const FixedLargeNumber& other, bool otherNegative) {
+
+    // Same signs add magnitudes; mixed signs subtract the smaller magnitude
+    if (negative == otherNegative) {
+        addMagnitude(other);
+    }
+    else if (compareMagnitude(other) >= 0) {
+        subtractMagnitude(other, false);
+    }
+    else {
+        subtractMagnitude(other, true);
+        negative = otherNegative;
+    }
+    if (negative && isZero()) {
+        negative = false;
+    }
+}
+
+// Add a magnitude limb by limb (other may be this number itself)
+template <std::size_t Digits>
+constexpr void FixedLargeNumber<Digits>::addMagnitude(const FixedLargeNumber& other) {
+    uint64_t carry = 0;
+    for (int i = 0; i < LIMBS; i++) {
+        uint64_t sum = limbs[i] + other.limbs[i] + carry;
+        carry = sum >= LIMB_BASE ? 1 : 0;
+        limbs[i] = carry ? sum - LIMB_BASE : sum;
+    }
+    if (carry || limbs[LIMBS - 1] >= topLimit()) {
+        throw std::overflow_error("Result exceeds the fixed width");
+    }
+}
+
+// Subtract a smaller magnitude: this - other, or other - this when reversed
+template <std::size_t Digits>
+constexpr void FixedLargeNumber<Digits>::subtractMagnitude(const FixedLargeNumber& other, bool reversed) {
+    uint64_t borrow = 0;
+    for (int i = 0; i < LIMBS; i++) {
+        uint64_t larger = reversed ? other.limbs[i] : limbs[i];
+        uint64_t smaller = (reversed ? limbs[i] : other.limbs[i]) + borrow;
+        borrow = larger < smaller ? 1 : 0;
+        limbs[i] = borrow ? larger + LIMB_BASE - smaller : larger - smaller;
+    }
+}
+
+#endif // FIXED_LARGE_NUMBER_H
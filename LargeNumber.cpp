@@ -6,166 +6,925 @@
     defined in LargeNumber.h. It includes the implementation
     of arithmetic operations, constructors, and helper functions
     for handling large numbers using a doubly linked list structure.
-    It requires LargeNumber.h, <algorithm>, <iomanip>, and <stdexcept> to run.
+    It requires LargeNumber.h, BlockIndex.h, Combinatorics.h, Division.h,
+    LargeNumberStats.h, LimbKernels.h, MappedFile.h,
+    ModularContext.h, Multiplication.h, NodePool.h, ThreadPool.h,
+    <algorithm>, <atomic>, <cctype>, <cerrno>, <cstring>,
+    <stdexcept>, and the file descriptor headers (<fcntl.h> and <unistd.h>, or
+    <io.h> on Windows) to run.
 -------------------------------------------------- */
 
 #include "LargeNumber.h"
-#include <algorithm> // For element ranges (all_of())
-#include <iomanip> // For formatting (setw() and setfill())
-#include <stdexcept> // For exceptions (out_of_range)
+#include "BlockIndex.h"
+#include "Combinatorics.h"
+#include "Division.h"
+#include "LargeNumberStats.h"
+#include "LimbKernels.h"
+#include "MappedFile.h"
+#include "ModularContext.h"
+#include "Multiplication.h"
+#include "NodePool.h"
+#include "ThreadPool.h"
+#include <algorithm> // For element ranges (min(), fill(), swap(), and upper_bound())
+#include <atomic> // For flags shared between segments (atomic)
+#include <cctype> // For blank space around file digits (isspace())
+#include <cerrno> // For interrupted writes (errno)
+#include <cstring> // For block copies and digit loads (memcpy())
+#include <stdexcept> // For exceptions (out_of_range, invalid_argument, and runtime_error)
+
+#ifdef _WIN32
+#include <fcntl.h> // For file creation flags (_O_CREAT)
+#include <io.h> // For file descriptor output (_open() and _write())
+#include <sys/stat.h> // For file permissions (_S_IWRITE)
+#else
+#include <fcntl.h> // For file creation (open())
+#include <unistd.h> // For file descriptor output (write() and close())
+#endif
 
 using namespace std;
 
-// Default constructor
-LargeNumber::LargeNumber() : head(nullptr), tail(nullptr), negative(false), size(0) {}
+// Limb layout constants
+const int Node::LIMBS_PER_NODE;
+const uint64_t LargeNumber::LIMB_BASE;
+const int LargeNumber::GROUPS_PER_LIMB;
+const int LargeNumber::GROUPS_PER_NODE;
+const int LargeNumber::INLINE_LIMBS;
+const uint16_t LargeNumber::BINARY_FORMAT_VERSION;
+const size_t LargeNumber::BINARY_HEADER_BYTES;
 
-// Constructor from string
-LargeNumber::LargeNumber(const string& number) : head(nullptr), tail(nullptr), negative(false), size(0) {
-    string reversedNumber = number;
-    reverse(reversedNumber.begin(), reversedNumber.end());
+// Powers of 1000 used to address 3-digit groups inside a limb
+static const uint64_t GROUP_POWERS[7] = {
+    1ULL, 1000ULL, 1000000ULL, 1000000000ULL, 1000000000000ULL,
+    1000000000000000ULL, 1000000000000000000ULL
+};
+
+// Get a 3-digit group of a run of limbs, counting from its least significant group
+static int groupOf(const uint64_t* limbs, int index) {
+    return static_cast<int>((limbs[index / LargeNumber::GROUPS_PER_LIMB] /
+        GROUP_POWERS[index % LargeNumber::GROUPS_PER_LIMB]) % 1000);
+}
+
+// Count the groups needed to print limbs whose top limb is nonzero (or a single zero limb)
+static int countGroups(const uint64_t* limbs, int count) {
+    uint64_t top = limbs[count - 1];
+    int topGroups = 1;
+    while (topGroups < LargeNumber::GROUPS_PER_LIMB && top >= GROUP_POWERS[topGroups]) {
+        topGroups++;
+    }
+    return (count - 1) * LargeNumber::GROUPS_PER_LIMB + topGroups;
+}
+
+// Compare two magnitudes given as limbs without leading zero limbs
+static int compareLimbs(const uint64_t* a, int countA, const uint64_t* b, int countB) {
+    if (countA != countB) {
+        return countA < countB ? -1 : 1;
+    }
+    for (int i = countA - 1; i >= 0; i--) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+// Hashes a given number of limbs from the least significant end in four independent
+// lanes, so the multiplies of neighbouring limbs overlap; limbs past the count (the
+// leading zero limbs) are ignored
+struct LimbHash {
+    uint64_t lanes[4] = { 0x2545F4914F6CDD1DULL, 0x9E3779B97F4A7C15ULL, 0xBF58476D1CE4E5B9ULL, 0x94D049BB133111EBULL };
+    uint64_t limbs;
+    uint64_t used = 0;
+
+    explicit LimbHash(uint64_t limbs) : limbs(limbs) {}
 
-    // Add leading zeros to make the length a multiple of 3
-    while (reversedNumber.length() % 3 != 0) {
-        reversedNumber += '0';  
+    static void mix(uint64_t& lane, uint64_t limb) {
+        lane = (lane ^ limb) * 0x9E3779B97F4A7C15ULL;
+        lane ^= lane >> 29;
     }
 
-    for (size_t i = 0; i < reversedNumber.length(); i += 3) {
-        string chunk = reversedNumber.substr(i, 3);
-        reverse(chunk.begin(), chunk.end());
-        int value = stoi(chunk);
+    void add(const uint64_t* data, int count) {
+        int n = static_cast<int>(min<uint64_t>(static_cast<uint64_t>(count), limbs - used));
+        int i = 0;
+        for (; i < n && (used + i) % 4 != 0; i++) {
+            mix(lanes[(used + i) % 4], data[i]);
+        }
+        uint64_t lane0 = lanes[0], lane1 = lanes[1], lane2 = lanes[2], lane3 = lanes[3];
+        for (; i + 4 <= n; i += 4) {
+            mix(lane0, data[i]);
+            mix(lane1, data[i + 1]);
+            mix(lane2, data[i + 2]);
+            mix(lane3, data[i + 3]);
+        }
+        lanes[0] = lane0;
+        lanes[1] = lane1;
+        lanes[2] = lane2;
+        lanes[3] = lane3;
+        for (; i < n; i++) {
+            mix(lanes[(used + i) % 4], data[i]);
+        }
+        used += n;
+    }
 
-        // Only add non-zero nodes
-        if (value != 0 || size > 0) {
-            addNodeFront(value);
+    // Fold the lanes, the length, and the sign (zero has none) together, then spread the bits
+    uint64_t finish(bool negative) const {
+        uint64_t result = limbs * 2 + (negative && limbs > 0 ? 1 : 0);
+        for (uint64_t lane : lanes) {
+            result = (result ^ lane) * 0xFF51AFD7ED558CCDULL;
+            result ^= result >> 33;
         }
+        result *= 0xC4CEB9FE1A85EC53ULL;
+        return result ^ (result >> 33);
     }
+};
 
-    // Add node to front if input was zero
-    if (size == 0) {
-        addNodeFront(0);
+// Reads limbs from the least significant end, one contiguous run at a time
+struct LargeNumber::LimbCursor {
+    const Node* node;
+    int index;
+
+    explicit LimbCursor(const Node* start) : node(start), index(0) {}
+    bool done() const { return node == nullptr; }
+    int remaining() const { return node->count - index; }
+    const uint64_t* data() const { return node->limbs + index; }
+
+    void advance(int count) {
+        index += count;
+        if (index == node->count) {
+            node = node->prev;
+            index = 0;
+        }
+    }
+};
+
+// Appends full limbs above the head limb of a LargeNumber, growing it toward the head
+// (every limb already present must hold six groups)
+class LargeNumber::LimbWriter {
+public:
+    explicit LimbWriter(LargeNumber& target) : number(target), node(target.head) {}
+
+    // Get room in the current head block, starting a new block when full
+    uint64_t* reserve(int& room) {
+        if (!node || node->count == Node::LIMBS_PER_NODE) {
+            node = number.addNodeFront();
+        }
+        room = Node::LIMBS_PER_NODE - node->count;
+        return node->limbs + node->count;
+    }
+
+    // Record limbs written into reserved room
+    void commit(int written) {
+        number.index.invalidate();
+        node->count += written;
+        node->groups += written * GROUPS_PER_LIMB;
+        number.size += written * GROUPS_PER_LIMB;
+    }
+
+    void push(uint64_t limb) {
+        int room;
+        *reserve(room) = limb;
+        commit(1);
+    }
+
+    // Add count limbs whose values the caller fills in afterward
+    void extend(size_t count) {
+        while (count > 0) {
+            int room;
+            reserve(room);
+            int written = static_cast<int>(min(count, static_cast<size_t>(room)));
+            commit(written);
+            count -= static_cast<size_t>(written);
+        }
+    }
+
+private:
+    LargeNumber& number;
+    Node* node;
+};
+
+// Two-digit strings "00" through "99" for rendering limbs
+static const char DIGIT_PAIRS[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Convert a run of ASCII digits, returning false if any character is not a digit
+static bool parseDigits(const char* text, size_t length, uint64_t& value) {
+    value = 0;
+    for (size_t i = 0; i < length; i++) {
+        unsigned digit = static_cast<unsigned char>(text[i]) - '0';
+        if (digit > 9) {
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+    return true;
+}
+
+// Convert eight ASCII digits with one 64-bit load and three multiplies
+static bool parseEightDigits(const char* text, uint64_t& value) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return parseDigits(text, 8, value);
+#else
+    uint64_t chunk;
+    memcpy(&chunk, text, sizeof(chunk));
+    if ((chunk & 0xF0F0F0F0F0F0F0F0ULL) != 0x3030303030303030ULL ||
+        ((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) != 0x3030303030303030ULL) {
+        return false;
+    }
+    chunk -= 0x3030303030303030ULL;
+    chunk = chunk * 10 + (chunk >> 8);
+    chunk = ((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)) +
+        ((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))) >> 32;
+    value = chunk;
+    return true;
+#endif
+}
+
+// Convert the 18 digits of one full limb
+static bool parseLimb(const char* text, uint64_t& limb) {
+    uint64_t high, middle, low;
+    if (!parseEightDigits(text, high) || !parseEightDigits(text + 8, middle) || !parseDigits(text + 16, 2, low)) {
+        return false;
+    }
+    limb = high * 10000000000ULL + middle * 100 + low;
+    return true;
+}
+
+// Render a value below 10^9 as exactly nine digits
+static void renderNine(uint32_t value, char* digits) {
+    for (int i = 7; i >= 1; i -= 2) {
+        memcpy(digits + i, DIGIT_PAIRS + 2 * (value % 100), 2);
+        value /= 100;
+    }
+    digits[0] = static_cast<char>('0' + value);
+}
+
+// Render a limb as exactly 18 digits
+static void renderLimb(uint64_t limb, char* digits) {
+    renderNine(static_cast<uint32_t>(limb / 1000000000ULL), digits);
+    renderNine(static_cast<uint32_t>(limb % 1000000000ULL), digits + 9);
+}
+
+// Smallest run of limbs worth handing to another thread
+static const size_t MIN_SEGMENT_LIMBS = 2048;
+
+// Blocks of a list indexed by limb position from the least significant end
+struct LimbIndex {
+    vector<Node*> nodes;
+    vector<size_t> starts;
+    size_t total;
+
+    explicit LimbIndex(Node* tail) : total(0) {
+        for (Node* node = tail; node; node = node->prev) {
+            nodes.push_back(node);
+            starts.push_back(total);
+            total += static_cast<size_t>(node->count);
+        }
+    }
+
+    // Block holding a limb position and the position's index inside it (nullptr past the end)
+    Node* locate(size_t position, int& index) const {
+        index = 0;
+        if (position >= total) {
+            return nullptr;
+        }
+        size_t block = static_cast<size_t>(upper_bound(starts.begin(), starts.end(), position) - starts.begin()) - 1;
+        index = static_cast<int>(position - starts[block]);
+        return nodes[block];
+    }
+};
+
+// Move a limb position forward, continuing into the next more significant block
+static Node* stepBlock(Node* node, int& index, int run) {
+    index += run;
+    if (index == node->count) {
+        index = 0;
+        return node->prev;
+    }
+    return node;
+}
+
+// Segments to split this many limbs into: a few per thread, none shorter than MIN_SEGMENT_LIMBS
+static size_t segmentCount(size_t limbs) {
+    size_t threads = ThreadPool::shared().getThreadCount();
+    return max<size_t>(1, min(threads * 4, limbs / MIN_SEGMENT_LIMBS));
+}
+
+// Combine limbs [start, end) of two magnitudes into out with no incoming carry,
+// returning the carry or borrow out of the range (a is at least as long as b)
+static uint64_t combineSegment(const LimbIndex& a, const LimbIndex& b, const LimbIndex& out,
+    size_t start, size_t end, bool subtract) {
+    int ia, ib, io;
+    Node* na = a.locate(start, ia);
+    Node* nb = b.locate(start, ib);
+    Node* no = out.locate(start, io);
+    uint64_t carry = 0;
+    for (size_t position = start; position < end;) {
+        int run = static_cast<int>(min(end - position, static_cast<size_t>(min(na->count - ia, no->count - io))));
+        if (nb) {
+            run = min(run, nb->count - ib);
+            carry = subtract ? LimbKernels::subtract(no->limbs + io, na->limbs + ia, nb->limbs + ib, run, carry)
+                : LimbKernels::add(no->limbs + io, na->limbs + ia, nb->limbs + ib, run, carry);
+            nb = stepBlock(nb, ib, run);
+        }
+        else {
+            carry = subtract ? LimbKernels::subtractBorrow(no->limbs + io, na->limbs + ia, run, carry)
+                : LimbKernels::addCarry(no->limbs + io, na->limbs + ia, run, carry);
+        }
+        na = stepBlock(na, ia, run);
+        no = stepBlock(no, io, run);
+        position += run;
+    }
+    return carry;
+}
+
+// True when every limb of [start, end) holds value
+static bool rangeEquals(const LimbIndex& limbs, size_t start, size_t end, uint64_t value) {
+    int index;
+    Node* node = limbs.locate(start, index);
+    for (size_t position = start; position < end; position++) {
+        if (node->limbs[index] != value) {
+            return false;
+        }
+        node = stepBlock(node, index, 1);
+    }
+    return true;
+}
+
+// Push an incoming carry or borrow into limbs [start, end) until it dies out
+static void applyCarry(const LimbIndex& limbs, size_t start, size_t end, bool subtract) {
+    int index;
+    Node* node = limbs.locate(start, index);
+    uint64_t carry = 1;
+    for (size_t position = start; carry && position < end;) {
+        int run = static_cast<int>(min(end - position, static_cast<size_t>(node->count - index)));
+        uint64_t* values = node->limbs + index;
+        carry = subtract ? LimbKernels::subtractBorrow(values, values, run, carry)
+            : LimbKernels::addCarry(values, values, run, carry);
+        node = stepBlock(node, index, run);
+        position += run;
+    }
+}
+
+// Add or subtract two magnitudes into out segment by segment on the shared pool,
+// returning the carry or borrow out of the top limb (out may be a itself); segments start
+// with no incoming carry, and a short lookahead over their carries then decides which
+// ones need a carry or borrow applied
+static uint64_t combineInParallel(const LimbIndex& a, const LimbIndex& b, const LimbIndex& out, bool subtract) {
+    ThreadPool& pool = ThreadPool::shared();
+    size_t segments = segmentCount(a.total);
+    size_t length = (a.total + segments - 1) / segments;
+    vector<uint64_t> carries(segments);
+    vector<char> passes(segments);
+    uint64_t saturated = subtract ? 0 : LargeNumber::LIMB_BASE - 1;
+    pool.parallelFor(segments, [&](size_t k) {
+        size_t start = min(a.total, k * length);
+        size_t end = min(a.total, start + length);
+        carries[k] = combineSegment(a, b, out, start, end, subtract);
+        passes[k] = carries[k] == 0 && rangeEquals(out, start, end, saturated);
+    });
+
+    // Carry lookahead: a segment passes an incoming carry on only when every limb is saturated
+    vector<char> incoming(segments);
+    uint64_t carry = 0;
+    for (size_t k = 0; k < segments; k++) {
+        incoming[k] = carry != 0;
+        carry = carries[k] | (passes[k] ? carry : 0);
+    }
+    pool.parallelFor(segments, [&](size_t k) {
+        if (incoming[k]) {
+            size_t start = min(a.total, k * length);
+            applyCarry(out, start, min(a.total, start + length), subtract);
+        }
+    });
+    return carry;
+}
+
+// Add a small signed carry into a run of limbs, stopping once it is absorbed,
+// and return the carry out of the top
+static int64_t carryIntoRun(uint64_t* limbs, int count, int64_t carry) {
+    const int64_t base = static_cast<int64_t>(LargeNumber::LIMB_BASE);
+    for (int i = 0; carry != 0 && i < count; i++) {
+        int64_t value = static_cast<int64_t>(limbs[i]) + carry;
+        carry = 0;
+        if (value < 0) {
+            value += base;
+            carry = -1;
+        }
+        else if (value >= base) {
+            value -= base;
+            carry = 1;
+        }
+        limbs[i] = static_cast<uint64_t>(value);
+    }
+    return carry;
+}
+
+// Replace a run of limbs with their negation modulo a power of the base, returning the borrow
+static uint64_t negateRun(uint64_t* limbs, int count, uint64_t borrow) {
+    for (int i = 0; i < count; i++) {
+        uint64_t value = limbs[i] + borrow;
+        borrow = value != 0 ? 1 : 0;
+        limbs[i] = borrow ? LargeNumber::LIMB_BASE - value : 0;
+    }
+    return borrow;
+}
+
+// Digits gathered before each write to a file descriptor
+static const size_t WRITE_CHUNK_BYTES = 1 << 16;
+
+// Write a whole buffer to a file descriptor, retrying short and interrupted writes
+static void writeAll(int fileDescriptor, const char* data, size_t length) {
+    while (length > 0) {
+#ifdef _WIN32
+        int written = _write(fileDescriptor, data, static_cast<unsigned int>(min<size_t>(length, 1 << 30)));
+#else
+        ssize_t written = write(fileDescriptor, data, length);
+#endif
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw runtime_error(string("Could not write digits: ") + strerror(errno));
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+}
+
+// Open a file for writing, creating or truncating it
+static int createFile(const string& path) {
+#ifdef _WIN32
+    int fileDescriptor = _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    int fileDescriptor = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    if (fileDescriptor < 0) {
+        throw runtime_error("Could not open " + path);
+    }
+    return fileDescriptor;
+}
+
+// Close a file descriptor, returning nonzero if the last writes failed
+static int closeFile(int fileDescriptor) {
+#ifdef _WIN32
+    return _close(fileDescriptor);
+#else
+    return close(fileDescriptor);
+#endif
+}
+
+// Magic bytes opening every binary record
+static const char BINARY_MAGIC[4] = { 'L', 'N', 'U', 'M' };
+static const uint8_t BINARY_NEGATIVE = 1;
+
+// Store the low bytes of a value in little-endian order
+static void storeLittleEndian(uint64_t value, char* bytes, int count) {
+    for (int i = 0; i < count; i++) {
+        bytes[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+// Read a little-endian value of count bytes
+static uint64_t loadLittleEndian(const char* bytes, int count) {
+    uint64_t value = 0;
+    for (int i = count - 1; i >= 0; i--) {
+        value = (value << 8) | static_cast<unsigned char>(bytes[i]);
+    }
+    return value;
+}
+
+// Copy limbs out as little-endian bytes, a plain block copy on little-endian machines
+static void limbsToBytes(const uint64_t* limbs, size_t count, char* bytes) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    for (size_t i = 0; i < count; i++) {
+        storeLittleEndian(limbs[i], bytes + 8 * i, 8);
+    }
+#else
+    memcpy(bytes, limbs, count * sizeof(uint64_t));
+#endif
+}
+
+// Copy little-endian bytes into limbs, returning false if any limb is not below LIMB_BASE
+static bool bytesToLimbs(const char* bytes, size_t count, uint64_t* limbs) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    for (size_t i = 0; i < count; i++) {
+        limbs[i] = loadLittleEndian(bytes + 8 * i, 8);
+    }
+#else
+    memcpy(limbs, bytes, count * sizeof(uint64_t));
+#endif
+    uint64_t largest = 0;
+    for (size_t i = 0; i < count; i++) {
+        largest = max(largest, limbs[i]);
+    }
+    return largest < LargeNumber::LIMB_BASE;
+}
+
+// Render a run of limbs holding groups 3-digit groups into ",ddd" slots, where the
+// top group is group number groupIndex counted from the most significant
+static void renderLimbs(const uint64_t* limbs, int count, int groups, size_t& groupIndex, char* groupSlots) {
+    char digits[18];
+    for (int i = count - 1; i >= 0; i--) {
+        int groupsInLimb = min(LargeNumber::GROUPS_PER_LIMB, groups - i * LargeNumber::GROUPS_PER_LIMB);
+        renderLimb(limbs[i], digits);
+        const char* group = digits + 18 - 3 * groupsInLimb;
+        for (int j = 0; j < groupsInLimb; j++, group += 3, groupIndex++) {
+
+            // The first group is printed separately without leading zeros
+            if (groupIndex > 0) {
+                memcpy(groupSlots + 4 * (groupIndex - 1) + 1, group, 3);
+            }
+        }
+    }
+}
+
+// Render whole blocks from node toward the tail into ",ddd" slots
+static void renderBlocks(const Node* node, size_t blocks, size_t groupIndex, char* groupSlots) {
+    for (; blocks > 0; blocks--, node = node->next) {
+        renderLimbs(node->limbs, node->count, node->groups, groupIndex, groupSlots);
     }
 }
 
+// Owner count of blocks shared between copies
+struct LargeNumber::BlockShare {
+    atomic<int> owners{ 1 };
+};
+
+// Default constructor
+LargeNumber::LargeNumber() : head(nullptr), tail(nullptr), negative(false), size(0), nodeCount(0), aligned(true), inlineCount(0) {}
+
+// Constructor from string
+LargeNumber::LargeNumber(const string& number) : head(nullptr), tail(nullptr), negative(false), size(0), nodeCount(0), aligned(true), inlineCount(0) {
+    parse(number.data(), number.length());
+}
+
+// Constructor from a digit buffer, parsed in place without copying
+LargeNumber::LargeNumber(const char* digits, size_t length) : head(nullptr), tail(nullptr), negative(false), size(0), nodeCount(0), aligned(true), inlineCount(0) {
+    parse(digits, length);
+}
+
 // Virtual destructor
 LargeNumber::~LargeNumber() {
     clear();
 }
 
-// Copy constructor
-LargeNumber::LargeNumber(const LargeNumber& other) : head(nullptr), tail(nullptr), negative(other.negative), size(0) {
-    copyFrom(other);
+// Copy constructor, sharing the other number's blocks
+LargeNumber::LargeNumber(const LargeNumber& other) : head(nullptr), tail(nullptr), negative(other.negative), size(0), nodeCount(0), aligned(true), inlineCount(0) {
+    shareFrom(other);
+}
+
+// Move constructor
+LargeNumber::LargeNumber(LargeNumber&& other) noexcept : head(nullptr), tail(nullptr), negative(other.negative), size(0), nodeCount(0), aligned(true), inlineCount(0) {
+    takeNodesFrom(other);
+    other.negative = false;
 }
 
-// Overloaded assignment (=) operator
+// Overloaded assignment (=) operator, sharing the other number's blocks
 LargeNumber& LargeNumber::operator=(const LargeNumber& other) {
     if (this != &other) {
-        clear();
         negative = other.negative;
-        size = 0;
-        copyFrom(other);
+        shareFrom(other);
+    }
+    return *this;
+}
+
+// Overloaded move assignment (=) operator
+LargeNumber& LargeNumber::operator=(LargeNumber&& other) noexcept {
+    if (this != &other) {
+        negative = other.negative;
+        takeNodesFrom(other);
+        other.negative = false;
     }
     return *this;
 }
 
 // Overloaded addition (+) operator
 LargeNumber LargeNumber::operator+(const LargeNumber& other) const {
+    LARGE_NUMBER_STATS_TIME(LargeNumberOperation::Add, (max(size, other.size) + 5) / 6);
     LargeNumber result;
-    const Node* n1 = this->tail;
-    const Node* n2 = other.tail;
-    int carry = 0;
+    if (inlineCount > 0 && other.inlineCount > 0) {
+        result.combineInline(*this, other, other.negative);
+        return result;
+    }
 
-    while (n1 || n2 || carry) {
-        int sum = carry;
-        if (n1) {
-            sum += n1->value;
-            n1 = n1->prev;
-        }
-        if (n2) {
-            sum += n2->value;
-            n2 = n2->prev;
-        }
-        result.addNodeFront(sum % 1000);
-        carry = sum / 1000;
+    LargeNumber scratchA, scratchB;
+    const LargeNumber& a = alignedView(*this, scratchA);
+    const LargeNumber& b = alignedView(other, scratchB);
+
+    // Same signs add magnitudes; mixed signs subtract the smaller magnitude
+    if (a.negative == b.negative) {
+        addMagnitudes(a, b, result);
+        result.negative = a.negative;
+    }
+    else if (a.compare(b) >= 0) {
+        subtractMagnitudes(a, b, result);
+        result.negative = a.negative;
+    }
+    else {
+        subtractMagnitudes(b, a, result);
+        result.negative = b.negative;
     }
 
+    result.normalize();
     return result;
 }
 
 // Overloaded subtraction (-) operator
 LargeNumber LargeNumber::operator-(const LargeNumber& other) const {
+    LARGE_NUMBER_STATS_TIME(LargeNumberOperation::Subtract, (max(size, other.size) + 5) / 6);
     LargeNumber result;
-    const Node* n1 = this->tail;
-    const Node* n2 = other.tail;
-    int borrow = 0;
-    bool isNegative = false;
+    if (inlineCount > 0 && other.inlineCount > 0) {
+        result.combineInline(*this, other, !other.negative);
+        return result;
+    }
 
-    if (compare(other) < 0) {
-        isNegative = true;
-        swap(n1, n2);
+    LargeNumber scratchA, scratchB;
+    const LargeNumber& a = alignedView(*this, scratchA);
+    const LargeNumber& b = alignedView(other, scratchB);
+
+    // Mixed signs add magnitudes; same signs subtract the smaller magnitude
+    if (a.negative != b.negative) {
+        addMagnitudes(a, b, result);
+        result.negative = a.negative;
+    }
+    else if (a.compare(b) >= 0) {
+        subtractMagnitudes(a, b, result);
+        result.negative = a.negative;
+    }
+    else {
+        subtractMagnitudes(b, a, result);
+        result.negative = !a.negative;
     }
 
-    while (n1 || n2) {
-        int diff = -borrow;
-        if (n1) {
-            diff += n1->value;
-            n1 = n1->prev;
-        }
-        if (n2) {
-            diff -= n2->value;
-            n2 = n2->prev;
-        }
+    result.normalize();
+    return result;
+}
+
+// Overloaded compound addition (+=) operator
+LargeNumber& LargeNumber::operator+=(const LargeNumber& other) {
+    accumulate(other, false);
+    return *this;
+}
+
+// Overloaded compound subtraction (-=) operator
+LargeNumber& LargeNumber::operator-=(const LargeNumber& other) {
+    accumulate(other, true);
+    return *this;
+}
+
+// Overloaded multiplication (*) operator, through base 10^9 words
+LargeNumber LargeNumber::operator*(const LargeNumber& other) const {
+    vector<uint32_t> product;
+    Multiplication::multiply(toWords(), other.toWords(), product);
+    return fromWords(product, negative != other.negative);
+}
+
+// Overloaded compound multiplication (*=) operator
+LargeNumber& LargeNumber::operator*=(const LargeNumber& other) {
+    *this = *this * other;
+    return *this;
+}
+
+// Overloaded division (/) operator
+LargeNumber LargeNumber::operator/(const LargeNumber& other) const {
+    LargeNumber quotient, remainder;
+    divmod(*this, other, quotient, remainder);
+    return quotient;
+}
+
+// Overloaded modulo (%) operator
+LargeNumber LargeNumber::operator%(const LargeNumber& other) const {
+    LargeNumber quotient, remainder;
+    divmod(*this, other, quotient, remainder);
+    return remainder;
+}
+
+// Overloaded compound division (/=) operator
+LargeNumber& LargeNumber::operator/=(const LargeNumber& other) {
+    *this = *this / other;
+    return *this;
+}
+
+// Overloaded compound modulo (%=) operator
+LargeNumber& LargeNumber::operator%=(const LargeNumber& other) {
+    *this = *this % other;
+    return *this;
+}
+
+// Sum signed operands run by run: each operand is added into or subtracted from the result
+// with its own carry, so every run of the result is finished while it is still in cache
+LargeNumber LargeNumber::sum(const vector<SumTerm>& terms) {
+    LargeNumber result;
 
-        if (diff < 0) {
-            diff += 1000;
-            borrow = 1;
+    // Small operands are summed on the stack
+    bool allInline = true;
+    for (const SumTerm& term : terms) {
+        allInline = allInline && term.number->inlineCount > 0;
+    }
+    if (allInline) {
+        uint64_t low[INLINE_LIMBS + 1] = {};
+        int64_t carry = 0;
+        for (const SumTerm& term : terms) {
+            const LargeNumber& number = *term.number;
+            int count = number.inlineCount;
+            if (term.subtract != number.negative) {
+                uint64_t borrow = LimbKernels::subtract(low, low, number.inlineLimbs, count, 0);
+                carry += carryIntoRun(low + count, INLINE_LIMBS - count, -static_cast<int64_t>(borrow));
+            }
+            else {
+                uint64_t out = LimbKernels::add(low, low, number.inlineLimbs, count, 0);
+                carry += carryIntoRun(low + count, INLINE_LIMBS - count, static_cast<int64_t>(out));
+            }
+        }
+        if (carry < 0) {
+            low[INLINE_LIMBS] = static_cast<uint64_t>(-carry) - negateRun(low, INLINE_LIMBS, 0);
+            result.negative = true;
         }
         else {
-            borrow = 0;
+            low[INLINE_LIMBS] = static_cast<uint64_t>(carry);
         }
+        result.storeLimbs(low, INLINE_LIMBS + 1);
+        return result;
+    }
 
-        result.addNodeFront(diff);
+    // Walk every operand's aligned limbs together from the least significant end
+    vector<LargeNumber> scratch(terms.size());
+    vector<LimbCursor> cursors;
+    vector<char> subtracts;
+    vector<uint64_t> carries(terms.size(), 0);
+    size_t limbs = 0;
+    cursors.reserve(terms.size());
+    for (size_t i = 0; i < terms.size(); i++) {
+        const LargeNumber& view = alignedView(*terms[i].number, scratch[i]);
+        size_t count = 0;
+        for (const Node* node = view.head; node; node = node->next) {
+            count += static_cast<size_t>(node->count);
+        }
+        limbs = max(limbs, count);
+        cursors.emplace_back(view.tail);
+        subtracts.push_back(terms[i].subtract != view.negative);
     }
 
-    while (result.head && result.head != result.tail && result.head->value == 0) {
-        Node* temp = result.head;
-        result.head = result.head->next;
-        result.head->prev = nullptr;
-        delete temp;
-        result.size--;
+    // Carries left by operands that have ended, still to be added at the current position
+    LimbWriter out(result);
+    int64_t carry = 0;
+    for (size_t position = 0; position < limbs;) {
+        int room;
+        uint64_t* dest = out.reserve(room);
+        int run = static_cast<int>(min(limbs - position, static_cast<size_t>(room)));
+        for (const LimbCursor& cursor : cursors) {
+            if (!cursor.done()) {
+                run = min(run, cursor.remaining());
+            }
+        }
+
+        // The first added operand is copied in rather than added to zeros
+        bool started = false;
+        int64_t ended = 0;
+        for (size_t i = 0; i < cursors.size(); i++) {
+            if (cursors[i].done()) {
+                continue;
+            }
+            const uint64_t* data = cursors[i].data();
+            if (!started && !subtracts[i]) {
+                carries[i] = LimbKernels::addCarry(dest, data, run, carries[i]);
+            }
+            else {
+                if (!started) {
+                    fill(dest, dest + run, 0);
+                }
+                carries[i] = subtracts[i] ? LimbKernels::subtract(dest, dest, data, run, carries[i])
+                    : LimbKernels::add(dest, dest, data, run, carries[i]);
+            }
+            started = true;
+            cursors[i].advance(run);
+            if (cursors[i].done()) {
+                ended += subtracts[i] ? -static_cast<int64_t>(carries[i]) : static_cast<int64_t>(carries[i]);
+            }
+        }
+        if (!started) {
+            fill(dest, dest + run, 0);
+        }
+        carry = carryIntoRun(dest, run, carry) + ended;
+        out.commit(run);
+        position += static_cast<size_t>(run);
     }
 
-    result.negative = isNegative;
+    // A negative total left its limbs as a power of the base plus the total: negate them
+    if (carry < 0) {
+        uint64_t borrow = 0;
+        for (Node* node = result.tail; node; node = node->prev) {
+            borrow = negateRun(node->limbs, node->count, borrow);
+        }
+        out.push(static_cast<uint64_t>(-carry) - borrow);
+        result.negative = true;
+    }
+    else if (carry > 0 || !result.head) {
+        out.push(static_cast<uint64_t>(carry));
+    }
+    result.normalize();
     return result;
 }
 
+// Divide with truncation toward zero through base 10^9 words; throws domain_error for a
+// zero divisor
+void LargeNumber::divmod(const LargeNumber& dividend, const LargeNumber& divisor,
+    LargeNumber& quotient, LargeNumber& remainder) {
+    vector<uint32_t> quotientWords, remainderWords;
+    Division::divide(dividend.toWords(), divisor.toWords(), quotientWords, remainderWords);
+    bool dividendNegative = dividend.negative;
+    quotient = fromWords(quotientWords, dividendNegative != divisor.negative);
+    remainder = fromWords(remainderWords, dividendNegative);
+}
+
+// Modular exponentiation through a context built for this one call
+LargeNumber LargeNumber::powmod(const LargeNumber& base, const LargeNumber& exponent, const LargeNumber& modulus) {
+    return ModularContext(modulus).pow(base, exponent);
+}
+
+// n!
+LargeNumber LargeNumber::factorial(uint64_t n) {
+    vector<uint32_t> words;
+    Combinatorics::factorial(n, words);
+    return fromWords(words);
+}
+
+// n choose k
+LargeNumber LargeNumber::binomial(uint64_t n, uint64_t k) {
+    vector<uint32_t> words;
+    Combinatorics::binomial(n, k, words);
+    return fromWords(words);
+}
+
+// The nth Fibonacci number
+LargeNumber LargeNumber::fibonacci(uint64_t n) {
+    vector<uint32_t> words;
+    Combinatorics::fibonacci(n, words);
+    return fromWords(words);
+}
+
+// base^exponent, negative for a negative base and an odd exponent
+LargeNumber LargeNumber::pow(const LargeNumber& base, uint64_t exponent) {
+    vector<uint32_t> words;
+    Combinatorics::power(base.toWords(), exponent, words);
+    return fromWords(words, base.negative && exponent % 2 == 1);
+}
+
 // Insert a node at a specific position
 void LargeNumber::insertNode(int position, int value) {
     if (position < 0 || position > size) {
         throw out_of_range("Invalid position for insertion");
     }
+    if (value < 0 || value > 999) {
+        throw out_of_range("Invalid value for node");
+    }
+    spill();
+    detach();
 
-    Node* newNode = new Node(value);
+    if (!head) {
+        Node* node = addNodeFront();
+        packGroups(node, &value, 1);
+        size = 1;
+        clearSignOfZero();
+        return;
+    }
 
-    if (position == 0) {
-        newNode->next = head;
-        if (head) head->prev = newNode;
-        head = newNode;
-        if (!tail) tail = newNode;
+    // Inserting after the last group extends the tail block
+    Node* node;
+    int offset;
+    if (position == size) {
+        node = tail;
+        offset = tail->groups;
     }
-    else if (position == size) {
-        tail->next = newNode;
-        newNode->prev = tail;
-        tail = newNode;
+    else {
+        node = getNodeAtPosition(position, offset);
+    }
+
+    int groupValues[GROUPS_PER_NODE + 1];
+    unpackGroups(node, groupValues);
+    for (int i = node->groups; i > offset; i--) {
+        groupValues[i] = groupValues[i - 1];
+    }
+    groupValues[offset] = value;
+
+    if (node->groups < GROUPS_PER_NODE) {
+        packGroups(node, groupValues, node->groups + 1);
+        if (index.isValid()) {
+            index.update(node);
+        }
     }
     else {
-        Node* current = getNodeAtPosition(position);
-        newNode->prev = current->prev;
-        newNode->next = current;
-        current->prev->next = newNode;
-        current->prev = newNode;
+        splitNode(node, groupValues, GROUPS_PER_NODE + 1);
     }
 
     size++;
+    if (node != head && node->groups % GROUPS_PER_LIMB != 0) {
+        aligned = false;
+    }
+    clearSignOfZero();
 }
 
 // Delete a node at a specific position
@@ -173,28 +932,32 @@ void LargeNumber::deleteNode(int position) {
     if (position < 0 || position >= size) {
         throw out_of_range("Invalid position for deletion");
     }
+    spill();
+    detach();
 
-    Node* nodeToDelete;
+    int offset;
+    Node* node = getNodeAtPosition(position, offset);
 
-    if (position == 0) {
-        nodeToDelete = head;
-        head = head->next;
-        if (head) head->prev = nullptr;
-        if (size == 1) tail = nullptr;
-    }
-    else if (position == size - 1) {
-        nodeToDelete = tail;
-        tail = tail->prev;
-        tail->next = nullptr;
+    if (node->groups == 1) {
+        removeNode(node);
     }
     else {
-        nodeToDelete = getNodeAtPosition(position);
-        nodeToDelete->prev->next = nodeToDelete->next;
-        nodeToDelete->next->prev = nodeToDelete->prev;
+        int groupValues[GROUPS_PER_NODE];
+        unpackGroups(node, groupValues);
+        for (int i = offset; i < node->groups - 1; i++) {
+            groupValues[i] = groupValues[i + 1];
+        }
+        packGroups(node, groupValues, node->groups - 1);
+        if (index.isValid()) {
+            index.update(node);
+        }
+        if (node != head) {
+            aligned = false;
+        }
     }
 
-    delete nodeToDelete;
     size--;
+    clearSignOfZero();
 }
 
 // Modify the value of a node at a specific position
@@ -202,128 +965,1367 @@ void LargeNumber::modifyNode(int position, int newValue) {
     if (position < 0 || position >= size) {
         throw out_of_range("Invalid position for modification");
     }
+    if (newValue < 0 || newValue > 999) {
+        throw out_of_range("Invalid value for node");
+    }
+    spill();
+    detach();
 
-    Node* node = getNodeAtPosition(position);
-    node->value = newValue;
+    int offset;
+    Node* node = getNodeAtPosition(position, offset);
+    int index = node->groups - 1 - offset;
+    uint64_t power = GROUP_POWERS[index % GROUPS_PER_LIMB];
+    uint64_t& limb = node->limbs[index / GROUPS_PER_LIMB];
+    uint64_t oldValue = (limb / power) % 1000;
+    limb = limb - oldValue * power + static_cast<uint64_t>(newValue) * power;
+    if (newValue == 0) {
+        clearSignOfZero();
+    }
 }
 
-// Overloaded output stream (<<) operator for improved printing
-ostream& operator<<(ostream& os, const LargeNumber& num) {
-    if (num.negative) {
-        os << "-";
-    }
-    Node* current = num.head;
-    bool first = true;
-    while (current) {
-        if (!first) {
-            os << ",";
-        }
+// Apply a batch of node edits, rebuilding each affected block once
+void LargeNumber::applyNodeEdits(const vector<NodeEdit>& edits) {
 
-        // Print the first node's value without leading zeros
-        if (first) {
-            os << current->value;  
+    // Check every edit before changing anything
+    for (const NodeEdit& edit : edits) {
+        int limit = edit.kind == NodeEditKind::Insert ? size : size - 1;
+        if (edit.position < 0 || edit.position > limit) {
+            throw out_of_range("Invalid position for node edit");
         }
-
-        // Print subsequent nodes with leading zeros
-        else {
-            os << setfill('0') << setw(3) << current->value;  
+        if (edit.kind != NodeEditKind::Delete && (edit.value < 0 || edit.value > 999)) {
+            throw out_of_range("Invalid value for node");
         }
-        first = false;
-        current = current->next;
     }
 
-    // Print ) if the number is zero
-    if (!num.head) {  
-        os << "0";
+    // Sort by position; inserts go in front of the group they share a position with
+    vector<NodeEdit> sorted(edits);
+    stable_sort(sorted.begin(), sorted.end(), [](const NodeEdit& a, const NodeEdit& b) {
+        if (a.position != b.position) {
+            return a.position < b.position;
+        }
+        return a.kind == NodeEditKind::Insert && b.kind != NodeEditKind::Insert;
+    });
+    for (size_t i = 1; i < sorted.size(); i++) {
+        if (sorted[i].kind != NodeEditKind::Insert && sorted[i - 1].kind != NodeEditKind::Insert
+            && sorted[i].position == sorted[i - 1].position) {
+            throw invalid_argument("Conflicting edits for one node");
+        }
+    }
+    if (sorted.empty()) {
+        return;
     }
-    return os;
-}
 
-// Add a new node to end of list
-void LargeNumber::addNode(int value) {
-    Node* newNode = new Node(value);
+    // An empty number gets an empty block to receive its inserts
+    spill();
+    detach();
     if (!head) {
-        head = tail = newNode;
+        addNodeFront();
     }
-    else {
-        tail->next = newNode;
-        newNode->prev = tail;
-        tail = newNode;
+    index.invalidate();
+
+    vector<int> original(GROUPS_PER_NODE);
+    vector<int> rebuilt;
+    size_t next = 0;
+    int first = 0;
+    int newSize = size;
+    for (Node* node = head; node && next < sorted.size();) {
+        Node* following = node->next;
+        int end = first + node->groups;
+
+        // Edits belong to the block holding their position; appends belong to the tail block
+        if (sorted[next].position < end || !following) {
+            int oldGroups = node->groups;
+            unpackGroups(node, original.data());
+            rebuilt.clear();
+            int offset = 0;
+            for (; next < sorted.size() && (sorted[next].position < end || !following); next++) {
+                const NodeEdit& edit = sorted[next];
+                int local = edit.position - first;
+                while (offset < local) {
+                    rebuilt.push_back(original[offset++]);
+                }
+                if (edit.kind != NodeEditKind::Delete) {
+                    rebuilt.push_back(edit.value);
+                }
+                if (edit.kind != NodeEditKind::Insert) {
+                    offset++;
+                }
+            }
+            while (offset < oldGroups) {
+                rebuilt.push_back(original[offset++]);
+            }
+            newSize += static_cast<int>(rebuilt.size()) - oldGroups;
+            replaceGroups(node, rebuilt.data(), static_cast<int>(rebuilt.size()));
+        }
+        first = end;
+        node = following;
     }
-    size++;
+    size = newSize;
+    aligned = false;
+    clearSignOfZero();
 }
 
-// Add a new node to front of list
-void LargeNumber::addNodeFront(int value) {
-    Node* newNode = new Node(value);
-    if (!head) {
-        head = tail = newNode;
+// Make a value that node edits have left at zero positive; only a negative value is scanned,
+// and the scan stops at its first nonzero limb
+void LargeNumber::clearSignOfZero() {
+    if (!negative) {
+        return;
     }
-    else {
-        newNode->next = head;
-        head->prev = newNode;
-        head = newNode;
+    for (int i = 0; i < inlineCount; i++) {
+        if (inlineLimbs[i] != 0) {
+            return;
+        }
     }
-    size++;
+    for (const Node* node = head; node; node = node->next) {
+        for (int i = 0; i < node->count; i++) {
+            if (node->limbs[i] != 0) {
+                return;
+            }
+        }
+    }
+    negative = false;
 }
 
-// Compare two LargeNumbers
+// Overloaded output stream (<<) operator for improved printing
+ostream& operator<<(ostream& os, const LargeNumber& num) {
+    string text = num.toString();
+    os.write(text.data(), static_cast<streamsize>(text.size()));
+    return os;
+}
+
+// Format as comma-separated 3-digit groups in one buffer
+string LargeNumber::toString() const {
+    LARGE_NUMBER_STATS_TIME(LargeNumberOperation::Print, (size + 5) / 6);
+    if (!head && inlineCount == 0) {
+        return "0";
+    }
+
+    // Only the first group drops its leading zeros, so every later group has a fixed ",ddd" slot
+    int firstGroup = inlineCount > 0 ? groupOf(inlineLimbs, size - 1) : getGroup(head, head->groups - 1);
+    size_t firstLength = firstGroup >= 100 ? 3 : (firstGroup >= 10 ? 2 : 1);
+    size_t sign = negative ? 1 : 0;
+    string text(sign + firstLength + 4 * (static_cast<size_t>(size) - 1), ',');
+    if (negative) {
+        text[0] = '-';
+    }
+    for (size_t i = firstLength; i > 0; i--, firstGroup /= 10) {
+        text[sign + i - 1] = static_cast<char>('0' + firstGroup % 10);
+    }
+    char* groupSlots = &text[0] + sign + firstLength;
+
+    // Very long numbers render runs of blocks on the shared pool
+    if (inlineCount > 0) {
+        size_t groupIndex = 0;
+        renderLimbs(inlineLimbs, inlineCount, size, groupIndex, groupSlots);
+    }
+    else if (nodeCount > 1 && ThreadPool::shouldParallelize(static_cast<size_t>(size) * 3)) {
+        vector<const Node*> nodes;
+        vector<size_t> groupStarts;
+        size_t groupIndex = 0;
+        for (const Node* current = head; current; current = current->next) {
+            nodes.push_back(current);
+            groupStarts.push_back(groupIndex);
+            groupIndex += static_cast<size_t>(current->groups);
+        }
+        size_t segments = min(nodes.size(), segmentCount(nodes.size() * Node::LIMBS_PER_NODE));
+        size_t length = (nodes.size() + segments - 1) / segments;
+        ThreadPool::shared().parallelFor(segments, [&](size_t k) {
+            size_t first = min(nodes.size(), k * length);
+            size_t blocks = min(nodes.size(), first + length) - first;
+            if (blocks > 0) {
+                renderBlocks(nodes[first], blocks, groupStarts[first], groupSlots);
+            }
+        });
+    }
+    else {
+        renderBlocks(head, static_cast<size_t>(nodeCount), 0, groupSlots);
+    }
+    return text;
+}
+
+// Load a plain digit file (optional leading minus sign, surrounding blank space ignored),
+// parsing it straight out of a read-only memory mapping
+LargeNumber LargeNumber::loadFromFile(const string& path) {
+    MappedFile file(path);
+    const char* digits = file.data();
+    size_t first = 0;
+    size_t last = file.size();
+    while (first < last && isspace(static_cast<unsigned char>(digits[first]))) {
+        first++;
+    }
+    while (last > first && isspace(static_cast<unsigned char>(digits[last - 1]))) {
+        last--;
+    }
+    return LargeNumber(digits + first, last - first);
+}
+
+// Store the plain digits followed by a newline, replacing any existing file
+void LargeNumber::saveToFile(const string& path) const {
+    int fileDescriptor = createFile(path);
+    try {
+        writeDigits(fileDescriptor);
+        writeAll(fileDescriptor, "\n", 1);
+    }
+    catch (...) {
+        closeFile(fileDescriptor);
+        throw;
+    }
+    if (closeFile(fileDescriptor) != 0) {
+        throw runtime_error("Could not finish writing " + path);
+    }
+}
+
+// Stream the plain digits (no separators) to a file descriptor one chunk at a time
+void LargeNumber::writeDigits(int fileDescriptor) const {
+    if (inlineCount > 0) {
+        LargeNumber scratch;
+        blockView(*this, scratch).writeDigits(fileDescriptor);
+        return;
+    }
+    LARGE_NUMBER_STATS_TIME(LargeNumberOperation::Print, (size + 5) / 6);
+    if (!head) {
+        writeAll(fileDescriptor, "0", 1);
+        return;
+    }
+    char chunk[WRITE_CHUNK_BYTES];
+    size_t used = 0;
+    if (negative) {
+        chunk[used++] = '-';
+    }
+    bool first = true;
+    char digits[18];
+    for (const Node* current = head; current; current = current->next) {
+        for (int i = current->count - 1; i >= 0; i--) {
+            if (used > WRITE_CHUNK_BYTES - 18) {
+                writeAll(fileDescriptor, chunk, used);
+                used = 0;
+            }
+            int groupsInLimb = min(GROUPS_PER_LIMB, current->groups - i * GROUPS_PER_LIMB);
+            renderLimb(current->limbs[i], digits);
+            int skip = 18 - 3 * groupsInLimb;
+
+            // Drop the leading zeros of the most significant limb, keeping at least one digit
+            if (first) {
+                while (skip < 17 && digits[skip] == '0') {
+                    skip++;
+                }
+                first = false;
+            }
+            memcpy(chunk + used, digits + skip, static_cast<size_t>(18 - skip));
+            used += static_cast<size_t>(18 - skip);
+        }
+    }
+    writeAll(fileDescriptor, chunk, used);
+}
+
+// Load the first binary record of a file through a memory mapping
+LargeNumber LargeNumber::loadBinary(const string& path) {
+    MappedFile file(path);
+    size_t used;
+    return fromBinary(file.data(), file.size(), used);
+}
+
+// Store one binary record, replacing any existing file
+void LargeNumber::saveBinary(const string& path) const {
+    int fileDescriptor = createFile(path);
+    try {
+        writeBinary(fileDescriptor);
+    }
+    catch (...) {
+        closeFile(fileDescriptor);
+        throw;
+    }
+    if (closeFile(fileDescriptor) != 0) {
+        throw runtime_error("Could not finish writing " + path);
+    }
+}
+
+// Stream one binary record to a file descriptor one chunk at a time
+void LargeNumber::writeBinary(int fileDescriptor) const {
+    LargeNumber scratch;
+    const LargeNumber& source = inlineCount > 0 ? *this : alignedView(*this, scratch);
+    size_t remaining = source.countBinaryLimbs();
+    char chunk[WRITE_CHUNK_BYTES];
+    source.encodeBinaryHeader(remaining, chunk);
+    size_t used = BINARY_HEADER_BYTES;
+    if (source.inlineCount > 0) {
+        limbsToBytes(source.inlineLimbs, remaining, chunk + used);
+        used += remaining * sizeof(uint64_t);
+        remaining = 0;
+    }
+    for (LimbCursor cursor(source.tail); remaining > 0; ) {
+        if (used == WRITE_CHUNK_BYTES) {
+            writeAll(fileDescriptor, chunk, used);
+            used = 0;
+        }
+        size_t run = min(min(remaining, static_cast<size_t>(cursor.remaining())), (WRITE_CHUNK_BYTES - used) / sizeof(uint64_t));
+        limbsToBytes(cursor.data(), run, chunk + used);
+        cursor.advance(static_cast<int>(run));
+        used += run * sizeof(uint64_t);
+        remaining -= run;
+    }
+    writeAll(fileDescriptor, chunk, used);
+}
+
+// Encode one binary record in memory
+string LargeNumber::toBinary() const {
+    LargeNumber scratch;
+    const LargeNumber& source = inlineCount > 0 ? *this : alignedView(*this, scratch);
+    size_t remaining = source.countBinaryLimbs();
+    string record(BINARY_HEADER_BYTES + remaining * sizeof(uint64_t), '\0');
+    char* bytes = &record[0];
+    source.encodeBinaryHeader(remaining, bytes);
+    bytes += BINARY_HEADER_BYTES;
+    if (source.inlineCount > 0) {
+        limbsToBytes(source.inlineLimbs, remaining, bytes);
+        return record;
+    }
+    for (LimbCursor cursor(source.tail); remaining > 0; ) {
+        size_t run = min(remaining, static_cast<size_t>(cursor.remaining()));
+        limbsToBytes(cursor.data(), run, bytes);
+        cursor.advance(static_cast<int>(run));
+        bytes += run * sizeof(uint64_t);
+        remaining -= run;
+    }
+    return record;
+}
+
+// Read one binary record from the start of a buffer, copying its limbs straight into blocks
+LargeNumber LargeNumber::fromBinary(const char* data, size_t length, size_t& used) {
+    if (length < BINARY_HEADER_BYTES || memcmp(data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+        throw invalid_argument("Not a binary number record");
+    }
+    if (loadLittleEndian(data + 4, 2) != BINARY_FORMAT_VERSION) {
+        throw invalid_argument("Unsupported binary number version");
+    }
+    uint8_t flags = static_cast<uint8_t>(data[6]);
+    if ((flags & ~BINARY_NEGATIVE) != 0 || data[7] != 0) {
+        throw invalid_argument("Invalid binary number flags");
+    }
+    uint64_t count = loadLittleEndian(data + 8, 8);
+    if (count > (length - BINARY_HEADER_BYTES) / sizeof(uint64_t)) {
+        throw invalid_argument("Truncated binary number record");
+    }
+    const char* bytes = data + BINARY_HEADER_BYTES;
+
+    LargeNumber result;
+    bool valid = true;
+    result.negative = (flags & BINARY_NEGATIVE) != 0;
+    if (count <= static_cast<uint64_t>(INLINE_LIMBS)) {
+        uint64_t limbs[INLINE_LIMBS];
+        valid = bytesToLimbs(bytes, count, limbs);
+        if (valid) {
+            result.storeLimbs(limbs, static_cast<int>(count));
+        }
+    }
+    else {
+        LimbWriter out(result);
+        for (size_t done = 0; valid && done < count;) {
+            int room;
+            uint64_t* limbs = out.reserve(room);
+            size_t run = min(static_cast<size_t>(count - done), static_cast<size_t>(room));
+            valid = bytesToLimbs(bytes + done * sizeof(uint64_t), run, limbs);
+            out.commit(static_cast<int>(run));
+            done += run;
+        }
+        result.normalize();
+    }
+    if (!valid) {
+        throw invalid_argument("Invalid limb in binary number record");
+    }
+    used = BINARY_HEADER_BYTES + static_cast<size_t>(count) * sizeof(uint64_t);
+    return result;
+}
+
+// Build limbs straight from a digit buffer with an optional leading minus sign, eight
+// digits per 64-bit load
+void LargeNumber::parse(const char* digits, size_t length) {
+    LARGE_NUMBER_STATS_TIME(LargeNumberOperation::Parse, (length + 17) / 18);
+    size_t start = 0;
+    bool isNegative = length > 0 && digits[0] == '-';
+    if (isNegative) {
+        start = 1;
+        if (length == 1) {
+            throw invalid_argument("Invalid digit in number");
+        }
+    }
+    while (start < length && digits[start] == '0') {
+        start++;
+    }
+
+    // Short inputs parse straight into the inline limbs
+    if (length - start <= static_cast<size_t>(INLINE_LIMBS) * 18) {
+        uint64_t limbs[INLINE_LIMBS];
+        int count = 0;
+        size_t end = length;
+        bool valid = true;
+        while (valid && end - start >= 18) {
+            valid = parseLimb(digits + end - 18, limbs[count++]);
+            end -= 18;
+        }
+        if (valid && end > start) {
+            valid = parseDigits(digits + start, end - start, limbs[count++]);
+        }
+        if (!valid) {
+            throw invalid_argument("Invalid digit in number");
+        }
+        negative = isNegative;
+        storeLimbs(limbs, count);
+        return;
+    }
+
+    // Fill whole blocks from the least significant end, 18 digits per limb
+    LimbWriter out(*this);
+    size_t end = length;
+    bool valid = true;
+
+    // Very long inputs parse their full limbs on the shared pool, since each limb owns fixed digits
+    size_t fullLimbs = (length - start) / 18;
+    if (fullLimbs > 0 && ThreadPool::shouldParallelize(length - start)) {
+        out.extend(fullLimbs);
+        LimbIndex index(tail);
+        atomic<bool> allValid{ true };
+        size_t segments = segmentCount(fullLimbs);
+        size_t segmentLength = (fullLimbs + segments - 1) / segments;
+        ThreadPool::shared().parallelFor(segments, [&](size_t k) {
+            size_t first = min(fullLimbs, k * segmentLength);
+            size_t last = min(fullLimbs, first + segmentLength);
+            int limb;
+            Node* node = index.locate(first, limb);
+            for (size_t position = first; position < last; position++) {
+                if (!parseLimb(digits + length - 18 * (position + 1), node->limbs[limb])) {
+                    allValid.store(false, memory_order_relaxed);
+                    return;
+                }
+                node = stepBlock(node, limb, 1);
+            }
+        });
+        valid = allValid.load();
+        end = length - 18 * fullLimbs;
+    }
+    while (valid && end - start >= 18) {
+        int room;
+        uint64_t* limbs = out.reserve(room);
+        int written = 0;
+        while (written < room && end - start >= 18) {
+            if (!parseLimb(digits + end - 18, limbs[written])) {
+                valid = false;
+                break;
+            }
+            written++;
+            end -= 18;
+        }
+        out.commit(written);
+    }
+    uint64_t limb;
+    if (valid && end > start) {
+        valid = parseDigits(digits + start, end - start, limb);
+        if (valid) {
+            out.push(limb);
+        }
+    }
+
+    // Release any blocks already built, since a throwing constructor skips the destructor
+    if (!valid) {
+        clear();
+        throw invalid_argument("Invalid digit in number");
+    }
+
+    // Add zero limb if input was zero
+    if (size == 0) {
+        out.push(0);
+    }
+    negative = isNegative;
+    normalize();
+}
+
+// Get the 3-digit group values from most to least significant
+vector<int> LargeNumber::getNodeValues() const {
+    LargeNumber scratch;
+    const LargeNumber& source = blockView(*this, scratch);
+    vector<int> values(size);
+    int filled = 0;
+    for (Node* current = source.head; current; current = current->next) {
+        unpackGroups(current, values.data() + filled);
+        filled += current->groups;
+    }
+    return values;
+}
+
+// Split the aligned magnitude into base 10^9 words, least significant first
+vector<uint32_t> LargeNumber::toWords() const {
+    LargeNumber scratch;
+    const LargeNumber& source = inlineCount > 0 ? *this : alignedView(*this, scratch);
+    vector<uint32_t> words;
+    words.reserve(static_cast<size_t>(source.size) / 3 + 2);
+    for (int i = 0; i < inlineCount; i++) {
+        words.push_back(static_cast<uint32_t>(inlineLimbs[i] % Multiplication::WORD_BASE));
+        words.push_back(static_cast<uint32_t>(inlineLimbs[i] / Multiplication::WORD_BASE));
+    }
+    for (LimbCursor cursor(source.tail); !cursor.done(); cursor.advance(cursor.remaining())) {
+        const uint64_t* limbs = cursor.data();
+        for (int i = 0; i < cursor.remaining(); i++) {
+            words.push_back(static_cast<uint32_t>(limbs[i] % Multiplication::WORD_BASE));
+            words.push_back(static_cast<uint32_t>(limbs[i] / Multiplication::WORD_BASE));
+        }
+    }
+    while (!words.empty() && words.back() == 0) {
+        words.pop_back();
+    }
+    return words;
+}
+
+// Build a LargeNumber from base 10^9 words, least significant first
+LargeNumber LargeNumber::fromWords(const vector<uint32_t>& words, bool isNegative) {
+    LargeNumber result;
+
+    // Results that fit are stored inline
+    if (words.size() <= static_cast<size_t>(INLINE_LIMBS) * 2) {
+        uint64_t limbs[INLINE_LIMBS];
+        int count = 0;
+        for (size_t i = 0; i < words.size(); i += 2) {
+            uint64_t high = i + 1 < words.size() ? words[i + 1] : 0;
+            limbs[count++] = high * Multiplication::WORD_BASE + words[i];
+        }
+        result.negative = isNegative;
+        result.storeLimbs(limbs, count);
+        return result;
+    }
+
+    LimbWriter out(result);
+    for (size_t i = 0; i < words.size(); i += 2) {
+        uint64_t high = i + 1 < words.size() ? words[i + 1] : 0;
+        out.push(high * Multiplication::WORD_BASE + words[i]);
+    }
+    if (!result.head) {
+        out.push(0);
+    }
+    result.negative = isNegative;
+    result.normalize();
+    return result;
+}
+
+// Add a new empty block from the NodePool to end of list
+Node* LargeNumber::addNode() {
+    index.invalidate();
+    Node* newNode = NodePool::allocate();
+    if (!head) {
+        head = tail = newNode;
+    }
+    else {
+        tail->next = newNode;
+        newNode->prev = tail;
+        tail = newNode;
+    }
+    nodeCount++;
+    return newNode;
+}
+
+// Add a new empty block to front of list
+Node* LargeNumber::addNodeFront() {
+    index.invalidate();
+    Node* newNode = NodePool::allocate();
+    if (!head) {
+        head = tail = newNode;
+    }
+    else {
+        newNode->next = head;
+        head->prev = newNode;
+        head = newNode;
+    }
+    nodeCount++;
+    return newNode;
+}
+
+// Compare magnitudes of any two numbers, aligning copies first if either has been edited
+int LargeNumber::compareMagnitude(const LargeNumber& other) const {
+    LARGE_NUMBER_STATS_TIME(LargeNumberOperation::Compare, (max(size, other.size) + 5) / 6);
+    if (inlineCount > 0 && other.inlineCount > 0) {
+        return compareLimbs(inlineLimbs, inlineCount, other.inlineLimbs, other.inlineCount);
+    }
+    LargeNumber scratchA, scratchB;
+    return alignedView(*this, scratchA).compare(alignedView(other, scratchB));
+}
+
+// Compare signed values
+bool LargeNumber::operator==(const LargeNumber& other) const {
+    if (negative != other.negative) {
+        return false;
+    }
+
+    // Copies still sharing their blocks hold the same magnitude
+    if (head && head == other.head) {
+        return true;
+    }
+    return compareMagnitude(other) == 0;
+}
+
+bool LargeNumber::operator!=(const LargeNumber& other) const {
+    return !(*this == other);
+}
+
+// Hash the sign and the limbs, least significant first, without leading zero limbs
+size_t LargeNumber::getHash() const {
+    if (inlineCount > 0) {
+        int count = inlineCount;
+        while (count > 0 && inlineLimbs[count - 1] == 0) {
+            count--;
+        }
+        LimbHash hash(static_cast<uint64_t>(count));
+        hash.add(inlineLimbs, count);
+        return static_cast<size_t>(hash.finish(negative));
+    }
+
+    // Count the limbs below the leading zeros, which node edits can leave in the head
+    LargeNumber scratch;
+    const LargeNumber& view = alignedView(*this, scratch);
+    uint64_t limbs = 0;
+    for (const Node* node = view.head; node; node = node->next) {
+        limbs += static_cast<uint64_t>(node->count);
+    }
+    for (const Node* node = view.head; node; node = node->next) {
+        int top = node->count - 1;
+        while (top >= 0 && node->limbs[top] == 0) {
+            top--;
+            limbs--;
+        }
+        if (top >= 0) {
+            break;
+        }
+    }
+    LimbHash hash(limbs);
+    for (LimbCursor cursor(view.tail); !cursor.done() && hash.used < limbs; cursor.advance(cursor.remaining())) {
+        hash.add(cursor.data(), cursor.remaining());
+    }
+    return static_cast<size_t>(hash.finish(negative));
+}
+
+// Compare the magnitudes of two aligned LargeNumbers
 int LargeNumber::compare(const LargeNumber& other) const {
-    if (size != other.size) {
-        return size - other.size;
+    const Node* n1 = head;
+    const Node* n2 = other.head;
+    int i1 = n1 ? n1->count - 1 : 0;
+    int i2 = n2 ? n2->count - 1 : 0;
+    int limbs1 = 0;
+    int limbs2 = 0;
+    for (const Node* current = head; current; current = current->next) {
+        limbs1 += current->count;
+    }
+    for (const Node* current = other.head; current; current = current->next) {
+        limbs2 += current->count;
     }
 
-    Node* n1 = head;
-    Node* n2 = other.head;
+    // Skip leading zero limbs
+    while (n1 && n1->limbs[i1] == 0) {
+        limbs1--;
+        if (--i1 < 0 && (n1 = n1->next)) i1 = n1->count - 1;
+    }
+    while (n2 && n2->limbs[i2] == 0) {
+        limbs2--;
+        if (--i2 < 0 && (n2 = n2->next)) i2 = n2->count - 1;
+    }
+
+    if (limbs1 != limbs2) {
+        return limbs1 < limbs2 ? -1 : 1;
+    }
+
+    // Walk both numbers from the most significant limb
     while (n1 && n2) {
-        if (n1->value != n2->value) {
-            return n1->value - n2->value;
+        if (n1->limbs[i1] != n2->limbs[i2]) {
+            return n1->limbs[i1] < n2->limbs[i2] ? -1 : 1;
         }
-        n1 = n1->next;
-        n2 = n2->next;
+        if (--i1 < 0 && (n1 = n1->next)) i1 = n1->count - 1;
+        if (--i2 < 0 && (n2 = n2->next)) i2 = n2->count - 1;
     }
 
     return 0;
 }
 
-// Clear linked list
+// Clear linked list, returning every block to the pool at once unless a copy still shares them
 void LargeNumber::clear() {
-    while (head) {
-        Node* temp = head;
-        head = head->next;
-        delete temp;
+    BlockShare* current = share.load(memory_order_relaxed);
+    if (!current || current->owners.fetch_sub(1, memory_order_acq_rel) == 1) {
+        delete current;
+        NodePool::releaseList(head, tail, nodeCount);
     }
+    share.store(nullptr, memory_order_relaxed);
+    index.invalidate();
+    head = nullptr;
     tail = nullptr;
     size = 0;
+    nodeCount = 0;
+    aligned = true;
+    inlineCount = 0;
 }
 
-// Copy nodes from another LargeNumber instance
+// Copy blocks from another LargeNumber instance into this one's existing blocks
 void LargeNumber::copyFrom(const LargeNumber& other) {
-    Node* current = other.head;
-    while (current) {
-        addNode(current->value);
-        current = current->next;
+
+    // Small values are copied inline, giving back any blocks this number held
+    if (other.inlineCount > 0) {
+        clear();
+        memcpy(inlineLimbs, other.inlineLimbs, other.inlineCount * sizeof(uint64_t));
+        inlineCount = other.inlineCount;
+        size = other.size;
+        return;
+    }
+
+    // Blocks another number still reads cannot be written over
+    if (share.load(memory_order_relaxed)) {
+        clear();
+    }
+    index.invalidate();
+    inlineCount = 0;
+    Node* target = head;
+    for (Node* current = other.head; current; current = current->next) {
+        Node* copy = target ? target : addNode();
+        target = copy->next;
+        memcpy(copy->limbs, current->limbs, current->count * sizeof(uint64_t));
+        copy->count = current->count;
+        copy->groups = current->groups;
+    }
+
+    // Release blocks left over from a longer previous value
+    if (target) {
+        int surplus = 0;
+        for (Node* current = target; current; current = current->next) {
+            surplus++;
+        }
+        Node* last = target->prev;
+        NodePool::releaseList(target, tail, surplus);
+        nodeCount -= surplus;
+        tail = last;
+        if (last) {
+            last->next = nullptr;
+        }
+        else {
+            head = nullptr;
+        }
+    }
+    size = other.size;
+    aligned = other.aligned;
+}
+
+// Share the blocks of another LargeNumber, or copy its value if it is held inline
+void LargeNumber::shareFrom(const LargeNumber& other) {
+    if (other.inlineCount > 0 || !other.head) {
+        copyFrom(other);
+        return;
+    }
+    if (head == other.head) {
+        return;
+    }
+
+    // The first copy of a number gives its blocks an owner count; concurrent copies agree on one
+    BlockShare* current = other.share.load(memory_order_acquire);
+    if (!current) {
+        BlockShare* created = new BlockShare();
+        if (other.share.compare_exchange_strong(current, created, memory_order_acq_rel, memory_order_acquire)) {
+            current = created;
+        }
+        else {
+            delete created;
+        }
+    }
+    current->owners.fetch_add(1, memory_order_relaxed);
+
+    clear();
+    head = other.head;
+    tail = other.tail;
+    size = other.size;
+    nodeCount = other.nodeCount;
+    aligned = other.aligned;
+    share.store(current, memory_order_relaxed);
+}
+
+// Check whether another number holds the same blocks
+bool LargeNumber::isShared() const {
+    BlockShare* current = share.load(memory_order_relaxed);
+    return current && current->owners.load(memory_order_acquire) > 1;
+}
+
+// Give this number blocks of its own before they are changed
+void LargeNumber::detach() {
+    BlockShare* current = share.load(memory_order_relaxed);
+    if (!current) {
+        return;
+    }
+
+    // The last owner keeps the blocks; only copies that still have company copy them
+    if (current->owners.load(memory_order_acquire) == 1) {
+        delete current;
+        share.store(nullptr, memory_order_relaxed);
+        return;
     }
+    LargeNumber copy;
+    copy.copyFrom(*this);
+    takeNodesFrom(copy);
+}
+
+// Take over the blocks of another LargeNumber, leaving it empty
+void LargeNumber::takeNodesFrom(LargeNumber& other) {
+    clear();
+    head = other.head;
+    tail = other.tail;
+    size = other.size;
+    nodeCount = other.nodeCount;
+    aligned = other.aligned;
+    memcpy(inlineLimbs, other.inlineLimbs, other.inlineCount * sizeof(uint64_t));
+    inlineCount = other.inlineCount;
+    share.store(other.share.load(memory_order_relaxed), memory_order_relaxed);
+    other.share.store(nullptr, memory_order_relaxed);
+    other.head = other.tail = nullptr;
+    other.size = other.nodeCount = other.inlineCount = 0;
+    other.aligned = true;
+    other.index.invalidate();
 }
 
-// Get node at a specific position
-Node* LargeNumber::getNodeAtPosition(int position) const {
+// Get the block holding a 3-digit group and the group's offset within it through the
+// BlockIndex tree, rebuilding the tree first if the list changed outside the edit methods
+Node* LargeNumber::getNodeAtPosition(int position, int& offset) {
     if (position < 0 || position >= size) {
         throw out_of_range("Invalid position");
     }
+    LARGE_NUMBER_STATS_ADD(LargeNumberCounter::Lookups, 1);
+    if (!index.isValid()) {
+        index.build(head);
+    }
+    return index.locate(static_cast<size_t>(position), offset);
+}
+
+// Unlink a block from the list and return it to the pool
+void LargeNumber::removeNode(Node* node) {
+    if (index.isValid()) {
+        index.remove(node);
+    }
+    if (node->prev) node->prev->next = node->next;
+    else head = node->next;
+    if (node->next) node->next->prev = node->prev;
+    else tail = node->prev;
+    nodeCount--;
+    NodePool::release(node);
+}
+
+// Replace an overflowing block with two blocks sharing its groups
+void LargeNumber::splitNode(Node* node, const int* groupValues, int count) {
+    int upperCount = count / 2;
+    Node* upper = NodePool::allocate();
+    packGroups(upper, groupValues, upperCount);
+    packGroups(node, groupValues + upperCount, count - upperCount);
+    linkBefore(node, upper);
+    aligned = false;
+}
+
+// Give a block new groups, most significant first, splitting it into
+// evenly filled blocks when they overflow and removing it when empty
+void LargeNumber::replaceGroups(Node* node, const int* groupValues, int count) {
+    if (count == 0) {
+        removeNode(node);
+        return;
+    }
+    int blocks = (count + GROUPS_PER_NODE - 1) / GROUPS_PER_NODE;
+    int placed = 0;
+    for (int i = 0; i < blocks - 1; i++) {
+        int share = (count - placed) / (blocks - i);
+        Node* upper = NodePool::allocate();
+        packGroups(upper, groupValues + placed, share);
+        linkBefore(node, upper);
+        placed += share;
+    }
+    packGroups(node, groupValues + placed, count - placed);
+}
+
+// Link a new block into the list in front of node, keeping the index current
+void LargeNumber::linkBefore(Node* node, Node* block) {
+    block->prev = node->prev;
+    block->next = node;
+    if (node->prev) node->prev->next = block;
+    else head = block;
+    node->prev = block;
+    nodeCount++;
+    if (index.isValid()) {
+        index.update(node);
+        index.insertBefore(node, block);
+    }
+}
+
+// Strip leading zero limbs and size the head block to its digits
+void LargeNumber::normalize() {
+    detach();
+    index.invalidate();
+    if (inlineCount > 0) {
+        storeInline(inlineLimbs, inlineCount);
+        return;
+    }
+    while (head) {
+        while (head->count > 0 && head->limbs[head->count - 1] == 0) {
+            head->count--;
+        }
+        if (head->count > 0 || head == tail) {
+            break;
+        }
+        Node* temp = head;
+        head = head->next;
+        head->prev = nullptr;
+        size -= temp->groups;
+        nodeCount--;
+        NodePool::release(temp);
+    }
+
+    if (!head) {
+        negative = false;
+        return;
+    }
+
+    // Zero is a single zero limb and never negative
+    if (head->count == 0) {
+        head->limbs[0] = 0;
+        head->count = 1;
+        negative = false;
+    }
+
+    // A value that fits moves inline and gives its only block back
+    if (nodeCount == 1 && head->count <= INLINE_LIMBS) {
+        uint64_t limbs[INLINE_LIMBS];
+        int count = head->count;
+        memcpy(limbs, head->limbs, count * sizeof(uint64_t));
+        clear();
+        storeInline(limbs, count);
+        return;
+    }
+
+    int groups = countGroups(head->limbs, head->count);
+    size += groups - head->groups;
+    head->groups = groups;
+}
+
+// Count the limbs below the leading zero limbs of an inline value or an aligned list
+size_t LargeNumber::countBinaryLimbs() const {
+    if (inlineCount > 0) {
+        return inlineCount == 1 && inlineLimbs[0] == 0 ? 0 : static_cast<size_t>(inlineCount);
+    }
+    size_t count = 0;
+    for (const Node* current = head; current; current = current->next) {
+        count += static_cast<size_t>(current->count);
+    }
+    for (const Node* current = head; current; current = current->next) {
+        int top = current->count - 1;
+        while (top >= 0 && current->limbs[top] == 0) {
+            top--;
+            count--;
+        }
+        if (top >= 0) {
+            break;
+        }
+    }
+    return count;
+}
+
+// Fill the 16-byte binary record header
+void LargeNumber::encodeBinaryHeader(size_t limbCount, char* header) const {
+    memcpy(header, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    storeLittleEndian(BINARY_FORMAT_VERSION, header + 4, 2);
+    header[6] = static_cast<char>(negative && limbCount > 0 ? BINARY_NEGATIVE : 0);
+    header[7] = 0;
+    storeLittleEndian(limbCount, header + 8, 8);
+}
+
+// Hold a magnitude of at most INLINE_LIMBS limbs inline, dropping leading zero limbs
+// (the number must hold no blocks)
+void LargeNumber::storeInline(const uint64_t* limbs, int count) {
+    while (count > 0 && limbs[count - 1] == 0) {
+        count--;
+    }
+    memmove(inlineLimbs, limbs, count * sizeof(uint64_t));
+
+    // Zero is a single zero limb and never negative
+    if (count == 0) {
+        inlineLimbs[0] = 0;
+        count = 1;
+        negative = false;
+    }
+    inlineCount = count;
+    size = countGroups(inlineLimbs, count);
+}
+
+// Replace the magnitude with limbs (least significant first), inline when they fit
+void LargeNumber::storeLimbs(const uint64_t* limbs, int count) {
+    while (count > 0 && limbs[count - 1] == 0) {
+        count--;
+    }
+    clear();
+    if (count <= INLINE_LIMBS) {
+        storeInline(limbs, count);
+        return;
+    }
+    LimbWriter out(*this);
+    for (int i = 0; i < count; i++) {
+        out.push(limbs[i]);
+    }
+    normalize();
+}
+
+// Move an inline value into a block of its own, so it can be edited or walked as a list
+void LargeNumber::spill() {
+    if (inlineCount == 0) {
+        return;
+    }
+    Node* node = addNode();
+    memcpy(node->limbs, inlineLimbs, inlineCount * sizeof(uint64_t));
+    node->count = inlineCount;
+    node->groups = size;
+    inlineCount = 0;
+}
+
+// Set this number to a + b, where b carries the sign bNegative, for two inline values
+// (this may be a itself)
+void LargeNumber::combineInline(const LargeNumber& a, const LargeNumber& b, bool bNegative) {
+    uint64_t limbs[INLINE_LIMBS + 1];
+    const LargeNumber* larger = &a;
+    const LargeNumber* smaller = &b;
+    bool resultNegative = a.negative;
+    bool subtract = a.negative != bNegative;
+
+    // Mixed signs subtract the smaller magnitude and take the larger one's sign
+    if (compareLimbs(a.inlineLimbs, a.inlineCount, b.inlineLimbs, b.inlineCount) < 0) {
+        swap(larger, smaller);
+        if (subtract) {
+            resultNegative = bNegative;
+        }
+    }
+    int shared = smaller->inlineCount;
+    int count = larger->inlineCount;
+    uint64_t carry = subtract ? LimbKernels::subtract(limbs, larger->inlineLimbs, smaller->inlineLimbs, shared, 0)
+        : LimbKernels::add(limbs, larger->inlineLimbs, smaller->inlineLimbs, shared, 0);
+    carry = subtract ? LimbKernels::subtractBorrow(limbs + shared, larger->inlineLimbs + shared, count - shared, carry)
+        : LimbKernels::addCarry(limbs + shared, larger->inlineLimbs + shared, count - shared, carry);
+    if (carry && !subtract) {
+        limbs[count++] = carry;
+    }
+    negative = resultNegative;
+    storeLimbs(limbs, count);
+}
+
+// Repack every group into full limbs counted from the least significant end; node edits
+// leave partly filled blocks, and this runs before the next arithmetic operation
+void LargeNumber::realign() {
+    if (aligned) {
+        return;
+    }
+
+    LargeNumber packed;
+    LimbWriter out(packed);
+    uint64_t limb = 0;
+    int filled = 0;
+    for (Node* current = tail; current; current = current->prev) {
+        for (int i = 0; i < current->groups; i++) {
+            limb += static_cast<uint64_t>(getGroup(current, i)) * GROUP_POWERS[filled];
+            if (++filled == GROUPS_PER_LIMB) {
+                out.push(limb);
+                limb = 0;
+                filled = 0;
+            }
+        }
+    }
+
+    // A partial top limb keeps any leading zero groups it holds
+    if (filled > 0) {
+        out.push(limb);
+        packed.head->groups -= GROUPS_PER_LIMB - filled;
+        packed.size -= GROUPS_PER_LIMB - filled;
+    }
+
+    takeNodesFrom(packed);
+}
+
+// Return number itself if it is held in blocks, otherwise a block copy held in scratch
+const LargeNumber& LargeNumber::blockView(const LargeNumber& number, LargeNumber& scratch) {
+    if (number.inlineCount == 0) {
+        return number;
+    }
+    scratch = number;
+    scratch.spill();
+    return scratch;
+}
+
+// Return number itself if held in aligned blocks, otherwise an aligned block copy held in scratch
+const LargeNumber& LargeNumber::alignedView(const LargeNumber& number, LargeNumber& scratch) {
+    if (number.aligned && number.inlineCount == 0) {
+        return number;
+    }
+    scratch = number;
+    scratch.spill();
+    scratch.realign();
+    return scratch;
+}
+
+// Add two magnitudes run by run from the least significant end, handing each run of
+// contiguous limbs to the LimbKernels routines
+void LargeNumber::addMagnitudes(const LargeNumber& a, const LargeNumber& b, LargeNumber& result) {
+
+    // Very long operands are combined segment by segment on the shared pool
+    if (ThreadPool::shouldParallelize(static_cast<size_t>(max(a.size, b.size)) * 3)) {
+        LimbIndex longer(a.size >= b.size ? a.tail : b.tail);
+        LimbIndex shorter(a.size >= b.size ? b.tail : a.tail);
+        LimbWriter out(result);
+        out.extend(longer.total);
+        uint64_t carry = combineInParallel(longer, shorter, LimbIndex(result.tail), false);
+        if (carry) {
+            out.push(carry);
+        }
+        return;
+    }
 
-    Node* current;
-    if (position < size / 2) {
-        current = head;
-        for (int i = 0; i < position; i++) {
-            current = current->next;
+    LimbCursor c1(a.tail);
+    LimbCursor c2(b.tail);
+    LimbWriter out(result);
+    uint64_t carry = 0;
+
+    while (!c1.done() || !c2.done()) {
+        int room;
+        uint64_t* dest = out.reserve(room);
+        if (!c1.done() && !c2.done()) {
+            int run = min(room, min(c1.remaining(), c2.remaining()));
+            carry = LimbKernels::add(dest, c1.data(), c2.data(), run, carry);
+            c1.advance(run);
+            c2.advance(run);
+            out.commit(run);
+        }
+        else {
+            LimbCursor& rest = c1.done() ? c2 : c1;
+            int run = min(room, rest.remaining());
+            carry = LimbKernels::addCarry(dest, rest.data(), run, carry);
+            rest.advance(run);
+            out.commit(run);
         }
     }
+
+    if (carry || !result.head) {
+        out.push(carry);
+    }
+}
+
+// Subtract a smaller magnitude from a larger one run by run
+void LargeNumber::subtractMagnitudes(const LargeNumber& larger, const LargeNumber& smaller, LargeNumber& result) {
+    if (ThreadPool::shouldParallelize(static_cast<size_t>(larger.size) * 3)) {
+        LimbIndex first(larger.tail);
+        LimbWriter(result).extend(first.total);
+        combineInParallel(first, LimbIndex(smaller.tail), LimbIndex(result.tail), true);
+        return;
+    }
+
+    LimbCursor c1(larger.tail);
+    LimbCursor c2(smaller.tail);
+    LimbWriter out(result);
+    uint64_t borrow = 0;
+
+    while (!c1.done()) {
+        int room;
+        uint64_t* dest = out.reserve(room);
+        int run = min(room, c1.remaining());
+        if (!c2.done()) {
+            run = min(run, c2.remaining());
+            borrow = LimbKernels::subtract(dest, c1.data(), c2.data(), run, borrow);
+            c2.advance(run);
+        }
+        else {
+            borrow = LimbKernels::subtractBorrow(dest, c1.data(), run, borrow);
+        }
+        c1.advance(run);
+        out.commit(run);
+    }
+
+    if (!result.head) {
+        out.push(0);
+    }
+}
+
+// Add or subtract another number in place, reusing this number's blocks and allocating
+// only when it grows
+void LargeNumber::accumulate(const LargeNumber& other, bool subtract) {
+
+    // Blocks shared with a copy are left alone: building the result elsewhere costs no more than copying them
+    if (isShared()) {
+        *this = subtract ? *this - other : *this + other;
+        return;
+    }
+    LARGE_NUMBER_STATS_TIME(subtract ? LargeNumberOperation::Subtract : LargeNumberOperation::Add,
+        (max(size, other.size) + 5) / 6);
+    index.invalidate();
+
+    // A number with no value yet counts as zero
+    if (!head && inlineCount == 0) {
+        uint64_t zero = 0;
+        storeInline(&zero, 1);
+    }
+    if (inlineCount > 0 && other.inlineCount > 0) {
+        combineInline(*this, other, subtract ? !other.negative : other.negative);
+        return;
+    }
+    spill();
+    realign();
+    LargeNumber scratch;
+    const LargeNumber& b = alignedView(other, scratch);
+    bool otherNegative = subtract ? !b.negative : b.negative;
+
+    // Count the head's top limb as full while limbs change; normalize() trims it again
+    size += head->count * GROUPS_PER_LIMB - head->groups;
+    head->groups = head->count * GROUPS_PER_LIMB;
+
+    // Same signs add magnitudes; mixed signs subtract the smaller magnitude
+    if (negative == otherNegative) {
+        addMagnitudeInPlace(b);
+    }
+    else if (compare(b) >= 0) {
+        subtractMagnitudeInPlace(b, false);
+    }
     else {
-        current = tail;
-        for (int i = size - 1; i > position; i--) {
-            current = current->prev;
+        subtractMagnitudeInPlace(b, true);
+        negative = otherNegative;
+    }
+    normalize();
+}
+
+// Add an aligned magnitude into this one, growing at the head only when needed
+void LargeNumber::addMagnitudeInPlace(const LargeNumber& other) {
+    if (size >= other.size && ThreadPool::shouldParallelize(static_cast<size_t>(size) * 3)) {
+        LimbIndex self(tail);
+        uint64_t carry = combineInParallel(self, LimbIndex(other.tail), self, false);
+        if (carry) {
+            LimbWriter(*this).push(carry);
+        }
+        return;
+    }
+
+    LimbCursor source(other.tail);
+    Node* node = tail;
+    int index = 0;
+    uint64_t carry = 0;
+
+    while (!source.done() || carry) {
+        if (node && index == node->count && (node != head || node->count == Node::LIMBS_PER_NODE)) {
+            node = node->prev;
+            index = 0;
+            continue;
+        }
+        if (!node) {
+            node = addNodeFront();
+        }
+
+        uint64_t* dest = node->limbs + index;
+        int run;
+        if (index < node->count) {
+            if (!source.done()) {
+                run = min(node->count - index, source.remaining());
+                carry = LimbKernels::add(dest, dest, source.data(), run, carry);
+                source.advance(run);
+            }
+            else {
+                run = 1;
+                carry = LimbKernels::addCarry(dest, dest, 1, carry);
+            }
+        }
+
+        // Extend the head block into its unused room
+        else {
+            if (!source.done()) {
+                run = min(Node::LIMBS_PER_NODE - node->count, source.remaining());
+                carry = LimbKernels::addCarry(dest, source.data(), run, carry);
+                source.advance(run);
+            }
+            else {
+                run = 1;
+                *dest = carry;
+                carry = 0;
+            }
+            node->count += run;
+            node->groups += run * GROUPS_PER_LIMB;
+            size += run * GROUPS_PER_LIMB;
+        }
+        index += run;
+    }
+}
+
+// Subtract an aligned magnitude in place: this - other, or other - this when reversed
+void LargeNumber::subtractMagnitudeInPlace(const LargeNumber& other, bool reversed) {
+    if (!reversed && ThreadPool::shouldParallelize(static_cast<size_t>(size) * 3)) {
+        LimbIndex self(tail);
+        combineInParallel(self, LimbIndex(other.tail), self, true);
+        return;
+    }
+
+    LimbCursor source(other.tail);
+    Node* node = tail;
+    int index = 0;
+    uint64_t borrow = 0;
+
+    while (!source.done() || borrow) {
+        if (node && index == node->count && (!reversed || node != head || node->count == Node::LIMBS_PER_NODE)) {
+            node = node->prev;
+            index = 0;
+            continue;
+        }
+        if (!node) {
+            node = addNodeFront();
+        }
+
+        uint64_t* dest = node->limbs + index;
+        int run;
+        if (index < node->count) {
+            if (!source.done()) {
+                run = min(node->count - index, source.remaining());
+                borrow = reversed ? LimbKernels::subtract(dest, source.data(), dest, run, borrow)
+                    : LimbKernels::subtract(dest, dest, source.data(), run, borrow);
+                source.advance(run);
+            }
+            else {
+                run = 1;
+                borrow = LimbKernels::subtractBorrow(dest, dest, 1, borrow);
+            }
+        }
+
+        // The larger magnitude is longer: copy its remaining limbs into the head block
+        else {
+            run = min(Node::LIMBS_PER_NODE - node->count, source.remaining());
+            borrow = LimbKernels::subtractBorrow(dest, source.data(), run, borrow);
+            source.advance(run);
+            node->count += run;
+            node->groups += run * GROUPS_PER_LIMB;
+            size += run * GROUPS_PER_LIMB;
+        }
+        index += run;
+    }
+}
+
+// Get a 3-digit group of a block, counting from its least significant group
+int LargeNumber::getGroup(const Node* node, int index) {
+    return groupOf(node->limbs, index);
+}
+
+// Split a block into its 3-digit groups, most significant first
+void LargeNumber::unpackGroups(const Node* node, int* groupValues) {
+    int index = node->groups - 1;
+    for (int i = 0; i < node->count; i++) {
+        uint64_t limb = node->limbs[i];
+        int groupsInLimb = min(GROUPS_PER_LIMB, node->groups - i * GROUPS_PER_LIMB);
+        for (int j = 0; j < groupsInLimb; j++) {
+            groupValues[index--] = static_cast<int>(limb % 1000);
+            limb /= 1000;
+        }
+    }
+}
+
+// Fill a block from 3-digit groups, most significant first
+void LargeNumber::packGroups(Node* node, const int* groupValues, int count) {
+    node->count = (count + GROUPS_PER_LIMB - 1) / GROUPS_PER_LIMB;
+    node->groups = count;
+    for (int i = 0; i < node->count; i++) {
+        uint64_t limb = 0;
+        int low = i * GROUPS_PER_LIMB;
+        int high = min(count, low + GROUPS_PER_LIMB);
+        for (int j = high - 1; j >= low; j--) {
+            limb = limb * 1000 + static_cast<uint64_t>(groupValues[count - 1 - j]);
         }
+        node->limbs[i] = limb;
     }
-    return current;
 }
\ No newline at end of file
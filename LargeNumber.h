@@ -5,65 +5,252 @@
     This header file defines the LargeNumber class,
     which implements arbitrary-precision arithmetic
     using a doubly linked list structure. It includes methods
-    for addition, subtraction, comparison of large numbers,
-    and operations for inserting, deleting, and modifying nodes.
-    This file requires the standard libraries <string> and
-    <iostream>.
+    for addition, subtraction, multiplication, division,
+    comparison of large numbers, and operations for inserting, deleting,
+    and modifying nodes.
+    This file requires BlockIndex.h and the standard libraries
+    <atomic>, <cstddef>, <cstdint>, <functional>, <string>,
+    <vector>, and <iostream>.
 -------------------------------------------------- */
 
 #ifndef LARGE_NUMBER_H
 #define LARGE_NUMBER_H
+#include "BlockIndex.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional> // For unordered containers (hash)
 #include <string>
+#include <vector>
 #include <iostream>
 
-// Node structure for doubly linked list
+// Node structure for unrolled doubly linked list: each node is a block of limbs, so
+// arithmetic loops run over arrays and only follow a pointer once per block, while the
+// node manipulation methods and printing still present the number as 3-digit groups
 struct Node {
-    int value;
+    static const int LIMBS_PER_NODE = 128;
+
+    uint64_t limbs[LIMBS_PER_NODE]; // Limbs in base 10^18, least significant first
+    int count;                      // Number of limbs in use
+    int groups;                     // Number of 3-digit groups held by this block
     Node* next;
     Node* prev;
-    Node(int val) : value(val), next(nullptr), prev(nullptr) {}
+
+    // Links of the positional index (see BlockIndex)
+    Node* parent;
+    Node* left;
+    Node* right;
+    size_t subtreeGroups;
+    uint32_t priority;
+
+    Node() : count(0), groups(0), next(nullptr), prev(nullptr), parent(nullptr), left(nullptr), right(nullptr),
+        subtreeGroups(0), priority(0) {}
+};
+
+// One change in a batch of node edits
+enum class NodeEditKind {
+    Insert, // Put value in front of the group at position (position may equal the size to append)
+    Delete, // Remove the group at position
+    Modify  // Replace the group at position with value
+};
+
+struct NodeEdit {
+    NodeEditKind kind;
+    int position; // Group position in the number as it was before the batch
+    int value;    // 0 through 999 (ignored by Delete)
+};
+
+class LargeNumber;
+
+// One operand of LargeNumber::sum(), added or subtracted
+struct SumTerm {
+    const LargeNumber* number;
+    bool subtract;
 };
 
 class LargeNumber {
 public:
 
+    // Limb layout
+    static const uint64_t LIMB_BASE = 1000000000000000000ULL;
+    static const int GROUPS_PER_LIMB = 6;
+    static const int GROUPS_PER_NODE = Node::LIMBS_PER_NODE * GROUPS_PER_LIMB;
+
+    // Limbs held without a block (up to 72 digits): small values are built, added,
+    // subtracted, and compared with no blocks, and move into one when they grow or
+    // their nodes are edited
+    static const int INLINE_LIMBS = 4;
+
+    // Binary record layout, all little-endian: the magic "LNUM", a 2-byte version,
+    // a flags byte (bit 0 set for negative), a zero byte, an 8-byte limb count, then
+    // that many 8-byte limbs, least significant first (zero has no limbs). The limbs are
+    // exactly as held in memory, so a record loads with block copies instead of a parse
+    static const uint16_t BINARY_FORMAT_VERSION = 1;
+    static const size_t BINARY_HEADER_BYTES = 16;
+
     // Constructors and destructor
     LargeNumber();
     explicit LargeNumber(const std::string& number);
+    LargeNumber(const char* digits, size_t length);
     ~LargeNumber();
+
+    // Copies share their blocks until a sharer first edits its nodes or changes in place;
+    // the owner count is atomic, so copies of one number may be used on different threads
     LargeNumber(const LargeNumber& other);
+    LargeNumber(LargeNumber&& other) noexcept;
     LargeNumber& operator=(const LargeNumber& other);
+    LargeNumber& operator=(LargeNumber&& other) noexcept;
 
     // Arithmetic operations
     LargeNumber operator+(const LargeNumber& other) const;
     LargeNumber operator-(const LargeNumber& other) const;
+    LargeNumber& operator+=(const LargeNumber& other);
+    LargeNumber& operator-=(const LargeNumber& other);
+    LargeNumber operator*(const LargeNumber& other) const;
+    LargeNumber& operator*=(const LargeNumber& other);
+    LargeNumber operator/(const LargeNumber& other) const;
+    LargeNumber operator%(const LargeNumber& other) const;
+    LargeNumber& operator/=(const LargeNumber& other);
+    LargeNumber& operator%=(const LargeNumber& other);
+
+    // Add and subtract any number of operands in one pass over their limbs,
+    // writing one result and resolving carries and borrows once
+    static LargeNumber sum(const std::vector<SumTerm>& terms);
+
+    // Quotient truncated toward zero and remainder with the dividend's sign
+    static void divmod(const LargeNumber& dividend, const LargeNumber& divisor,
+        LargeNumber& quotient, LargeNumber& remainder);
+
+    // base^exponent mod modulus in [0, modulus); use a ModularContext to reuse one modulus
+    static LargeNumber powmod(const LargeNumber& base, const LargeNumber& exponent, const LargeNumber& modulus);
 
-    // Node manipulation method
+    // n!, n choose k, the nth Fibonacci number, and base^exponent, built by Combinatorics
+    // with product trees, doubling, and repeated squaring (length_error if too long to hold)
+    static LargeNumber factorial(uint64_t n);
+    static LargeNumber binomial(uint64_t n, uint64_t k);
+    static LargeNumber fibonacci(uint64_t n);
+    static LargeNumber pow(const LargeNumber& base, uint64_t exponent);
+
+    // Node manipulation method (positions count 3-digit groups)
     void insertNode(int position, int value);
     void deleteNode(int position);
     void modifyNode(int position, int newValue);
 
+    // Apply many node edits in one pass over the blocks; all positions refer to
+    // the number before the batch, and nothing changes if any edit is invalid
+    void applyNodeEdits(const std::vector<NodeEdit>& edits);
+
     // Overloaded output stream operator for improved printing
     friend std::ostream& operator<<(std::ostream& os, const LargeNumber& num);
+    std::string toString() const;
+
+    // Plain digit files: load through a memory mapping, store in fixed-size chunks
+    static LargeNumber loadFromFile(const std::string& path);
+    void saveToFile(const std::string& path) const;
+    void writeDigits(int fileDescriptor) const;
+
+    // Binary records: fromBinary() reads one record from a buffer, such as a memory
+    // mapping holding many records, and reports the bytes it used
+    static LargeNumber loadBinary(const std::string& path);
+    void saveBinary(const std::string& path) const;
+    void writeBinary(int fileDescriptor) const;
+    std::string toBinary() const;
+    static LargeNumber fromBinary(const char* data, size_t length, size_t& used);
+
+    // Compare magnitudes, ignoring signs: negative, zero, or positive
+    int compareMagnitude(const LargeNumber& other) const;
+
+    // Compare signed values, unlike compareMagnitude()
+    bool operator==(const LargeNumber& other) const;
+    bool operator!=(const LargeNumber& other) const;
+
+    // Hash the sign and the limbs without leading zeros, so a value hashes the same whether
+    // it is held inline or in blocks (also behind std::hash<LargeNumber>)
+    size_t getHash() const;
 
     // Accessor methods
     bool isNegative() const { return negative; }
-    Node* getHead() const { return head; }
     int getSize() const { return size; }
+    size_t getMemoryBytes() const { return static_cast<size_t>(nodeCount) * sizeof(Node); } // Blocks, shared ones included
+    std::vector<int> getNodeValues() const;
+
+    // Conversion to and from base 10^9 words (least significant first) for the arithmetic kernels
+    std::vector<uint32_t> toWords() const;
+    static LargeNumber fromWords(const std::vector<uint32_t>& words, bool isNegative = false);
 
 private:
+    friend class LargeNumberAccumulator; // Adds limbs straight from the blocks
+    friend class NumberInterner; // Drops values whose blocks no copy shares
+
     Node* head;
     Node* tail;
     bool negative;
-    int size; // Track number of nodes
+    int size;      // Track number of 3-digit groups
+    int nodeCount; // Track number of blocks
+    bool aligned;  // True when every block but the head holds only full limbs
+    BlockIndex index; // Finds group positions in logarithmic time; rebuilt after arithmetic
+    uint64_t inlineLimbs[INLINE_LIMBS]; // Limbs of a small value, least significant first
+    int inlineCount; // Limbs in use inline (0 when the value is held in blocks)
+
+    // Owner count of blocks shared between copies (null until the blocks are first copied)
+    struct BlockShare;
+    mutable std::atomic<BlockShare*> share{ nullptr };
+
+    // Sequential limb access from the least significant end
+    struct LimbCursor;
+    class LimbWriter;
 
     // Helper methods for internal operations
-    void addNode(int value);
-    void addNodeFront(int value);
+    void parse(const char* digits, size_t length);
+    Node* addNode();
+    Node* addNodeFront();
     int compare(const LargeNumber& other) const;
     void clear();
     void copyFrom(const LargeNumber& other);
-    Node* getNodeAtPosition(int position) const;
+    void shareFrom(const LargeNumber& other);
+    void takeNodesFrom(LargeNumber& other);
+    bool isShared() const;
+    void detach();
+    Node* getNodeAtPosition(int position, int& offset);
+    void removeNode(Node* node);
+    void linkBefore(Node* node, Node* block);
+    void splitNode(Node* node, const int* groupValues, int count);
+    void replaceGroups(Node* node, const int* groupValues, int count);
+    void normalize();
+    void realign();
+    void clearSignOfZero();
+
+    // Inline storage for small values
+    void storeInline(const uint64_t* limbs, int count);
+    void storeLimbs(const uint64_t* limbs, int count);
+    void spill();
+    void combineInline(const LargeNumber& a, const LargeNumber& b, bool bNegative);
+
+    // Binary record helpers
+    size_t countBinaryLimbs() const;
+    void encodeBinaryHeader(size_t limbCount, char* header) const;
+
+    // Limb arithmetic on aligned magnitudes
+    static const LargeNumber& blockView(const LargeNumber& number, LargeNumber& scratch);
+    static const LargeNumber& alignedView(const LargeNumber& number, LargeNumber& scratch);
+    static void addMagnitudes(const LargeNumber& a, const LargeNumber& b, LargeNumber& result);
+    static void subtractMagnitudes(const LargeNumber& larger, const LargeNumber& smaller, LargeNumber& result);
+    void accumulate(const LargeNumber& other, bool subtract);
+    void addMagnitudeInPlace(const LargeNumber& other);
+    void subtractMagnitudeInPlace(const LargeNumber& other, bool reversed);
+
+    // Conversion between blocks and 3-digit groups
+    static int getGroup(const Node* node, int index);
+    static void unpackGroups(const Node* node, int* groupValues);
+    static void packGroups(Node* node, const int* groupValues, int count);
 };
 
+// Hash for unordered containers of LargeNumbers
+namespace std {
+    template <>
+    struct hash<LargeNumber> {
+        size_t operator()(const LargeNumber& number) const { return number.getHash(); }
+    };
+}
+
 #endif // LARGE_NUMBER_H
\ No newline at end of file
@@ -0,0 +1,198 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the LargeNumberAccumulator class defined
+    in LargeNumberAccumulator.h. The total is the limbs plus each
+    position's pending carry count times that position's power of
+    the base. An operand is added into the limbs below its top
+    with the limb kernels, and only the single carry or borrow
+    leaving its top limb is counted, so the counts grow by at most
+    one per operand and never come near the range of int64_t.
+    Reading the value walks the positions once, adding each count
+    to its limb and passing the signed carry upward; a negative
+    total is then negated the same way LargeNumber::sum() does.
+    It requires LargeNumberAccumulator.h, LimbKernels.h, ThreadPool.h,
+    <algorithm>, and <vector> to run.
+-------------------------------------------------- */
+
+#include "LargeNumberAccumulator.h"
+#include "LimbKernels.h"
+#include "ThreadPool.h"
+#include <algorithm> // For slice counts (min())
+#include <vector>
+
+using namespace std;
+
+// Add or subtract a run of limbs in place, returning the carry or borrow out of its top
+static uint64_t combineRun(uint64_t* limbs, const uint64_t* data, int count, uint64_t carry, bool subtract) {
+    return subtract ? LimbKernels::subtract(limbs, limbs, data, count, carry)
+        : LimbKernels::add(limbs, limbs, data, count, carry);
+}
+
+// Start from zero
+LargeNumberAccumulator::LargeNumberAccumulator() : terms(0) {
+}
+
+// Add one number
+void LargeNumberAccumulator::add(const LargeNumber& number) {
+    absorb(number, false);
+}
+
+// Subtract one number
+void LargeNumberAccumulator::subtract(const LargeNumber& number) {
+    absorb(number, true);
+}
+
+// Overloaded += operator
+LargeNumberAccumulator& LargeNumberAccumulator::operator+=(const LargeNumber& number) {
+    absorb(number, false);
+    return *this;
+}
+
+// Overloaded -= operator
+LargeNumberAccumulator& LargeNumberAccumulator::operator-=(const LargeNumber& number) {
+    absorb(number, true);
+    return *this;
+}
+
+// Add another accumulator's limbs with one kernel pass, and its pending carries position by position
+void LargeNumberAccumulator::merge(const LargeNumberAccumulator& other) {
+    size_t count = other.limbs.size();
+    if (count > 0) {
+        reserve(count + 1);
+        uint64_t carry = LimbKernels::add(limbs.data(), limbs.data(), other.limbs.data(), static_cast<int>(count), 0);
+        carries[count] += static_cast<int64_t>(carry);
+        for (size_t i = 0; i < count; i++) {
+            carries[i] += other.carries[i];
+        }
+    }
+    terms += other.terms;
+}
+
+// Fold the pending carries into the limbs of a new LargeNumber
+LargeNumber LargeNumberAccumulator::getValue() const {
+    const int64_t base = static_cast<int64_t>(LargeNumber::LIMB_BASE);
+    LargeNumber result;
+    if (limbs.empty()) {
+        return result;
+    }
+
+    // Each position's limb, pending count, and incoming carry make one signed value to split
+    vector<uint64_t> resolved(limbs.size() + 1, 0);
+    int64_t carry = 0;
+    for (size_t i = 0; i < limbs.size(); i++) {
+        int64_t value = static_cast<int64_t>(limbs[i]) + carries[i] + carry;
+        carry = value / base;
+        value %= base;
+        if (value < 0) {
+            value += base;
+            carry--;
+        }
+        resolved[i] = static_cast<uint64_t>(value);
+    }
+
+    // A negative total left its limbs as a power of the base plus the total: negate them
+    if (carry < 0) {
+        uint64_t borrow = 0;
+        for (size_t i = 0; i + 1 < resolved.size(); i++) {
+            uint64_t value = resolved[i] + borrow;
+            borrow = value != 0 ? 1 : 0;
+            resolved[i] = borrow ? LargeNumber::LIMB_BASE - value : 0;
+        }
+        resolved.back() = static_cast<uint64_t>(-carry) - borrow;
+        result.negative = true;
+    }
+    else {
+        resolved.back() = static_cast<uint64_t>(carry);
+    }
+    result.storeLimbs(resolved.data(), static_cast<int>(resolved.size()));
+    return result;
+}
+
+// Reset to zero, keeping the storage for the next total
+void LargeNumberAccumulator::clear() {
+    fill(limbs.begin(), limbs.end(), 0);
+    fill(carries.begin(), carries.end(), 0);
+    terms = 0;
+}
+
+// Get the number of terms
+size_t LargeNumberAccumulator::getTermCount() const {
+    return terms;
+}
+
+// Sum numbers given by pointer: one accumulator per slice of the input, merged in a tree
+LargeNumber LargeNumberAccumulator::sum(const vector<const LargeNumber*>& numbers) {
+    size_t digits = 0;
+    for (const LargeNumber* number : numbers) {
+        digits += static_cast<size_t>(number->getSize()) * 3;
+    }
+    ThreadPool& pool = ThreadPool::shared();
+    size_t slices = min(numbers.size(), pool.getThreadCount());
+    if (slices < 2 || !ThreadPool::shouldParallelize(digits)) {
+        LargeNumberAccumulator total;
+        for (const LargeNumber* number : numbers) {
+            total.add(*number);
+        }
+        return total.getValue();
+    }
+
+    vector<LargeNumberAccumulator> partial(slices);
+    pool.parallelFor(slices, [&](size_t k) {
+        size_t end = numbers.size() * (k + 1) / slices;
+        for (size_t i = numbers.size() * k / slices; i < end; i++) {
+            partial[k].add(*numbers[i]);
+        }
+    });
+
+    // Each round merges partial[k + step] into partial[k] for every k that is a multiple of 2 * step
+    for (size_t step = 1; step < slices; step *= 2) {
+        size_t pairs = (slices - step + 2 * step - 1) / (2 * step);
+        pool.parallelFor(pairs, [&](size_t j) {
+            size_t k = j * 2 * step;
+            partial[k].merge(partial[k + step]);
+        });
+    }
+    return partial[0].getValue();
+}
+
+// Sum a vector of numbers
+LargeNumber LargeNumberAccumulator::sum(const vector<LargeNumber>& numbers) {
+    return sum(numbers.begin(), numbers.end());
+}
+
+// Add a number's limbs into the low positions and count the carry out of its top
+void LargeNumberAccumulator::absorb(const LargeNumber& number, bool subtract) {
+    bool negate = subtract != number.negative;
+    uint64_t carry = 0;
+    size_t position = 0;
+    if (number.inlineCount > 0) {
+        position = static_cast<size_t>(number.inlineCount);
+        reserve(position + 1);
+        carry = combineRun(limbs.data(), number.inlineLimbs, number.inlineCount, 0, negate);
+    }
+    else {
+        LargeNumber scratch;
+        const LargeNumber& view = LargeNumber::alignedView(number, scratch);
+        size_t count = 0;
+        for (const Node* node = view.head; node; node = node->next) {
+            count += static_cast<size_t>(node->count);
+        }
+        reserve(count + 1);
+        for (const Node* node = view.tail; node; node = node->prev) {
+            carry = combineRun(limbs.data() + position, node->limbs, node->count, carry, negate);
+            position += static_cast<size_t>(node->count);
+        }
+    }
+    carries[position] += negate ? -static_cast<int64_t>(carry) : static_cast<int64_t>(carry);
+    terms++;
+}
+
+// Make room for at least count positions
+void LargeNumberAccumulator::reserve(size_t count) {
+    if (limbs.size() < count) {
+        limbs.resize(count, 0);
+        carries.resize(count, 0);
+    }
+}
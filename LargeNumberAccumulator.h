@@ -0,0 +1,74 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the LargeNumberAccumulator class,
+    which sums many LargeNumber values without resolving carries
+    after each one. Adding a number runs the limb kernels over
+    that number's own length only; the carry or borrow out of its
+    top is not propagated into the total but counted at that
+    position, so each addition or subtraction costs the length of
+    the operand rather than the length of the running total.
+    The counts are folded in once, when the value is read.
+    The static sum() adds a whole range of numbers: long inputs
+    are split across the shared ThreadPool, each task filling its
+    own accumulator, and the partial accumulators are merged
+    pairwise in a tree.
+    This file requires LargeNumber.h, <cstddef>, <cstdint>, and <vector>.
+-------------------------------------------------- */
+
+#ifndef LARGE_NUMBER_ACCUMULATOR_H
+#define LARGE_NUMBER_ACCUMULATOR_H
+
+#include "LargeNumber.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class LargeNumberAccumulator {
+public:
+
+    // Start from zero
+    LargeNumberAccumulator();
+
+    // Add or subtract one number
+    void add(const LargeNumber& number);
+    void subtract(const LargeNumber& number);
+    LargeNumberAccumulator& operator+=(const LargeNumber& number);
+    LargeNumberAccumulator& operator-=(const LargeNumber& number);
+
+    // Add the total of another accumulator
+    void merge(const LargeNumberAccumulator& other);
+
+    // Resolve the pending carries into a LargeNumber; the accumulator is left as it was
+    LargeNumber getValue() const;
+
+    // Reset to zero
+    void clear();
+
+    // Numbers added or subtracted since the last clear(), merged ones included
+    size_t getTermCount() const;
+
+    // Sum a range of numbers, in parallel on the shared ThreadPool when the input is long enough
+    static LargeNumber sum(const std::vector<const LargeNumber*>& numbers);
+    static LargeNumber sum(const std::vector<LargeNumber>& numbers);
+    template <typename Iterator>
+    static LargeNumber sum(Iterator first, Iterator last) {
+        std::vector<const LargeNumber*> numbers;
+        for (; first != last; ++first) {
+            numbers.push_back(&*first);
+        }
+        return sum(numbers);
+    }
+
+private:
+    std::vector<uint64_t> limbs;  // Limbs in base 10^18, least significant first, each below the base
+    std::vector<int64_t> carries; // Carries counted at each position but not yet added to limbs
+    size_t terms;
+
+    // Helper methods
+    void absorb(const LargeNumber& number, bool subtract);
+    void reserve(size_t count);
+};
+
+#endif // LARGE_NUMBER_ACCUMULATOR_H
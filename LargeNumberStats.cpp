@@ -0,0 +1,292 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the LargeNumberStats class defined in
+    LargeNumberStats.h. Like the NodePool counters, every thread
+    records into its own block of counters, written only by that
+    thread, so recording never takes a lock or contends for a
+    cache line; reading the statistics sums the live blocks and
+    whatever exiting threads left behind. Resetting records those
+    sums as a baseline that later reads subtract, and starts a new
+    generation, after which each thread restarts its own slowest
+    call.
+    It requires LargeNumberStats.h, NodePool.h, <algorithm>,
+    <atomic>, <cmath>, <iomanip>, <mutex>, and <vector> to run.
+-------------------------------------------------- */
+
+#include "LargeNumberStats.h"
+#include "NodePool.h"
+#include <algorithm> // For the slowest call (max())
+#include <atomic> // For lock-free counters (atomic)
+#include <cmath> // For percentile ranks (ceil())
+#include <iomanip> // For formatting (setw() and setprecision())
+#include <mutex> // For the shared registry (mutex and lock_guard)
+#include <vector>
+
+using namespace std;
+
+const int OperationStats::BUCKETS;
+const int LargeNumberStatsSnapshot::OPERATIONS;
+const int LargeNumberStatsSnapshot::COUNTERS;
+
+namespace {
+
+    struct ThreadStats;
+
+    // Counters of exited threads and the blocks of live ones
+    struct StatsRegistry {
+        mutex lock;
+        vector<ThreadStats*> threads;
+        LargeNumberStatsSnapshot retired = {};
+
+        // Totals at the last resetStats(), subtracted by getStats(), and the count of resets
+        LargeNumberStatsSnapshot baseline = {};
+        atomic<uint64_t> generation{ 0 };
+    };
+
+    // Never destroyed, for the same reason as the NodePool registry: worker threads
+    // retire their counters as they exit
+    StatsRegistry& registry() {
+        static StatsRegistry* instance = new StatsRegistry();
+        return *instance;
+    }
+
+    // Add to a counter that only its owning thread writes
+    inline void bump(atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(memory_order_relaxed) + amount, memory_order_relaxed);
+    }
+
+    // One operation's counters in a thread's block
+    struct OperationCounters {
+        atomic<uint64_t> calls{ 0 };
+        atomic<uint64_t> limbs{ 0 };
+        atomic<uint64_t> totalNanoseconds{ 0 };
+        atomic<uint64_t> maxNanoseconds{ 0 };
+        atomic<uint64_t> maxGeneration{ 0 }; // Reset generation maxNanoseconds belongs to
+        atomic<uint64_t> buckets[OperationStats::BUCKETS] = {};
+    };
+
+    // Add one thread's block into a snapshot, leaving out slowest calls from before the
+    // given generation
+    void addInto(LargeNumberStatsSnapshot& stats, const atomic<uint64_t>* counters, const OperationCounters* operations,
+        uint64_t generation) {
+        for (int i = 0; i < LargeNumberStatsSnapshot::COUNTERS; i++) {
+            stats.counters[i] += counters[i].load(memory_order_relaxed);
+        }
+        for (int i = 0; i < LargeNumberStatsSnapshot::OPERATIONS; i++) {
+            OperationStats& total = stats.operations[i];
+            const OperationCounters& source = operations[i];
+            total.calls += source.calls.load(memory_order_relaxed);
+            total.limbs += source.limbs.load(memory_order_relaxed);
+            total.totalNanoseconds += source.totalNanoseconds.load(memory_order_relaxed);
+            if (source.maxGeneration.load(memory_order_relaxed) == generation) {
+                total.maxNanoseconds = max(total.maxNanoseconds, source.maxNanoseconds.load(memory_order_relaxed));
+            }
+            for (int b = 0; b < OperationStats::BUCKETS; b++) {
+                total.buckets[b] += source.buckets[b].load(memory_order_relaxed);
+            }
+        }
+    }
+
+    // Take a baseline out of a snapshot (the slowest call is already current)
+    void subtractFrom(LargeNumberStatsSnapshot& stats, const LargeNumberStatsSnapshot& baseline) {
+        for (int i = 0; i < LargeNumberStatsSnapshot::COUNTERS; i++) {
+            stats.counters[i] -= baseline.counters[i];
+        }
+        for (int i = 0; i < LargeNumberStatsSnapshot::OPERATIONS; i++) {
+            OperationStats& total = stats.operations[i];
+            const OperationStats& before = baseline.operations[i];
+            total.calls -= before.calls;
+            total.limbs -= before.limbs;
+            total.totalNanoseconds -= before.totalNanoseconds;
+            for (int b = 0; b < OperationStats::BUCKETS; b++) {
+                total.buckets[b] -= before.buckets[b];
+            }
+        }
+    }
+
+    // Per-thread counters, registered while the thread runs
+    struct ThreadStats {
+        atomic<uint64_t> counters[LargeNumberStatsSnapshot::COUNTERS] = {};
+        OperationCounters operations[LargeNumberStatsSnapshot::OPERATIONS];
+
+        ThreadStats() {
+            StatsRegistry& shared = registry();
+            lock_guard<mutex> guard(shared.lock);
+            shared.threads.push_back(this);
+        }
+
+        ~ThreadStats() {
+            StatsRegistry& shared = registry();
+            lock_guard<mutex> guard(shared.lock);
+            addInto(shared.retired, counters, operations, shared.generation.load(memory_order_relaxed));
+            shared.threads.erase(find(shared.threads.begin(), shared.threads.end(), this));
+        }
+    };
+
+    // Sum the retired counters and every live thread's block (the registry lock must be held)
+    LargeNumberStatsSnapshot totals(const StatsRegistry& shared) {
+        LargeNumberStatsSnapshot stats = shared.retired;
+        uint64_t generation = shared.generation.load(memory_order_relaxed);
+        for (ThreadStats* thread : shared.threads) {
+            addInto(stats, thread->counters, thread->operations, generation);
+        }
+        return stats;
+    }
+
+    ThreadStats& localStats() {
+        thread_local ThreadStats stats;
+        return stats;
+    }
+
+    // Histogram bucket of a duration: the position of its highest set bit
+    int bucketOf(uint64_t nanoseconds) {
+        int bucket = 0;
+        while (nanoseconds > 1 && bucket < OperationStats::BUCKETS - 1) {
+            nanoseconds >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+}
+
+// Upper bound of the bucket where the given fraction of calls is reached
+uint64_t OperationStats::percentileNanoseconds(double fraction) const {
+    if (calls == 0) {
+        return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(ceil(fraction * static_cast<double>(calls)));
+    target = target < 1 ? 1 : (target > calls ? calls : target);
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; b++) {
+        seen += buckets[b];
+        if (seen >= target) {
+            return min(static_cast<uint64_t>(2) << b, maxNanoseconds);
+        }
+    }
+    return maxNanoseconds;
+}
+
+// Get a plain counter
+uint64_t LargeNumberStatsSnapshot::counter(LargeNumberCounter which) const {
+    return counters[static_cast<int>(which)];
+}
+
+// Get one operation's statistics
+const OperationStats& LargeNumberStatsSnapshot::operation(LargeNumberOperation which) const {
+    return operations[static_cast<int>(which)];
+}
+
+// Report whether recording was compiled in
+bool LargeNumberStats::isEnabled() {
+#ifdef LARGE_NUMBER_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Sum the retired counters and every live thread's block, less the baseline
+LargeNumberStatsSnapshot LargeNumberStats::getStats() {
+    StatsRegistry& shared = registry();
+    LargeNumberStatsSnapshot stats;
+    {
+        lock_guard<mutex> guard(shared.lock);
+        stats = totals(shared);
+        subtractFrom(stats, shared.baseline);
+    }
+    NodePoolStats nodes = NodePool::getStats();
+    stats.enabled = isEnabled();
+    stats.nodesAllocated = nodes.nodesAllocated;
+    stats.nodesReleased = nodes.nodesReleased;
+    return stats;
+}
+
+// Zero every counter; each thread's counters are written only by that thread, so the
+// current totals are recorded and subtracted instead
+void LargeNumberStats::resetStats() {
+    StatsRegistry& shared = registry();
+    {
+        lock_guard<mutex> guard(shared.lock);
+        shared.baseline = totals(shared);
+        shared.generation.fetch_add(1, memory_order_relaxed);
+        for (OperationStats& operation : shared.retired.operations) {
+            operation.maxNanoseconds = 0;
+        }
+    }
+    NodePool::resetStats();
+}
+
+// Write the node counters, the lookup counters, and one line per operation
+void LargeNumberStats::print(const LargeNumberStatsSnapshot& stats, ostream& os) {
+    ios::fmtflags flags = os.flags();
+    streamsize precision = os.precision();
+    os << "Nodes allocated: " << stats.nodesAllocated << ", released: " << stats.nodesReleased << "\n";
+    if (!stats.enabled) {
+        os << "Operation statistics are off; build with LARGE_NUMBER_STATS to collect them" << endl;
+        return;
+    }
+
+    uint64_t lookups = stats.counter(LargeNumberCounter::Lookups);
+    uint64_t hops = stats.counter(LargeNumberCounter::LookupHops);
+    os << "Node lookups: " << lookups << ", tree levels per lookup: " << fixed << setprecision(2)
+        << (lookups > 0 ? static_cast<double>(hops) / lookups : 0.0) << "\n";
+    os << left << setw(10) << "operation" << right << setw(12) << "calls" << setw(14) << "limbs/call"
+        << setw(12) << "mean ns" << setw(12) << "p50 ns" << setw(12) << "p99 ns" << setw(14) << "max ns" << "\n";
+    for (int i = 0; i < LargeNumberStatsSnapshot::OPERATIONS; i++) {
+        const OperationStats& operation = stats.operations[i];
+        double calls = operation.calls > 0 ? static_cast<double>(operation.calls) : 1.0;
+        os << left << setw(10) << getOperationName(static_cast<LargeNumberOperation>(i)) << right
+            << setw(12) << operation.calls << setprecision(1)
+            << setw(14) << operation.limbs / calls
+            << setw(12) << operation.totalNanoseconds / calls
+            << setw(12) << operation.percentileNanoseconds(0.5)
+            << setw(12) << operation.percentileNanoseconds(0.99)
+            << setw(14) << operation.maxNanoseconds << "\n";
+    }
+    os.flush();
+    os.flags(flags);
+    os.precision(precision);
+}
+
+// Get the name of an operation
+const char* LargeNumberStats::getOperationName(LargeNumberOperation operation) {
+    switch (operation) {
+    case LargeNumberOperation::Add:
+        return "add";
+    case LargeNumberOperation::Subtract:
+        return "subtract";
+    case LargeNumberOperation::Compare:
+        return "compare";
+    case LargeNumberOperation::Parse:
+        return "parse";
+    case LargeNumberOperation::Print:
+        return "print";
+    }
+    return "unknown";
+}
+
+// Add to a plain counter of this thread
+void LargeNumberStats::add(LargeNumberCounter counter, uint64_t amount) {
+    bump(localStats().counters[static_cast<int>(counter)], amount);
+}
+
+// Record one call of an operation in this thread's block
+void LargeNumberStats::record(LargeNumberOperation operation, uint64_t limbs, uint64_t nanoseconds) {
+    OperationCounters& counters = localStats().operations[static_cast<int>(operation)];
+    bump(counters.calls, 1);
+    bump(counters.limbs, limbs);
+    bump(counters.totalNanoseconds, nanoseconds);
+    bump(counters.buckets[bucketOf(nanoseconds)], 1);
+
+    // The first call after a reset starts the slowest call over
+    uint64_t generation = registry().generation.load(memory_order_relaxed);
+    if (counters.maxGeneration.load(memory_order_relaxed) != generation) {
+        counters.maxNanoseconds.store(nanoseconds, memory_order_relaxed);
+        counters.maxGeneration.store(generation, memory_order_relaxed);
+    }
+    else if (nanoseconds > counters.maxNanoseconds.load(memory_order_relaxed)) {
+        counters.maxNanoseconds.store(nanoseconds, memory_order_relaxed);
+    }
+}
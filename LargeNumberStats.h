@@ -0,0 +1,127 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the LargeNumberStats class, which
+    collects hot-path statistics for LargeNumber: BlockIndex
+    lookups and the tree levels they descend, and for +, -,
+    magnitude comparison, parsing, and printing the number of
+    calls, the limbs they touched, and a latency histogram with
+    power-of-two nanosecond buckets. Node allocations and frees
+    come from the NodePool counters. Recording only happens when
+    LARGE_NUMBER_STATS is defined (the CMake option of the same
+    name); otherwise the recording macros expand to nothing, so
+    the hot paths carry no trace of it, and the snapshot holds
+    only the NodePool counters.
+    This file requires <chrono>, <cstddef>, <cstdint>, and
+    <iostream>.
+-------------------------------------------------- */
+
+#ifndef LARGE_NUMBER_STATS_H
+#define LARGE_NUMBER_STATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+// Timed LargeNumber operations
+enum class LargeNumberOperation {
+    Add,
+    Subtract,
+    Compare,
+    Parse,
+    Print
+};
+
+// Plain counters
+enum class LargeNumberCounter {
+    Lookups,    // getNodeAtPosition() calls
+    LookupHops  // BlockIndex levels descended by those calls
+};
+
+// Calls, limbs, and latencies of one operation
+struct OperationStats {
+    static const int BUCKETS = 40; // Bucket i counts calls taking [2^i, 2^(i+1)) ns; bucket 0 also takes 0 ns
+
+    uint64_t calls;
+    uint64_t limbs;
+    uint64_t totalNanoseconds;
+    uint64_t maxNanoseconds;
+    uint64_t buckets[BUCKETS];
+
+    // Upper bound of the bucket holding the given fraction of calls (0 with no calls)
+    uint64_t percentileNanoseconds(double fraction) const;
+};
+
+// Everything recorded so far
+struct LargeNumberStatsSnapshot {
+    static const int OPERATIONS = 5;
+    static const int COUNTERS = 2;
+
+    bool enabled;
+    size_t nodesAllocated;
+    size_t nodesReleased;
+    uint64_t counters[COUNTERS];
+    OperationStats operations[OPERATIONS];
+
+    uint64_t counter(LargeNumberCounter which) const;
+    const OperationStats& operation(LargeNumberOperation which) const;
+};
+
+class LargeNumberStats {
+public:
+
+    // Whether recording was compiled in
+    static bool isEnabled();
+
+    // Sum the counters of every thread
+    static LargeNumberStatsSnapshot getStats();
+
+    // Zero every counter, the NodePool counters included
+    static void resetStats();
+
+    // Write a readable table of a snapshot
+    static void print(const LargeNumberStatsSnapshot& stats, std::ostream& os);
+
+    // Names used by print()
+    static const char* getOperationName(LargeNumberOperation operation);
+
+    // Recording, reached only through the macros below
+    static void add(LargeNumberCounter counter, uint64_t amount);
+    static void record(LargeNumberOperation operation, uint64_t limbs, uint64_t nanoseconds);
+
+    // Record one operation's duration when it goes out of scope
+    class Timer {
+    public:
+        Timer(LargeNumberOperation operation, uint64_t limbs)
+            : operation(operation), limbs(limbs), start(std::chrono::steady_clock::now()) {
+        }
+        ~Timer() {
+            std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+            record(operation, limbs, static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+    private:
+        LargeNumberOperation operation;
+        uint64_t limbs;
+        std::chrono::steady_clock::time_point start;
+    };
+
+private:
+    LargeNumberStats() = delete;
+};
+
+// Recording hooks for the hot paths; arguments are not evaluated when disabled
+#ifdef LARGE_NUMBER_STATS
+#define LARGE_NUMBER_STATS_TIME(operation, limbs) LargeNumberStats::Timer largeNumberStatsTimer((operation), (limbs))
+#define LARGE_NUMBER_STATS_ADD(counter, amount) LargeNumberStats::add((counter), (amount))
+#else
+#define LARGE_NUMBER_STATS_TIME(operation, limbs) ((void)0)
+#define LARGE_NUMBER_STATS_ADD(counter, amount) ((void)0)
+#endif
+
+#endif // LARGE_NUMBER_STATS_H
@@ -0,0 +1,314 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the LimbKernels class defined in
+    LimbKernels.h. The vector kernels work in two passes. The
+    first adds (or subtracts) whole vectors, wraps each lane back
+    below 10^18 with a compare and mask instead of a division,
+    and moves each lane's carry up one lane. The result can only
+    be wrong where a lane landed exactly on 10^18 (or -1 for
+    subtraction), so a second scalar pass runs only when the
+    first one saw such a lane. Leftover limbs that do not fill
+    a vector go through the scalar loop.
+    It requires LimbKernels.h, <atomic>, and <cstring> to run,
+    plus <immintrin.h> on x86-64.
+-------------------------------------------------- */
+
+#include "LimbKernels.h"
+#include <atomic> // For the active kernel set (atomic)
+#include <cstring> // For block copies (memcpy())
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define LIMB_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h> // For CPU feature detection (__cpuid() and _xgetbv())
+#endif
+#else
+#define LIMB_KERNELS_X86 0
+#endif
+
+// GCC and Clang compile each vector kernel for its own instruction set; MSVC needs no attribute
+#if LIMB_KERNELS_X86 && (defined(__GNUC__) || defined(__clang__))
+#define LIMB_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define LIMB_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define LIMB_TARGET_SSE42
+#define LIMB_TARGET_AVX2
+#endif
+
+using namespace std;
+
+namespace {
+
+    const uint64_t BASE = 1000000000000000000ULL;
+
+    uint64_t addScalar(uint64_t* out, const uint64_t* a, const uint64_t* b, int count, uint64_t carry) {
+        for (int i = 0; i < count; i++) {
+            uint64_t sum = a[i] + b[i] + carry;
+            carry = sum >= BASE ? 1 : 0;
+            out[i] = carry ? sum - BASE : sum;
+        }
+        return carry;
+    }
+
+    uint64_t subtractScalar(uint64_t* out, const uint64_t* a, const uint64_t* b, int count, uint64_t borrow) {
+        for (int i = 0; i < count; i++) {
+            uint64_t subtrahend = b[i] + borrow;
+            borrow = a[i] < subtrahend ? 1 : 0;
+            out[i] = borrow ? a[i] + BASE - subtrahend : a[i] - subtrahend;
+        }
+        return borrow;
+    }
+
+    // Second pass after vector addition: limbs equal to BASE carry into the next limb
+    uint64_t resolveCarries(uint64_t* out, int count) {
+        uint64_t carry = 0;
+        for (int i = 0; i < count; i++) {
+            uint64_t value = out[i] + carry;
+            carry = value >= BASE ? 1 : 0;
+            out[i] = carry ? value - BASE : value;
+        }
+        return carry;
+    }
+
+    // Second pass after vector subtraction: limbs equal to -1 borrow from the next limb
+    uint64_t resolveBorrows(uint64_t* out, int count) {
+        uint64_t borrow = 0;
+        for (int i = 0; i < count; i++) {
+            int64_t value = static_cast<int64_t>(out[i]) - static_cast<int64_t>(borrow);
+            borrow = value < 0 ? 1 : 0;
+            out[i] = static_cast<uint64_t>(borrow ? value + static_cast<int64_t>(BASE) : value);
+        }
+        return borrow;
+    }
+
+#if LIMB_KERNELS_X86
+
+    // Two limbs per step; lane carries move up with a byte shift across the previous vector
+    LIMB_TARGET_SSE42 uint64_t addSse42(uint64_t* out, const uint64_t* a, const uint64_t* b, int count, uint64_t carry) {
+        const __m128i base = _mm_set1_epi64x(static_cast<long long>(BASE));
+        const __m128i top = _mm_set1_epi64x(static_cast<long long>(BASE - 1));
+        __m128i previous = _mm_set_epi64x(static_cast<long long>(carry), 0);
+        __m128i ripple = _mm_setzero_si128();
+        int i = 0;
+        for (; i + 2 <= count; i += 2) {
+            __m128i sum = _mm_add_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+            __m128i overflow = _mm_cmpgt_epi64(sum, top);
+            sum = _mm_sub_epi64(sum, _mm_and_si128(overflow, base));
+            __m128i lanes = _mm_srli_epi64(overflow, 63);
+            sum = _mm_add_epi64(sum, _mm_alignr_epi8(lanes, previous, 8));
+            previous = lanes;
+            ripple = _mm_or_si128(ripple, _mm_cmpeq_epi64(sum, base));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), sum);
+        }
+        carry = static_cast<uint64_t>(_mm_extract_epi64(previous, 1));
+        if (!_mm_testz_si128(ripple, ripple)) {
+            carry += resolveCarries(out, i);
+        }
+        return addScalar(out + i, a + i, b + i, count - i, carry);
+    }
+
+    LIMB_TARGET_SSE42 uint64_t subtractSse42(uint64_t* out, const uint64_t* a, const uint64_t* b, int count, uint64_t borrow) {
+        const __m128i base = _mm_set1_epi64x(static_cast<long long>(BASE));
+        const __m128i negativeOne = _mm_set1_epi64x(-1);
+        __m128i previous = _mm_set_epi64x(static_cast<long long>(borrow), 0);
+        __m128i ripple = _mm_setzero_si128();
+        int i = 0;
+        for (; i + 2 <= count; i += 2) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i underflow = _mm_cmpgt_epi64(y, x);
+            __m128i difference = _mm_add_epi64(_mm_sub_epi64(x, y), _mm_and_si128(underflow, base));
+            __m128i lanes = _mm_srli_epi64(underflow, 63);
+            difference = _mm_sub_epi64(difference, _mm_alignr_epi8(lanes, previous, 8));
+            previous = lanes;
+            ripple = _mm_or_si128(ripple, _mm_cmpeq_epi64(difference, negativeOne));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), difference);
+        }
+        borrow = static_cast<uint64_t>(_mm_extract_epi64(previous, 1));
+        if (!_mm_testz_si128(ripple, ripple)) {
+            borrow += resolveBorrows(out, i);
+        }
+        return subtractScalar(out + i, a + i, b + i, count - i, borrow);
+    }
+
+    // Four limbs per step; lane carries rotate up one lane and lane 0 takes the previous top carry
+    LIMB_TARGET_AVX2 uint64_t addAvx2(uint64_t* out, const uint64_t* a, const uint64_t* b, int count, uint64_t carry) {
+        const __m256i base = _mm256_set1_epi64x(static_cast<long long>(BASE));
+        const __m256i top = _mm256_set1_epi64x(static_cast<long long>(BASE - 1));
+        __m256i previous = _mm256_set_epi64x(0, 0, 0, static_cast<long long>(carry));
+        __m256i ripple = _mm256_setzero_si256();
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m256i sum = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+            __m256i overflow = _mm256_cmpgt_epi64(sum, top);
+            sum = _mm256_sub_epi64(sum, _mm256_and_si256(overflow, base));
+            __m256i rotated = _mm256_permute4x64_epi64(_mm256_srli_epi64(overflow, 63), _MM_SHUFFLE(2, 1, 0, 3));
+            sum = _mm256_add_epi64(sum, _mm256_blend_epi32(rotated, previous, 0x03));
+            previous = rotated;
+            ripple = _mm256_or_si256(ripple, _mm256_cmpeq_epi64(sum, base));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), sum);
+        }
+        carry = static_cast<uint64_t>(_mm_cvtsi128_si64(_mm256_castsi256_si128(previous)));
+        if (!_mm256_testz_si256(ripple, ripple)) {
+            carry += resolveCarries(out, i);
+        }
+        return addScalar(out + i, a + i, b + i, count - i, carry);
+    }
+
+    LIMB_TARGET_AVX2 uint64_t subtractAvx2(uint64_t* out, const uint64_t* a, const uint64_t* b, int count, uint64_t borrow) {
+        const __m256i base = _mm256_set1_epi64x(static_cast<long long>(BASE));
+        const __m256i negativeOne = _mm256_set1_epi64x(-1);
+        __m256i previous = _mm256_set_epi64x(0, 0, 0, static_cast<long long>(borrow));
+        __m256i ripple = _mm256_setzero_si256();
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            __m256i underflow = _mm256_cmpgt_epi64(y, x);
+            __m256i difference = _mm256_add_epi64(_mm256_sub_epi64(x, y), _mm256_and_si256(underflow, base));
+            __m256i rotated = _mm256_permute4x64_epi64(_mm256_srli_epi64(underflow, 63), _MM_SHUFFLE(2, 1, 0, 3));
+            difference = _mm256_sub_epi64(difference, _mm256_blend_epi32(rotated, previous, 0x03));
+            previous = rotated;
+            ripple = _mm256_or_si256(ripple, _mm256_cmpeq_epi64(difference, negativeOne));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), difference);
+        }
+        borrow = static_cast<uint64_t>(_mm_cvtsi128_si64(_mm256_castsi256_si128(previous)));
+        if (!_mm256_testz_si256(ripple, ripple)) {
+            borrow += resolveBorrows(out, i);
+        }
+        return subtractScalar(out + i, a + i, b + i, count - i, borrow);
+    }
+
+    // Query the processor and the operating system's saved register state
+    bool supports(LimbKernelSet kernelSet) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 1);
+        bool sse42 = (info[2] & (1 << 20)) != 0;
+        bool avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+        __cpuidex(info, 7, 0);
+        bool avx2 = avx && (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        bool sse42 = __builtin_cpu_supports("sse4.2") != 0;
+        bool avx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+        switch (kernelSet) {
+        case LimbKernelSet::AVX2:
+            return avx2;
+        case LimbKernelSet::SSE42:
+            return sse42;
+        default:
+            return true;
+        }
+    }
+
+#else
+
+    bool supports(LimbKernelSet kernelSet) {
+        return kernelSet == LimbKernelSet::Scalar;
+    }
+
+#endif
+
+    atomic<LimbKernelSet>& activeKernelSet() {
+        static atomic<LimbKernelSet> active{ LimbKernels::detectKernelSet() };
+        return active;
+    }
+}
+
+uint64_t LimbKernels::add(uint64_t* out, const uint64_t* a, const uint64_t* b, int count, uint64_t carry) {
+#if LIMB_KERNELS_X86
+    switch (activeKernelSet().load(memory_order_relaxed)) {
+    case LimbKernelSet::AVX2:
+        return addAvx2(out, a, b, count, carry);
+    case LimbKernelSet::SSE42:
+        return addSse42(out, a, b, count, carry);
+    default:
+        break;
+    }
+#endif
+    return addScalar(out, a, b, count, carry);
+}
+
+// Propagate the carry until it dies out, then copy the rest
+uint64_t LimbKernels::addCarry(uint64_t* out, const uint64_t* a, int count, uint64_t carry) {
+    int i = 0;
+    for (; i < count && carry; i++) {
+        uint64_t sum = a[i] + carry;
+        carry = sum >= BASE ? 1 : 0;
+        out[i] = carry ? sum - BASE : sum;
+    }
+    if (out != a && i < count) {
+        memcpy(out + i, a + i, (count - i) * sizeof(uint64_t));
+    }
+    return carry;
+}
+
+uint64_t LimbKernels::subtract(uint64_t* out, const uint64_t* a, const uint64_t* b, int count, uint64_t borrow) {
+#if LIMB_KERNELS_X86
+    switch (activeKernelSet().load(memory_order_relaxed)) {
+    case LimbKernelSet::AVX2:
+        return subtractAvx2(out, a, b, count, borrow);
+    case LimbKernelSet::SSE42:
+        return subtractSse42(out, a, b, count, borrow);
+    default:
+        break;
+    }
+#endif
+    return subtractScalar(out, a, b, count, borrow);
+}
+
+// Propagate the borrow until it dies out, then copy the rest
+uint64_t LimbKernels::subtractBorrow(uint64_t* out, const uint64_t* a, int count, uint64_t borrow) {
+    int i = 0;
+    for (; i < count && borrow; i++) {
+        uint64_t value = a[i];
+        out[i] = value < borrow ? value + BASE - borrow : value - borrow;
+        borrow = value < borrow ? 1 : 0;
+    }
+    if (out != a && i < count) {
+        memcpy(out + i, a + i, (count - i) * sizeof(uint64_t));
+    }
+    return borrow;
+}
+
+// Fastest kernel set this processor supports
+LimbKernelSet LimbKernels::detectKernelSet() {
+    if (supports(LimbKernelSet::AVX2)) {
+        return LimbKernelSet::AVX2;
+    }
+    if (supports(LimbKernelSet::SSE42)) {
+        return LimbKernelSet::SSE42;
+    }
+    return LimbKernelSet::Scalar;
+}
+
+LimbKernelSet LimbKernels::getKernelSet() {
+    return activeKernelSet().load(memory_order_relaxed);
+}
+
+// Switch kernel sets, refusing one the processor cannot run
+bool LimbKernels::setKernelSet(LimbKernelSet kernelSet) {
+    if (!supports(kernelSet)) {
+        return false;
+    }
+    activeKernelSet().store(kernelSet, memory_order_relaxed);
+    return true;
+}
+
+const char* LimbKernels::getKernelSetName(LimbKernelSet kernelSet) {
+    switch (kernelSet) {
+    case LimbKernelSet::AVX2:
+        return "AVX2";
+    case LimbKernelSet::SSE42:
+        return "SSE4.2";
+    default:
+        return "Scalar";
+    }
+}
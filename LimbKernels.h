@@ -0,0 +1,53 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the LimbKernels class, which adds
+    and subtracts runs of base 10^18 limbs (least significant
+    first) for LargeNumber. On x86 processors the vector kernels
+    handle four (AVX2) or two (SSE4.2) limbs per instruction and
+    resolve carries and borrows in a separate pass; the scalar
+    kernels are the fallback everywhere else. The fastest kernel
+    set the processor supports is picked at run time and can be
+    overridden for benchmarking.
+    This file requires <cstdint>.
+-------------------------------------------------- */
+
+#ifndef LIMB_KERNELS_H
+#define LIMB_KERNELS_H
+
+#include <cstdint>
+
+// Instruction sets the kernels are compiled for
+enum class LimbKernelSet {
+    Scalar,
+    SSE42,
+    AVX2
+};
+
+class LimbKernels {
+public:
+
+    // Add two runs of limbs with an incoming carry, returning the outgoing carry
+    static uint64_t add(uint64_t* out, const uint64_t* a, const uint64_t* b, int count, uint64_t carry);
+
+    // Copy a run of limbs while propagating a carry
+    static uint64_t addCarry(uint64_t* out, const uint64_t* a, int count, uint64_t carry);
+
+    // Subtract two runs of limbs with an incoming borrow, returning the outgoing borrow
+    static uint64_t subtract(uint64_t* out, const uint64_t* a, const uint64_t* b, int count, uint64_t borrow);
+
+    // Copy a run of limbs while propagating a borrow
+    static uint64_t subtractBorrow(uint64_t* out, const uint64_t* a, int count, uint64_t borrow);
+
+    // Kernel set selection
+    static LimbKernelSet detectKernelSet();
+    static LimbKernelSet getKernelSet();
+    static bool setKernelSet(LimbKernelSet kernelSet);
+    static const char* getKernelSetName(LimbKernelSet kernelSet);
+
+private:
+    LimbKernels() = delete;
+};
+
+#endif // LIMB_KERNELS_H
@@ -6,16 +6,85 @@
     as the entry point for the large number arithmetic
     calculator program. It creates an instance of the
     ProgramManager class and calls its run method to
-    start the program.
-    It requires Main.h to run.
+    start the program. Started as "--batch [file]", it
+    runs operations from the file (or standard input)
+    without the menu instead, reporting throughput on
+    standard error; "--batch --stats [file]" also writes
+    the LargeNumber statistics there at the end,
+    "--batch --pipeline [file]" overlaps parsing, arithmetic,
+    and output on separate threads, and "--batch --cache [file]"
+    answers repeated products from a ResultCache.
+    It requires Main.h, NumberInterner.h, ResultCache.h,
+    <cstring>, <fstream>, and <iostream> to run.
 -------------------------------------------------- */
 
 #include "Main.h"
+#include "NumberInterner.h"
+#include "ResultCache.h"
+#include <cstring> // For argument comparison (strcmp() and strncmp())
+#include <fstream> // For batch files (ifstream)
+#include <iostream>
 
-int main() {
+using namespace std;
 
-    // Create and run program manager
+int main(int argc, char* argv[]) {
+
+    // Create program manager
     ProgramManager programManager;
+
+    // Run a batch from a file or standard input, optionally pipelined, cached, or dumping statistics afterward
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0) {
+        ios::sync_with_stdio(false);
+        bool statistics = false;
+        bool pipelined = false;
+        bool cached = false;
+        const char* path = nullptr;
+        for (int i = 2; i < argc; i++) {
+            if (strcmp(argv[i], "--stats") == 0) {
+                statistics = true;
+            }
+            else if (strcmp(argv[i], "--pipeline") == 0) {
+                pipelined = true;
+            }
+            else if (strcmp(argv[i], "--cache") == 0) {
+                cached = true;
+            }
+            else if (path == nullptr && strncmp(argv[i], "--", 2) != 0) {
+                path = argv[i];
+            }
+            else {
+                cerr << "Usage: " << argv[0] << " [--batch [--stats] [--pipeline] [--cache] [file]]" << endl;
+                return 1;
+            }
+        }
+        ifstream file;
+        if (path != nullptr) {
+            file.open(path);
+            if (!file) {
+                cerr << "Could not open " << path << endl;
+                return 1;
+            }
+        }
+        istream& input = path != nullptr ? static_cast<istream&>(file) : cin;
+        NumberInterner interner;
+        ResultCache cache(ResultCache::DEFAULT_MAX_BYTES, &interner);
+        if (cached) {
+            ResultCache::install(&cache);
+        }
+        size_t errors = pipelined ? programManager.runPipelinedBatch(input, cout, cerr)
+            : programManager.runBatch(input, cout, cerr);
+        if (statistics) {
+            programManager.printStatistics(cerr);
+        }
+        ResultCache::install(nullptr);
+        return errors == 0 ? 0 : 1;
+    }
+    else if (argc > 1) {
+        cerr << "Usage: " << argv[0] << " [--batch [--stats] [--pipeline] [--cache] [file]]" << endl;
+        return 1;
+    }
+
+    // Run the interactive menu
     programManager.run();
     return 0;
-}
\ No newline at end of file
+}
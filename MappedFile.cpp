@@ -0,0 +1,105 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the MappedFile class defined in
+    MappedFile.h. The file is opened, mapped in full, and
+    closed again right away, since the mapping keeps its own
+    reference to the file. Sequential access is advised where
+    the system supports it so the kernel reads ahead.
+    It requires MappedFile.h, <stdexcept>, and either the POSIX
+    headers <fcntl.h>, <sys/mman.h>, <sys/stat.h>, and
+    <unistd.h> or <windows.h> to run.
+-------------------------------------------------- */
+
+#include "MappedFile.h"
+#include <stdexcept> // For exceptions (runtime_error)
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h> // For opening the file (open())
+#include <sys/mman.h> // For the mapping (mmap() and madvise())
+#include <sys/stat.h> // For the file size (fstat())
+#include <unistd.h> // For closing the file (close())
+#endif
+
+using namespace std;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const string& path) : bytes(nullptr), length(0), mapping(nullptr) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw runtime_error("Could not open " + path);
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        throw runtime_error("Could not read the size of " + path);
+    }
+    length = static_cast<size_t>(fileSize.QuadPart);
+
+    // An empty file cannot be mapped, and needs no mapping
+    if (length > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            bytes = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+        if (!bytes) {
+            if (mapping) {
+                CloseHandle(mapping);
+            }
+            CloseHandle(file);
+            throw runtime_error("Could not map " + path);
+        }
+    }
+    CloseHandle(file);
+}
+
+MappedFile::~MappedFile() {
+    if (bytes) {
+        UnmapViewOfFile(bytes);
+    }
+    if (mapping) {
+        CloseHandle(mapping);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const string& path) : bytes(nullptr), length(0), mapping(nullptr) {
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        throw runtime_error("Could not open " + path);
+    }
+    struct stat status;
+    if (fstat(file, &status) != 0) {
+        close(file);
+        throw runtime_error("Could not read the size of " + path);
+    }
+    length = static_cast<size_t>(status.st_size);
+
+    // An empty file cannot be mapped, and needs no mapping
+    if (length > 0) {
+        void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, 0);
+        if (address == MAP_FAILED) {
+            close(file);
+            throw runtime_error("Could not map " + path);
+        }
+        madvise(address, length, MADV_SEQUENTIAL);
+        bytes = static_cast<const char*>(address);
+    }
+    close(file);
+}
+
+MappedFile::~MappedFile() {
+    if (bytes) {
+        munmap(const_cast<char*>(bytes), length);
+    }
+}
+
+#endif
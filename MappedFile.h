@@ -0,0 +1,39 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the MappedFile class, a read-only
+    memory mapping of a whole file. LargeNumber parses digit
+    files straight out of the mapping, so loading a number
+    never holds a second copy of its text in memory. The
+    mapping is released when the object is destroyed. It uses
+    mmap on POSIX systems and file mapping objects on Windows.
+    This file requires <cstddef> and <string>.
+-------------------------------------------------- */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+class MappedFile {
+public:
+
+    // Map a file for reading (throws runtime_error if it cannot be opened or mapped)
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Mapped bytes (null for an empty file)
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const char* bytes;
+    size_t length;
+    void* mapping; // Windows mapping object handle
+};
+
+#endif // MAPPED_FILE_H
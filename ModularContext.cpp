@@ -0,0 +1,337 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the ModularContext class defined in
+    ModularContext.h. Montgomery multiplication interleaves the
+    product with the reduction word by word (the CIOS method) in
+    base 10^9, so R is a power of 10^9 and the modulus must be
+    coprime to 10; values enter the Montgomery domain through one
+    multiplication by R^2 and leave it through one by 1. Barrett
+    reduction multiplies the top words of a product by a
+    precomputed reciprocal of the modulus to estimate the quotient,
+    which is never more than two too small, so at most two
+    subtractions finish the remainder. Exponentiation converts the
+    exponent to binary 30 bits at a time, picks a window width from
+    its length, and then needs one squaring per bit plus one
+    multiplication per window.
+    It requires ModularContext.h, Division.h, Multiplication.h,
+    WordArithmetic.h, <algorithm>, and <stdexcept> to run.
+-------------------------------------------------- */
+
+#include "ModularContext.h"
+#include "Division.h"
+#include "Multiplication.h"
+#include "WordArithmetic.h"
+#include <algorithm> // For window bounds (max())
+#include <stdexcept> // For exceptions (domain_error and invalid_argument)
+
+using namespace std;
+
+const size_t ModularContext::MONTGOMERY_MAX_WORDS;
+
+// Exponent bits produced by each conversion step
+static const int EXPONENT_CHUNK_BITS = 30;
+
+// Least significant bit first binary digits of a magnitude
+static vector<uint8_t> binaryDigits(Words words) {
+    vector<uint8_t> bits;
+    WordArithmetic::trim(words);
+    Words quotient;
+    while (!words.empty()) {
+        uint32_t chunk = WordArithmetic::divideSmall(words, 1u << EXPONENT_CHUNK_BITS, quotient);
+        words.swap(quotient);
+        for (int bit = 0; bit < EXPONENT_CHUNK_BITS; bit++) {
+            bits.push_back(static_cast<uint8_t>((chunk >> bit) & 1));
+        }
+    }
+    while (!bits.empty() && bits.back() == 0) {
+        bits.pop_back();
+    }
+    return bits;
+}
+
+// Window width that minimizes multiplications for an exponent of the given length
+static int windowWidth(size_t bits) {
+    if (bits <= 24) {
+        return 1;
+    }
+    if (bits <= 80) {
+        return 3;
+    }
+    if (bits <= 240) {
+        return 4;
+    }
+    if (bits <= 672) {
+        return 5;
+    }
+    if (bits <= 1792) {
+        return 6;
+    }
+    return 7;
+}
+
+// Build a context, picking the reduction from the modulus
+ModularContext::ModularContext(const LargeNumber& modulus)
+    : ModularContext(modulus, selectReduction(modulus)) {
+}
+
+// Build a context with a fixed reduction
+ModularContext::ModularContext(const LargeNumber& modulus, ModularReduction reduction)
+    : modulusNumber(modulus), modulus(modulus.toWords()), length(0), reduction(reduction), inverse(0) {
+    WordArithmetic::trim(this->modulus);
+    if (modulus.isNegative() || this->modulus.empty()) {
+        throw domain_error("Modulus must be positive");
+    }
+    length = this->modulus.size();
+    if (reduction == ModularReduction::Montgomery && (this->modulus[0] % 2 == 0 || this->modulus[0] % 5 == 0)) {
+        throw invalid_argument("Montgomery reduction needs a modulus coprime to 10");
+    }
+    prepare();
+}
+
+// Precompute the constants of the chosen reduction
+void ModularContext::prepare() {
+    const uint64_t base = WordArithmetic::BASE;
+    Words quotient;
+    if (reduction == ModularReduction::Montgomery) {
+
+        // Invert the low word modulo 10, then let Newton's iteration double the correct digits
+        uint64_t low = modulus[0];
+        uint64_t value = 1;
+        while (low * value % 10 != 1) {
+            value += 2;
+        }
+        for (int step = 0; step < 4; step++) {
+            uint64_t product = low * value % base;
+            value = value * ((2 + base - product) % base) % base;
+        }
+        inverse = static_cast<uint32_t>((base - value) % base);
+
+        // R^2 mod modulus, with R = BASE^length
+        Words square(2 * length + 1, 0);
+        square.back() = 1;
+        Division::divide(square, modulus, quotient, montgomerySquare);
+        montgomerySquare.resize(length, 0);
+    }
+    else {
+        Words power(2 * length + 1, 0);
+        power.back() = 1;
+        Words remainder;
+        Division::divide(power, modulus, barrettFactor, remainder);
+    }
+}
+
+// Reduce any value into [0, modulus)
+LargeNumber ModularContext::reduce(const LargeNumber& value) const {
+    return LargeNumber::fromWords(residueOf(value));
+}
+
+// Multiply two values modulo the modulus
+LargeNumber ModularContext::multiply(const LargeNumber& a, const LargeNumber& b) const {
+    Residue product;
+    if (reduction == ModularReduction::Montgomery) {
+
+        // One factor enters the domain, and the reduction of the product takes it back out
+        montgomeryMultiply(toDomain(residueOf(a)), residueOf(b), product);
+        WordArithmetic::trim(product);
+        return LargeNumber::fromWords(product);
+    }
+    multiplyResidues(residueOf(a), residueOf(b), product);
+    return LargeNumber::fromWords(product);
+}
+
+// Raise base to exponent with a sliding window over the exponent's bits
+LargeNumber ModularContext::pow(const LargeNumber& base, const LargeNumber& exponent) const {
+    if (exponent.isNegative()) {
+        throw invalid_argument("Exponent must not be negative");
+    }
+    vector<uint8_t> bits = binaryDigits(exponent.toWords());
+    if (bits.empty()) {
+        return reduce(LargeNumber("1"));
+    }
+
+    // Odd powers base^1, base^3, ..., base^(2^width - 1)
+    int width = windowWidth(bits.size());
+    vector<Residue> table(static_cast<size_t>(1) << (width - 1));
+    table[0] = toDomain(residueOf(base));
+    if (table.size() > 1) {
+        Residue square;
+        multiplyResidues(table[0], table[0], square);
+        for (size_t i = 1; i < table.size(); i++) {
+            multiplyResidues(table[i - 1], square, table[i]);
+        }
+    }
+
+    // Every window starts and ends on a set bit; the first one seeds the result
+    Residue result, scratch;
+    bool started = false;
+    for (int top = static_cast<int>(bits.size()) - 1; top >= 0;) {
+        if (bits[top] == 0) {
+            multiplyResidues(result, result, scratch);
+            result.swap(scratch);
+            top--;
+            continue;
+        }
+        int bottom = max(top - width + 1, 0);
+        while (bits[bottom] == 0) {
+            bottom++;
+        }
+        size_t window = 0;
+        for (int bit = top; bit >= bottom; bit--) {
+            window = window << 1 | bits[bit];
+        }
+        if (!started) {
+            result = table[window >> 1];
+            started = true;
+        }
+        else {
+            for (int bit = top; bit >= bottom; bit--) {
+                multiplyResidues(result, result, scratch);
+                result.swap(scratch);
+            }
+            multiplyResidues(result, table[window >> 1], scratch);
+            result.swap(scratch);
+        }
+        top = bottom - 1;
+    }
+    return fromDomain(result);
+}
+
+// Get the modulus
+const LargeNumber& ModularContext::getModulus() const {
+    return modulusNumber;
+}
+
+// Get the reduction in use
+ModularReduction ModularContext::getReduction() const {
+    return reduction;
+}
+
+// Montgomery for short moduli coprime to 10, Barrett for everything else
+ModularReduction ModularContext::selectReduction(const LargeNumber& modulus) {
+    Words words = modulus.toWords();
+    WordArithmetic::trim(words);
+    bool coprime = !words.empty() && words[0] % 2 != 0 && words[0] % 5 != 0;
+    return coprime && words.size() <= MONTGOMERY_MAX_WORDS ? ModularReduction::Montgomery : ModularReduction::Barrett;
+}
+
+// Reduce a value to trimmed words in [0, modulus)
+ModularContext::Residue ModularContext::residueOf(const LargeNumber& value) const {
+    Residue words = value.toWords();
+    WordArithmetic::trim(words);
+    if (WordArithmetic::compare(words, modulus) >= 0) {
+        Words quotient, remainder;
+        Division::divide(words, modulus, quotient, remainder);
+        words.swap(remainder);
+    }
+    if (value.isNegative() && !words.empty()) {
+        Residue difference(modulus);
+        WordArithmetic::subtractInPlace(difference, words);
+        words.swap(difference);
+    }
+    return words;
+}
+
+// Move a reduced value into the form the reduction works on
+ModularContext::Residue ModularContext::toDomain(const Residue& value) const {
+    if (reduction == ModularReduction::Barrett) {
+        return value;
+    }
+    Residue converted;
+    montgomeryMultiply(value, montgomerySquare, converted);
+    return converted;
+}
+
+// Move a value out of the reduction's form
+LargeNumber ModularContext::fromDomain(const Residue& value) const {
+    if (reduction == ModularReduction::Barrett) {
+        return LargeNumber::fromWords(value);
+    }
+    Residue converted;
+    montgomeryMultiply(value, Residue(1, 1), converted);
+    WordArithmetic::trim(converted);
+    return LargeNumber::fromWords(converted);
+}
+
+// Multiply two values in the reduction's form
+void ModularContext::multiplyResidues(const Residue& a, const Residue& b, Residue& out) const {
+    if (reduction == ModularReduction::Montgomery) {
+        montgomeryMultiply(a, b, out);
+        return;
+    }
+    Multiplication::multiply(a, b, out);
+    barrettReduce(out);
+}
+
+// a * b / R mod modulus, for a and b below the modulus (either may be shorter than it)
+void ModularContext::montgomeryMultiply(const Residue& a, const Residue& b, Residue& out) const {
+    const uint64_t base = WordArithmetic::BASE;
+    const size_t n = length;
+    vector<uint64_t> t(n + 2, 0);
+    for (size_t i = 0; i < n; i++) {
+
+        // t += a[i] * b
+        uint64_t word = i < a.size() ? a[i] : 0;
+        uint64_t carry = 0;
+        if (word != 0) {
+            for (size_t j = 0; j < b.size(); j++) {
+                uint64_t value = t[j] + word * b[j] + carry;
+                t[j] = value % base;
+                carry = value / base;
+            }
+            for (size_t j = b.size(); carry != 0 && j < n + 2; j++) {
+                uint64_t value = t[j] + carry;
+                t[j] = value % base;
+                carry = value / base;
+            }
+        }
+
+        // t = (t + u * modulus) / BASE, with u chosen to clear the low word
+        uint64_t u = t[0] * inverse % base;
+        carry = (t[0] + u * modulus[0]) / base;
+        for (size_t j = 1; j < n; j++) {
+            uint64_t value = t[j] + u * modulus[j] + carry;
+            t[j - 1] = value % base;
+            carry = value / base;
+        }
+        uint64_t value = t[n] + carry;
+        t[n - 1] = value % base;
+        t[n] = t[n + 1] + value / base;
+        t[n + 1] = 0;
+    }
+
+    // The result is below twice the modulus, so one subtraction finishes it
+    out.assign(n, 0);
+    for (size_t j = 0; j < n; j++) {
+        out[j] = static_cast<uint32_t>(t[j]);
+    }
+    int order = t[n] != 0 ? 1 : 0;
+    for (size_t j = n; order == 0 && j > 0; j--) {
+        if (out[j - 1] != modulus[j - 1]) {
+            order = out[j - 1] > modulus[j - 1] ? 1 : -1;
+        }
+    }
+    if (order >= 0) {
+        int64_t borrow = 0;
+        for (size_t j = 0; j < n; j++) {
+            int64_t difference = static_cast<int64_t>(out[j]) - modulus[j] - borrow;
+            borrow = difference < 0 ? 1 : 0;
+            out[j] = static_cast<uint32_t>(difference + borrow * static_cast<int64_t>(base));
+        }
+    }
+}
+
+// Reduce a product of two residues (below modulus^2) to [0, modulus)
+void ModularContext::barrettReduce(Residue& value) const {
+    if (WordArithmetic::compare(value, modulus) < 0) {
+        return;
+    }
+    Residue estimate, product;
+    Multiplication::multiply(WordArithmetic::shiftRight(value, length - 1), barrettFactor, estimate);
+    Multiplication::multiply(WordArithmetic::shiftRight(estimate, length + 1), modulus, product);
+    WordArithmetic::subtractInPlace(value, product);
+    while (WordArithmetic::compare(value, modulus) >= 0) {
+        WordArithmetic::subtractInPlace(value, modulus);
+    }
+}
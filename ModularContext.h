@@ -0,0 +1,83 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the ModularContext class, which
+    multiplies and exponentiates LargeNumber values modulo a fixed
+    positive modulus. Everything that depends only on the modulus
+    is computed once in the constructor, so one context serves any
+    number of operations. Residues are kept as base 10^9 words and
+    reduced either by Montgomery multiplication, which needs a
+    modulus with no factor of 2 or 5 in common with the base, or by
+    Barrett reduction on top of the Multiplication kernels, which
+    works for every modulus and wins once the modulus is long
+    enough for the fast multiplication algorithms to pay off.
+    pow() scans the exponent's bits with a sliding window over a
+    table of odd powers of the base.
+    This file requires LargeNumber.h, <cstddef>, <cstdint>, and <vector>.
+-------------------------------------------------- */
+
+#ifndef MODULAR_CONTEXT_H
+#define MODULAR_CONTEXT_H
+
+#include "LargeNumber.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Ways of reducing a product modulo the context's modulus
+enum class ModularReduction {
+    Montgomery,
+    Barrett
+};
+
+class ModularContext {
+public:
+
+    // Longest modulus, in base 10^9 words, for which Montgomery is picked automatically
+    static const size_t MONTGOMERY_MAX_WORDS = 192;
+
+    // Build a context for a positive modulus, picking the reduction by its shape and size;
+    // throws domain_error for a modulus below 1
+    explicit ModularContext(const LargeNumber& modulus);
+
+    // Build a context with a fixed reduction; throws invalid_argument for Montgomery
+    // with a modulus divisible by 2 or 5
+    ModularContext(const LargeNumber& modulus, ModularReduction reduction);
+
+    // Arithmetic modulo the modulus; results lie in [0, modulus)
+    LargeNumber reduce(const LargeNumber& value) const;
+    LargeNumber multiply(const LargeNumber& a, const LargeNumber& b) const;
+
+    // Raise base to a non-negative exponent; throws invalid_argument for a negative exponent
+    LargeNumber pow(const LargeNumber& base, const LargeNumber& exponent) const;
+
+    // Getters
+    const LargeNumber& getModulus() const;
+    ModularReduction getReduction() const;
+
+    // Reduction the single-argument constructor would use for a modulus
+    static ModularReduction selectReduction(const LargeNumber& modulus);
+
+private:
+    typedef std::vector<uint32_t> Residue;
+
+    LargeNumber modulusNumber;
+    Residue modulus;             // Trimmed base 10^9 words
+    size_t length;               // Words in the modulus
+    ModularReduction reduction;
+    uint32_t inverse;            // Montgomery: -modulus^-1 mod 10^9
+    Residue montgomerySquare;    // Montgomery: R^2 mod modulus, with R = 10^(9 * length)
+    Residue barrettFactor;       // Barrett: floor(10^(18 * length) / modulus)
+
+    // Helper methods
+    void prepare();
+    Residue residueOf(const LargeNumber& value) const;
+    Residue toDomain(const Residue& value) const;
+    LargeNumber fromDomain(const Residue& value) const;
+    void multiplyResidues(const Residue& a, const Residue& b, Residue& out) const;
+    void montgomeryMultiply(const Residue& a, const Residue& b, Residue& out) const;
+    void barrettReduce(Residue& value) const;
+};
+
+#endif // MODULAR_CONTEXT_H
@@ -0,0 +1,571 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the Multiplication class defined in
+    Multiplication.h. Operands are base 10^9 words, least
+    significant first. Schoolbook multiplication keeps 64-bit
+    partial sums; Karatsuba and Toom-Cook 3-way split the
+    operands and recurse through the same size-based selection;
+    the number-theoretic transform works on base 10^6 digits
+    modulo three NTT-friendly primes and recombines them with
+    the Chinese remainder theorem. Once the shorter operand
+    passes the ThreadPool cutoff, the independent sub-products
+    of each level and the three prime convolutions run on the
+    shared pool.
+    It requires Multiplication.h, ThreadPool.h, WordArithmetic.h,
+    <algorithm>, <atomic>, <chrono>, and <random> to run.
+-------------------------------------------------- */
+
+#include "Multiplication.h"
+#include "ThreadPool.h"
+#include "WordArithmetic.h"
+#include <algorithm> // For element ranges (max() and min())
+#include <atomic> // For thresholds shared between threads (atomic)
+#include <chrono> // For timing (steady_clock)
+#include <random> // For tuning operands (mt19937)
+
+using namespace std;
+
+const uint32_t Multiplication::WORD_BASE;
+
+namespace {
+
+    // Active thresholds
+    atomic<size_t> karatsubaThreshold{ MultiplicationThresholds().karatsuba };
+    atomic<size_t> toomCook3Threshold{ MultiplicationThresholds().toomCook3 };
+    atomic<size_t> numberTheoreticThreshold{ MultiplicationThresholds().numberTheoretic };
+
+    // Longest transform supported by all three primes
+    const size_t NTT_MAX_LENGTH = size_t(1) << 23;
+
+    Words product(const Words& a, const Words& b);
+
+    // True when the sub-products of a and b are large enough to run on separate threads
+    bool runsInParallel(const Words& a, const Words& b) {
+        return ThreadPool::shouldParallelize(min(a.size(), b.size()) * 9);
+    }
+
+    // Signed magnitude used by Toom-Cook interpolation
+    struct SignedWords {
+        Words magnitude;
+        bool negative = false;
+    };
+
+    SignedWords signedAdd(const SignedWords& a, const SignedWords& b) {
+        SignedWords result;
+        if (a.negative == b.negative) {
+            result.magnitude = WordArithmetic::add(a.magnitude, b.magnitude);
+            result.negative = a.negative;
+        }
+        else if (WordArithmetic::compare(a.magnitude, b.magnitude) >= 0) {
+            result.magnitude = a.magnitude;
+            WordArithmetic::subtractInPlace(result.magnitude, b.magnitude);
+            result.negative = a.negative;
+        }
+        else {
+            result.magnitude = b.magnitude;
+            WordArithmetic::subtractInPlace(result.magnitude, a.magnitude);
+            result.negative = b.negative;
+        }
+        if (result.magnitude.empty()) {
+            result.negative = false;
+        }
+        return result;
+    }
+
+    SignedWords signedSubtract(const SignedWords& a, const SignedWords& b) {
+        SignedWords negated = b;
+        negated.negative = !b.negative && !b.magnitude.empty();
+        return signedAdd(a, negated);
+    }
+
+    SignedWords multiplySmall(const SignedWords& a, uint32_t factor) {
+        SignedWords result;
+        result.negative = a.negative;
+        result.magnitude.resize(a.magnitude.size() + 1);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < a.magnitude.size(); i++) {
+            uint64_t value = static_cast<uint64_t>(a.magnitude[i]) * factor + carry;
+            result.magnitude[i] = static_cast<uint32_t>(value % Multiplication::WORD_BASE);
+            carry = value / Multiplication::WORD_BASE;
+        }
+        result.magnitude[a.magnitude.size()] = static_cast<uint32_t>(carry);
+        WordArithmetic::trim(result.magnitude);
+        return result;
+    }
+
+    // Divide by a small factor that is known to divide exactly
+    SignedWords divideSmallExact(const SignedWords& a, uint32_t divisor) {
+        SignedWords result;
+        result.negative = a.negative;
+        result.magnitude.resize(a.magnitude.size());
+        uint64_t remainder = 0;
+        for (size_t i = a.magnitude.size(); i > 0; i--) {
+            uint64_t value = remainder * Multiplication::WORD_BASE + a.magnitude[i - 1];
+            result.magnitude[i - 1] = static_cast<uint32_t>(value / divisor);
+            remainder = value % divisor;
+        }
+        WordArithmetic::trim(result.magnitude);
+        return result;
+    }
+
+    SignedWords signedProduct(const SignedWords& a, const SignedWords& b) {
+        SignedWords result;
+        result.magnitude = product(a.magnitude, b.magnitude);
+        result.negative = !result.magnitude.empty() && a.negative != b.negative;
+        return result;
+    }
+
+    // Schoolbook multiplication with 64-bit partial sums
+    Words schoolbook(const Words& a, const Words& b) {
+        Words result(a.size() + b.size(), 0);
+        for (size_t i = 0; i < a.size(); i++) {
+            uint64_t factor = a[i];
+            if (factor == 0) {
+                continue;
+            }
+            uint64_t carry = 0;
+            for (size_t j = 0; j < b.size(); j++) {
+                uint64_t value = result[i + j] + factor * b[j] + carry;
+                result[i + j] = static_cast<uint32_t>(value % Multiplication::WORD_BASE);
+                carry = value / Multiplication::WORD_BASE;
+            }
+            result[i + b.size()] = static_cast<uint32_t>(carry);
+        }
+        WordArithmetic::trim(result);
+        return result;
+    }
+
+    // Karatsuba: three half-size products instead of four
+    Words karatsuba(const Words& a, const Words& b) {
+        size_t half = (max(a.size(), b.size()) + 1) / 2;
+        Words a0 = WordArithmetic::slice(a, 0, half);
+        Words a1 = WordArithmetic::slice(a, half, a.size());
+        Words b0 = WordArithmetic::slice(b, 0, half);
+        Words b1 = WordArithmetic::slice(b, half, b.size());
+
+        Words z0, z1, z2;
+        if (runsInParallel(a, b)) {
+            TaskGroup group(ThreadPool::shared());
+            group.run([&]() { z0 = product(a0, b0); });
+            group.run([&]() { z2 = product(a1, b1); });
+            z1 = product(WordArithmetic::add(a0, a1), WordArithmetic::add(b0, b1));
+            group.wait();
+        }
+        else {
+            z0 = product(a0, b0);
+            z2 = product(a1, b1);
+            z1 = product(WordArithmetic::add(a0, a1), WordArithmetic::add(b0, b1));
+        }
+        WordArithmetic::subtractInPlace(z1, z0);
+        WordArithmetic::subtractInPlace(z1, z2);
+
+        Words result;
+        WordArithmetic::addShifted(result, z0, 0);
+        WordArithmetic::addShifted(result, z1, half);
+        WordArithmetic::addShifted(result, z2, 2 * half);
+        WordArithmetic::trim(result);
+        return result;
+    }
+
+    // Toom-Cook 3-way: five third-size products, evaluated at 0, 1, -1, -2, and infinity
+    Words toomCook3(const Words& a, const Words& b) {
+        size_t third = (max(a.size(), b.size()) + 2) / 3;
+        SignedWords a0{ WordArithmetic::slice(a, 0, third) };
+        SignedWords a1{ WordArithmetic::slice(a, third, 2 * third) };
+        SignedWords a2{ WordArithmetic::slice(a, 2 * third, a.size()) };
+        SignedWords b0{ WordArithmetic::slice(b, 0, third) };
+        SignedWords b1{ WordArithmetic::slice(b, third, 2 * third) };
+        SignedWords b2{ WordArithmetic::slice(b, 2 * third, b.size()) };
+
+        // Evaluate both polynomials
+        SignedWords pa = signedAdd(a0, a2);
+        SignedWords aAtOne = signedAdd(pa, a1);
+        SignedWords aAtMinusOne = signedSubtract(pa, a1);
+        SignedWords aAtMinusTwo = signedSubtract(multiplySmall(signedAdd(aAtMinusOne, a2), 2), a0);
+        SignedWords pb = signedAdd(b0, b2);
+        SignedWords bAtOne = signedAdd(pb, b1);
+        SignedWords bAtMinusOne = signedSubtract(pb, b1);
+        SignedWords bAtMinusTwo = signedSubtract(multiplySmall(signedAdd(bAtMinusOne, b2), 2), b0);
+
+        // Pointwise products
+        SignedWords r0, r1, rMinusOne, rMinusTwo, r4;
+        if (runsInParallel(a, b)) {
+            TaskGroup group(ThreadPool::shared());
+            group.run([&]() { r0 = signedProduct(a0, b0); });
+            group.run([&]() { r1 = signedProduct(aAtOne, bAtOne); });
+            group.run([&]() { rMinusOne = signedProduct(aAtMinusOne, bAtMinusOne); });
+            group.run([&]() { rMinusTwo = signedProduct(aAtMinusTwo, bAtMinusTwo); });
+            r4 = signedProduct(a2, b2);
+            group.wait();
+        }
+        else {
+            r0 = signedProduct(a0, b0);
+            r1 = signedProduct(aAtOne, bAtOne);
+            rMinusOne = signedProduct(aAtMinusOne, bAtMinusOne);
+            rMinusTwo = signedProduct(aAtMinusTwo, bAtMinusTwo);
+            r4 = signedProduct(a2, b2);
+        }
+
+        // Interpolate (Bodrato's sequence; every division is exact)
+        SignedWords r3 = divideSmallExact(signedSubtract(rMinusTwo, r1), 3);
+        SignedWords c1 = divideSmallExact(signedSubtract(r1, rMinusOne), 2);
+        SignedWords c2 = signedSubtract(rMinusOne, r0);
+        r3 = signedAdd(divideSmallExact(signedSubtract(c2, r3), 2), multiplySmall(r4, 2));
+        c2 = signedSubtract(signedAdd(c2, c1), r4);
+        c1 = signedSubtract(c1, r3);
+
+        // Recombine; the coefficients of a product of magnitudes are never negative
+        Words result;
+        WordArithmetic::addShifted(result, r0.magnitude, 0);
+        WordArithmetic::addShifted(result, c1.magnitude, third);
+        WordArithmetic::addShifted(result, c2.magnitude, 2 * third);
+        WordArithmetic::addShifted(result, r3.magnitude, 3 * third);
+        WordArithmetic::addShifted(result, r4.magnitude, 4 * third);
+        WordArithmetic::trim(result);
+        return result;
+    }
+
+    // Modular arithmetic for one NTT prime with primitive root 3
+    template <uint32_t MOD>
+    struct NttPrime {
+        static uint32_t power(uint64_t base, uint64_t exponent) {
+            uint64_t result = 1;
+            base %= MOD;
+            while (exponent) {
+                if (exponent & 1) result = result * base % MOD;
+                base = base * base % MOD;
+                exponent >>= 1;
+            }
+            return static_cast<uint32_t>(result);
+        }
+
+        // In-place iterative transform of a power-of-two length vector
+        static void transform(vector<uint32_t>& values, bool inverse) {
+            size_t n = values.size();
+            for (size_t i = 1, j = 0; i < n; i++) {
+                size_t bit = n >> 1;
+                for (; j & bit; bit >>= 1) {
+                    j ^= bit;
+                }
+                j ^= bit;
+                if (i < j) {
+                    swap(values[i], values[j]);
+                }
+            }
+
+            vector<uint32_t> roots(n / 2);
+            for (size_t length = 2; length <= n; length <<= 1) {
+                uint32_t root = power(3, (MOD - 1) / length);
+                if (inverse) {
+                    root = power(root, MOD - 2);
+                }
+                size_t halfLength = length / 2;
+                roots[0] = 1;
+                for (size_t k = 1; k < halfLength; k++) {
+                    roots[k] = static_cast<uint32_t>(static_cast<uint64_t>(roots[k - 1]) * root % MOD);
+                }
+                for (size_t start = 0; start < n; start += length) {
+                    for (size_t k = 0; k < halfLength; k++) {
+                        uint32_t u = values[start + k];
+                        uint32_t v = static_cast<uint32_t>(static_cast<uint64_t>(values[start + k + halfLength]) * roots[k] % MOD);
+                        values[start + k] = u + v >= MOD ? u + v - MOD : u + v;
+                        values[start + k + halfLength] = u >= v ? u - v : u + MOD - v;
+                    }
+                }
+            }
+
+            if (inverse) {
+                uint64_t scale = power(n, MOD - 2);
+                for (uint32_t& value : values) {
+                    value = static_cast<uint32_t>(value * scale % MOD);
+                }
+            }
+        }
+
+        // Cyclic convolution of two digit vectors modulo MOD
+        static vector<uint32_t> convolve(const vector<uint32_t>& a, const vector<uint32_t>& b, size_t length) {
+            vector<uint32_t> fa(a), fb(b);
+            fa.resize(length, 0);
+            fb.resize(length, 0);
+            transform(fa, false);
+            transform(fb, false);
+            for (size_t i = 0; i < length; i++) {
+                fa[i] = static_cast<uint32_t>(static_cast<uint64_t>(fa[i]) * fb[i] % MOD);
+            }
+            transform(fa, true);
+            return fa;
+        }
+    };
+
+    const uint32_t PRIME_1 = 998244353;
+    const uint32_t PRIME_2 = 167772161;
+    const uint32_t PRIME_3 = 469762049;
+
+    // Split base 10^9 words into base 10^6 digits (two words make three digits)
+    vector<uint32_t> toMillionDigits(const Words& words) {
+        vector<uint32_t> digits((words.size() + 1) / 2 * 3);
+        for (size_t pair = 0; pair * 2 < words.size(); pair++) {
+            uint64_t low = words[pair * 2];
+            uint64_t high = pair * 2 + 1 < words.size() ? words[pair * 2 + 1] : 0;
+            uint64_t value = high * Multiplication::WORD_BASE + low;
+            digits[pair * 3] = static_cast<uint32_t>(value % 1000000);
+            digits[pair * 3 + 1] = static_cast<uint32_t>(value / 1000000 % 1000000);
+            digits[pair * 3 + 2] = static_cast<uint32_t>(value / 1000000000000ULL);
+        }
+        return digits;
+    }
+
+    // Number-theoretic transform product over three primes
+    Words numberTheoretic(const Words& a, const Words& b) {
+        vector<uint32_t> da = toMillionDigits(a);
+        vector<uint32_t> db = toMillionDigits(b);
+        size_t needed = da.size() + db.size();
+        size_t length = 1;
+        while (length < needed) {
+            length <<= 1;
+        }
+
+        // The three primes are independent transforms
+        vector<uint32_t> r1, r2, r3;
+        if (runsInParallel(a, b)) {
+            TaskGroup group(ThreadPool::shared());
+            group.run([&]() { r1 = NttPrime<PRIME_1>::convolve(da, db, length); });
+            group.run([&]() { r2 = NttPrime<PRIME_2>::convolve(da, db, length); });
+            r3 = NttPrime<PRIME_3>::convolve(da, db, length);
+            group.wait();
+        }
+        else {
+            r1 = NttPrime<PRIME_1>::convolve(da, db, length);
+            r2 = NttPrime<PRIME_2>::convolve(da, db, length);
+            r3 = NttPrime<PRIME_3>::convolve(da, db, length);
+        }
+
+        // Garner recombination; every coefficient is below 2^64
+        const uint64_t inverse1Mod2 = NttPrime<PRIME_2>::power(PRIME_1, PRIME_2 - 2);
+        const uint64_t modulus12Mod3 = static_cast<uint64_t>(PRIME_1) * PRIME_2 % PRIME_3;
+        const uint64_t inverse12Mod3 = NttPrime<PRIME_3>::power(modulus12Mod3, PRIME_3 - 2);
+        const uint64_t prime1Mod3 = PRIME_1 % PRIME_3;
+
+        vector<uint32_t> digits(needed + 4, 0);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < needed; i++) {
+            uint64_t v1 = r1[i];
+            uint64_t v2 = (r2[i] + PRIME_2 - v1 % PRIME_2) % PRIME_2 * inverse1Mod2 % PRIME_2;
+            uint64_t partial = (v1 + v2 * prime1Mod3) % PRIME_3;
+            uint64_t v3 = (r3[i] + PRIME_3 - partial) % PRIME_3 * inverse12Mod3 % PRIME_3;
+            uint64_t value = v1 + v2 * PRIME_1 + v3 * PRIME_1 * PRIME_2 + carry;
+            digits[i] = static_cast<uint32_t>(value % 1000000);
+            carry = value / 1000000;
+        }
+        for (size_t i = needed; carry; i++) {
+            digits[i] = static_cast<uint32_t>(carry % 1000000);
+            carry /= 1000000;
+        }
+
+        // Join three base 10^6 digits into two base 10^9 words
+        Words result((digits.size() + 2) / 3 * 2, 0);
+        for (size_t triple = 0; triple * 3 < digits.size(); triple++) {
+            uint64_t value = digits[triple * 3];
+            if (triple * 3 + 1 < digits.size()) value += static_cast<uint64_t>(digits[triple * 3 + 1]) * 1000000;
+            if (triple * 3 + 2 < digits.size()) value += static_cast<uint64_t>(digits[triple * 3 + 2]) * 1000000000000ULL;
+            result[triple * 2] = static_cast<uint32_t>(value % Multiplication::WORD_BASE);
+            result[triple * 2 + 1] = static_cast<uint32_t>(value / Multiplication::WORD_BASE);
+        }
+        WordArithmetic::trim(result);
+        return result;
+    }
+
+    // The transform length the NTT would need for these operands
+    bool fitsNumberTheoretic(size_t aWords, size_t bWords) {
+        size_t needed = (aWords + 1) / 2 * 3 + (bWords + 1) / 2 * 3;
+        return needed <= NTT_MAX_LENGTH;
+    }
+
+    // Multiply a long operand by a much shorter one in balanced slices
+    Words unbalanced(const Words& longer, const Words& shorter) {
+        Words result;
+        size_t slices = (longer.size() + shorter.size() - 1) / shorter.size();
+
+        // Parallel slices keep every partial product, then add them in order
+        if (slices > 1 && runsInParallel(longer, shorter)) {
+            vector<Words> parts(slices);
+            ThreadPool::shared().parallelFor(slices, [&](size_t i) {
+                size_t start = i * shorter.size();
+                parts[i] = product(WordArithmetic::slice(longer, start, start + shorter.size()), shorter);
+            });
+            for (size_t i = 0; i < slices; i++) {
+                WordArithmetic::addShifted(result, parts[i], i * shorter.size());
+            }
+            WordArithmetic::trim(result);
+            return result;
+        }
+
+        for (size_t start = 0; start < longer.size(); start += shorter.size()) {
+            Words part = WordArithmetic::slice(longer, start, start + shorter.size());
+            WordArithmetic::addShifted(result, product(part, shorter), start);
+        }
+        WordArithmetic::trim(result);
+        return result;
+    }
+
+    Words run(const Words& a, const Words& b, MultiplicationAlgorithm algorithm) {
+        switch (algorithm) {
+        case MultiplicationAlgorithm::Schoolbook:
+            return schoolbook(a, b);
+        case MultiplicationAlgorithm::Karatsuba:
+            return karatsuba(a, b);
+        case MultiplicationAlgorithm::ToomCook3:
+            return toomCook3(a, b);
+        case MultiplicationAlgorithm::NumberTheoretic:
+            if (fitsNumberTheoretic(a.size(), b.size())) {
+                return numberTheoretic(a, b);
+            }
+            return toomCook3(a, b);
+        }
+        return schoolbook(a, b);
+    }
+
+    // Size-based dispatch used at every recursion level
+    Words product(const Words& a, const Words& b) {
+        if (a.empty() || b.empty()) {
+            return Words();
+        }
+        const Words& longer = a.size() >= b.size() ? a : b;
+        const Words& shorter = a.size() >= b.size() ? b : a;
+        MultiplicationAlgorithm algorithm = Multiplication::selectAlgorithm(longer.size(), shorter.size());
+
+        // Split lopsided operands so Karatsuba and Toom-Cook see balanced halves
+        if ((algorithm == MultiplicationAlgorithm::Karatsuba || algorithm == MultiplicationAlgorithm::ToomCook3)
+            && longer.size() > 2 * shorter.size()) {
+            return unbalanced(longer, shorter);
+        }
+        return run(longer, shorter, algorithm);
+    }
+
+    // Random magnitude of the given length for tuning
+    Words randomWords(size_t length, mt19937& generator) {
+        uniform_int_distribution<uint32_t> distribution(0, Multiplication::WORD_BASE - 1);
+        Words words(length);
+        for (uint32_t& word : words) {
+            word = distribution(generator);
+        }
+        words.back() = max<uint32_t>(words.back(), 1);
+        return words;
+    }
+
+    // Average seconds for one top-level product with the given algorithm
+    double timeAlgorithm(const Words& a, const Words& b, MultiplicationAlgorithm algorithm) {
+        using clock = chrono::steady_clock;
+        int repetitions = 0;
+        clock::time_point start = clock::now();
+        double elapsed;
+        do {
+            Words result = run(a, b, algorithm);
+            repetitions++;
+            elapsed = chrono::duration<double>(clock::now() - start).count();
+        } while (elapsed < 0.01);
+        return elapsed / repetitions;
+    }
+
+    // Smallest size at which the higher tier beats the lower one twice in a row
+    size_t findCrossover(MultiplicationAlgorithm lower, MultiplicationAlgorithm higher, size_t from, size_t limit,
+        mt19937& generator, ostream* log) {
+        int wins = 0;
+        size_t firstWin = limit;
+        for (size_t words = from; words <= limit; words += words / 2) {
+            Words a = randomWords(words, generator);
+            Words b = randomWords(words, generator);
+            double lowerTime = timeAlgorithm(a, b, lower);
+            double higherTime = timeAlgorithm(a, b, higher);
+            if (log) {
+                *log << "  " << words << " words: " << lowerTime * 1e6 << " us vs " << higherTime * 1e6 << " us" << endl;
+            }
+            if (higherTime < lowerTime) {
+                if (wins++ == 0) firstWin = words;
+                if (wins == 2) return firstWin;
+            }
+            else {
+                wins = 0;
+                firstWin = limit;
+            }
+        }
+        return firstWin;
+    }
+}
+
+// Multiply two magnitudes, choosing the algorithm by size
+void Multiplication::multiply(const vector<uint32_t>& a, const vector<uint32_t>& b, vector<uint32_t>& result) {
+    Words x(a), y(b);
+    WordArithmetic::trim(x);
+    WordArithmetic::trim(y);
+    result = product(x, y);
+}
+
+// Multiply with a fixed top-level algorithm
+void Multiplication::multiply(const vector<uint32_t>& a, const vector<uint32_t>& b, vector<uint32_t>& result,
+    MultiplicationAlgorithm algorithm) {
+    Words x(a), y(b);
+    WordArithmetic::trim(x);
+    WordArithmetic::trim(y);
+    if (x.empty() || y.empty()) {
+        result.clear();
+        return;
+    }
+    result = run(x, y, algorithm);
+}
+
+// Pick the algorithm for operands of the given lengths
+MultiplicationAlgorithm Multiplication::selectAlgorithm(size_t aWords, size_t bWords) {
+    size_t shorter = min(aWords, bWords);
+    if (shorter >= numberTheoreticThreshold.load(memory_order_relaxed) && fitsNumberTheoretic(aWords, bWords)) {
+        return MultiplicationAlgorithm::NumberTheoretic;
+    }
+    if (shorter >= toomCook3Threshold.load(memory_order_relaxed)) {
+        return MultiplicationAlgorithm::ToomCook3;
+    }
+    if (shorter >= karatsubaThreshold.load(memory_order_relaxed)) {
+        return MultiplicationAlgorithm::Karatsuba;
+    }
+    return MultiplicationAlgorithm::Schoolbook;
+}
+
+// Get the active thresholds
+MultiplicationThresholds Multiplication::getThresholds() {
+    MultiplicationThresholds current;
+    current.karatsuba = karatsubaThreshold.load(memory_order_relaxed);
+    current.toomCook3 = toomCook3Threshold.load(memory_order_relaxed);
+    current.numberTheoretic = numberTheoreticThreshold.load(memory_order_relaxed);
+    return current;
+}
+
+// Replace the active thresholds (the splitting tiers need a few words to make progress)
+void Multiplication::setThresholds(const MultiplicationThresholds& newThresholds) {
+    karatsubaThreshold.store(max<size_t>(newThresholds.karatsuba, 4), memory_order_relaxed);
+    toomCook3Threshold.store(max<size_t>(newThresholds.toomCook3, 3), memory_order_relaxed);
+    numberTheoreticThreshold.store(max<size_t>(newThresholds.numberTheoretic, 2), memory_order_relaxed);
+}
+
+// Measure the crossovers one tier at a time, lowest first
+MultiplicationThresholds Multiplication::tuneThresholds(ostream* log) {
+    mt19937 generator(12345);
+    MultiplicationThresholds tuned = getThresholds();
+
+    if (log) *log << "Schoolbook vs Karatsuba" << endl;
+    tuned.karatsuba = findCrossover(MultiplicationAlgorithm::Schoolbook, MultiplicationAlgorithm::Karatsuba,
+        8, 1024, generator, log);
+    setThresholds(tuned);
+
+    if (log) *log << "Karatsuba vs Toom-Cook 3" << endl;
+    tuned.toomCook3 = max(findCrossover(MultiplicationAlgorithm::Karatsuba, MultiplicationAlgorithm::ToomCook3,
+        tuned.karatsuba, 8192, generator, log), tuned.karatsuba);
+    setThresholds(tuned);
+
+    if (log) *log << "Toom-Cook 3 vs number-theoretic transform" << endl;
+    tuned.numberTheoretic = max(findCrossover(MultiplicationAlgorithm::ToomCook3, MultiplicationAlgorithm::NumberTheoretic,
+        tuned.toomCook3, 65536, generator, log), tuned.toomCook3);
+    setThresholds(tuned);
+
+    return getThresholds();
+}
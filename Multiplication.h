@@ -0,0 +1,63 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the Multiplication class, which
+    multiplies magnitudes stored as base 10^9 words (least
+    significant first). It picks an algorithm by operand size:
+    schoolbook for small inputs, Karatsuba and Toom-Cook 3-way
+    in the middle, and a number-theoretic transform for the
+    largest inputs. The size thresholds can be set directly or
+    measured on the running machine with tuneThresholds().
+    This file requires <cstddef>, <cstdint>, <iostream>, and <vector>.
+-------------------------------------------------- */
+
+#ifndef MULTIPLICATION_H
+#define MULTIPLICATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// Multiplication algorithms in order of increasing operand size
+enum class MultiplicationAlgorithm {
+    Schoolbook,
+    Karatsuba,
+    ToomCook3,
+    NumberTheoretic
+};
+
+// Smallest operand length, in base 10^9 words, at which each algorithm takes over
+struct MultiplicationThresholds {
+    size_t karatsuba = 32;
+    size_t toomCook3 = 256;
+    size_t numberTheoretic = 768;
+};
+
+class Multiplication {
+public:
+    static const uint32_t WORD_BASE = 1000000000;
+
+    // Multiply two magnitudes, choosing the algorithm by size
+    static void multiply(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, std::vector<uint32_t>& result);
+
+    // Multiply with a fixed top-level algorithm (recursive steps still use the thresholds)
+    static void multiply(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, std::vector<uint32_t>& result,
+        MultiplicationAlgorithm algorithm);
+
+    // Algorithm the size-based selection would use for these operand lengths
+    static MultiplicationAlgorithm selectAlgorithm(size_t aWords, size_t bWords);
+
+    // Threshold configuration
+    static MultiplicationThresholds getThresholds();
+    static void setThresholds(const MultiplicationThresholds& newThresholds);
+
+    // Time the algorithms on this machine, apply the measured crossovers, and return them
+    static MultiplicationThresholds tuneThresholds(std::ostream* log = nullptr);
+
+private:
+    Multiplication() = delete;
+};
+
+#endif // MULTIPLICATION_H
@@ -0,0 +1,270 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the NodePool class defined in
+    NodePool.h. Each thread keeps its own free list of nodes,
+    linked through the nodes' next pointers, so allocation
+    and release never take a lock in the common case. Fresh
+    nodes come from slabs of many nodes obtained with a single
+    heap call. Slabs live until the program exits (see
+    NodePool.h), and nodes freed by an exiting thread move to a
+    shared list where other threads can pick them up.
+    It requires NodePool.h, LargeNumber.h, <atomic>, <cstdlib>,
+    <mutex>, <new>, and <vector> to run.
+-------------------------------------------------- */
+
+#include "NodePool.h"
+#include "LargeNumber.h"
+#include <atomic> // For lock-free counters (atomic)
+#include <cstdlib> // For slab storage (malloc())
+#include <mutex> // For the shared registry (mutex and lock_guard)
+#include <new> // For placement new and bad_alloc
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+    // Slab sizing: at least 16 nodes per heap call, roughly 64 KiB per slab
+    const size_t SLAB_BYTES = 64 * 1024;
+    const size_t NODES_PER_SLAB = (SLAB_BYTES / sizeof(Node) > 16) ? SLAB_BYTES / sizeof(Node) : 16;
+
+    // A thread returns nodes to the shared list once it holds this many
+    const size_t LOCAL_FREE_LIMIT = 4 * NODES_PER_SLAB;
+
+    struct ThreadCache;
+
+    // Shared slab storage, overflow free list, and counter registry
+    struct SlabRegistry {
+        mutex lock;
+        vector<void*> slabs;
+        vector<ThreadCache*> caches;
+        Node* freeList = nullptr;
+        size_t freeCount = 0;
+        size_t retiredAllocated = 0;
+        size_t retiredReleased = 0;
+        size_t slabAllocations = 0;
+
+        // Totals at the last resetStats(), subtracted by getStats()
+        size_t resetAllocated = 0;
+        size_t resetReleased = 0;
+    };
+
+    // Never destroyed: ThreadPool workers hand their nodes back as they exit, which can be
+    // after static destructors have run
+    SlabRegistry& registry() {
+        static SlabRegistry* instance = new SlabRegistry();
+        return *instance;
+    }
+
+    // Add to a counter that only its owning thread writes
+    inline void bump(atomic<size_t>& counter, size_t amount) {
+        counter.store(counter.load(memory_order_relaxed) + amount, memory_order_relaxed);
+    }
+
+    // Detach up to count nodes from the front of a free list
+    Node* takeNodes(Node*& list, size_t& listCount, size_t count, size_t& taken, Node*& last) {
+        Node* first = list;
+        last = nullptr;
+        taken = 0;
+        while (list && taken < count) {
+            last = list;
+            list = list->next;
+            taken++;
+        }
+        if (last) last->next = nullptr;
+        listCount -= taken;
+        return first;
+    }
+
+    // Carve a new slab into a chain of free nodes (registry lock must be held)
+    Node* carveSlab(SlabRegistry& shared) {
+        void* slab = malloc(NODES_PER_SLAB * sizeof(Node));
+        if (!slab) {
+            throw bad_alloc();
+        }
+        shared.slabs.push_back(slab);
+        shared.slabAllocations++;
+
+        Node* nodes = static_cast<Node*>(slab);
+        Node* chain = nullptr;
+        for (size_t i = NODES_PER_SLAB; i > 0; i--) {
+            Node* node = new (&nodes[i - 1]) Node();
+            node->next = chain;
+            chain = node;
+        }
+        return chain;
+    }
+
+    thread_local bool cacheDestroyed = false;
+
+    // Per-thread free list and counters
+    struct ThreadCache {
+        Node* freeList = nullptr;
+        size_t freeCount = 0;
+        atomic<size_t> allocated{ 0 };
+        atomic<size_t> released{ 0 };
+
+        ThreadCache() {
+            SlabRegistry& shared = registry();
+            lock_guard<mutex> guard(shared.lock);
+            shared.caches.push_back(this);
+        }
+
+        ~ThreadCache() {
+            SlabRegistry& shared = registry();
+            lock_guard<mutex> guard(shared.lock);
+            spillAll(shared);
+            shared.retiredAllocated += allocated.load(memory_order_relaxed);
+            shared.retiredReleased += released.load(memory_order_relaxed);
+            for (size_t i = 0; i < shared.caches.size(); i++) {
+                if (shared.caches[i] == this) {
+                    shared.caches.erase(shared.caches.begin() + i);
+                    break;
+                }
+            }
+            cacheDestroyed = true;
+        }
+
+        // Refill an empty free list from the shared list or a new slab
+        void refill() {
+            SlabRegistry& shared = registry();
+            lock_guard<mutex> guard(shared.lock);
+            if (shared.freeList) {
+                size_t taken;
+                Node* last;
+                freeList = takeNodes(shared.freeList, shared.freeCount, NODES_PER_SLAB, taken, last);
+                freeCount = taken;
+            }
+            else {
+                freeList = carveSlab(shared);
+                freeCount = NODES_PER_SLAB;
+            }
+        }
+
+        // Hand part of an oversized free list back to the shared list
+        void trim() {
+            SlabRegistry& shared = registry();
+            size_t taken;
+            Node* last;
+            Node* first = takeNodes(freeList, freeCount, freeCount - NODES_PER_SLAB, taken, last);
+            lock_guard<mutex> guard(shared.lock);
+            last->next = shared.freeList;
+            shared.freeList = first;
+            shared.freeCount += taken;
+        }
+
+        // Hand the whole free list back (registry lock must be held)
+        void spillAll(SlabRegistry& shared) {
+            while (freeList) {
+                Node* node = freeList;
+                freeList = freeList->next;
+                node->next = shared.freeList;
+                shared.freeList = node;
+                shared.freeCount++;
+            }
+            freeCount = 0;
+        }
+    };
+
+    ThreadCache& localCache() {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+
+    // Nodes allocated and released since the program started (registry lock must be held)
+    void totals(SlabRegistry& shared, size_t& allocated, size_t& released) {
+        allocated = shared.retiredAllocated;
+        released = shared.retiredReleased;
+        for (ThreadCache* cache : shared.caches) {
+            allocated += cache->allocated.load(memory_order_relaxed);
+            released += cache->released.load(memory_order_relaxed);
+        }
+    }
+}
+
+// Allocate an empty node
+Node* NodePool::allocate() {
+    Node* node;
+
+    // Threads tearing down their cache fall back to the shared list
+    if (cacheDestroyed) {
+        SlabRegistry& shared = registry();
+        lock_guard<mutex> guard(shared.lock);
+        if (!shared.freeList) {
+            shared.freeList = carveSlab(shared);
+            shared.freeCount = NODES_PER_SLAB;
+        }
+        node = shared.freeList;
+        shared.freeList = node->next;
+        shared.freeCount--;
+        shared.retiredAllocated++;
+    }
+    else {
+        ThreadCache& cache = localCache();
+        if (!cache.freeList) {
+            cache.refill();
+        }
+        node = cache.freeList;
+        cache.freeList = node->next;
+        cache.freeCount--;
+        bump(cache.allocated, 1);
+    }
+    return new (node) Node();
+}
+
+// Return a single node to the pool
+void NodePool::release(Node* node) {
+    if (node) {
+        releaseList(node, node, 1);
+    }
+}
+
+// Return a whole head-to-tail list of count nodes in one step
+void NodePool::releaseList(Node* head, Node* tail, int count) {
+    if (!head || count <= 0) {
+        return;
+    }
+
+    if (cacheDestroyed) {
+        SlabRegistry& shared = registry();
+        lock_guard<mutex> guard(shared.lock);
+        tail->next = shared.freeList;
+        shared.freeList = head;
+        shared.freeCount += count;
+        shared.retiredReleased += count;
+        return;
+    }
+
+    ThreadCache& cache = localCache();
+    tail->next = cache.freeList;
+    cache.freeList = head;
+    cache.freeCount += count;
+    bump(cache.released, count);
+    if (cache.freeCount > LOCAL_FREE_LIMIT) {
+        cache.trim();
+    }
+}
+
+// Sum the counters of every live thread and every exited thread
+NodePoolStats NodePool::getStats() {
+    SlabRegistry& shared = registry();
+    lock_guard<mutex> guard(shared.lock);
+    NodePoolStats stats;
+    totals(shared, stats.nodesAllocated, stats.nodesReleased);
+    stats.nodesAllocated -= shared.resetAllocated;
+    stats.nodesReleased -= shared.resetReleased;
+    stats.slabAllocations = shared.slabAllocations;
+    stats.bytesReserved = shared.slabs.size() * NODES_PER_SLAB * sizeof(Node);
+    return stats;
+}
+
+// Reset the counters (slabs already reserved stay reserved); each thread's counters are
+// written only by that thread, so the current totals are recorded and subtracted instead
+void NodePool::resetStats() {
+    SlabRegistry& shared = registry();
+    lock_guard<mutex> guard(shared.lock);
+    totals(shared, shared.resetAllocated, shared.resetReleased);
+    shared.slabAllocations = 0;
+}
@@ -0,0 +1,50 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the NodePool class, a slab
+    allocator for the nodes of the LargeNumber linked list.
+    Nodes are carved out of large slabs and recycled through
+    per-thread free lists, so building and clearing a list
+    no longer costs one heap call per node. Whole lists can
+    be released in a single step, and allocation counters
+    report how often the heap is actually reached.
+    Slabs are never returned to the operating system: nodes
+    released after a peak are kept for reuse, so the memory a
+    program reserves stays at its largest list total until it
+    exits (bytesReserved reports it).
+    This file requires <cstddef>.
+-------------------------------------------------- */
+
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>
+
+struct Node;
+
+// Allocation counters for the node pool
+struct NodePoolStats {
+    size_t nodesAllocated;  // Nodes handed out by allocate()
+    size_t nodesReleased;   // Nodes returned by release() or releaseList()
+    size_t slabAllocations; // Heap calls made to obtain new slabs
+    size_t bytesReserved;   // Total bytes held in slabs
+};
+
+class NodePool {
+public:
+
+    // Node allocation and release
+    static Node* allocate();
+    static void release(Node* node);
+    static void releaseList(Node* head, Node* tail, int count);
+
+    // Allocation counters
+    static NodePoolStats getStats();
+    static void resetStats();
+
+private:
+    NodePool() = delete;
+};
+
+#endif // NODE_POOL_H
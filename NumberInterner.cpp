@@ -0,0 +1,77 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the NumberInterner class defined in
+    NumberInterner.h. The table is an unordered set keyed by the
+    LargeNumber hash and signed equality; the first lookup of a
+    value hashes its limbs, and equality with the interned copy
+    is then settled by the shared blocks alone.
+    It requires NumberInterner.h, <cstddef>, and <mutex> to run.
+-------------------------------------------------- */
+
+#include "NumberInterner.h"
+#include <cstddef>
+#include <mutex>
+
+using namespace std;
+
+// Start empty
+NumberInterner::NumberInterner() : memoryBytes(0) {
+}
+
+// Return a copy of the interned value equal to number, interning number if it is new
+LargeNumber NumberInterner::intern(const LargeNumber& number) {
+    lock_guard<mutex> guard(lock);
+    auto inserted = values.insert(number);
+    if (inserted.second) {
+        memoryBytes += inserted.first->getMemoryBytes();
+    }
+    return *inserted.first;
+}
+
+// Clear a copy returned by intern(), dropping its value if it was the last copy outside the table
+void NumberInterner::release(LargeNumber& number) {
+    lock_guard<mutex> guard(lock);
+    auto value = values.find(number);
+    number = LargeNumber();
+    if (value != values.end() && !value->isShared()) {
+        memoryBytes -= value->getMemoryBytes();
+        values.erase(value);
+    }
+}
+
+// Drop the values nothing outside the table shares any more
+size_t NumberInterner::prune() {
+    lock_guard<mutex> guard(lock);
+    size_t dropped = 0;
+    for (auto value = values.begin(); value != values.end();) {
+        if (value->isShared()) {
+            ++value;
+            continue;
+        }
+        memoryBytes -= value->getMemoryBytes();
+        value = values.erase(value);
+        dropped++;
+    }
+    return dropped;
+}
+
+// Drop every value
+void NumberInterner::clear() {
+    lock_guard<mutex> guard(lock);
+    values.clear();
+    memoryBytes = 0;
+}
+
+// Values held
+size_t NumberInterner::getSize() const {
+    lock_guard<mutex> guard(lock);
+    return values.size();
+}
+
+// Bytes of the held values' blocks
+size_t NumberInterner::getMemoryBytes() const {
+    lock_guard<mutex> guard(lock);
+    return memoryBytes;
+}
@@ -0,0 +1,62 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the NumberInterner class, a table
+    that keeps one copy of each distinct LargeNumber value.
+    Interning a number returns a copy of the value already in the
+    table, or adds the number if it is new; since copies share
+    their blocks, every equal value interned this way is held in
+    one set of blocks, and two of them compare equal without
+    reading their limbs. A shared block is copied when one of its
+    sharers is changed in place, so interned values suit operands
+    that are read many times rather than numbers being built up.
+    The table only grows until release() hands back one copy and
+    drops its value if that was the last one outside the table,
+    prune() drops every value no copy outside it still shares, or
+    clear() empties it. It is safe to use from several threads.
+    This file requires LargeNumber.h, <cstddef>, <mutex>, and
+    <unordered_set>.
+-------------------------------------------------- */
+
+#ifndef NUMBER_INTERNER_H
+#define NUMBER_INTERNER_H
+
+#include "LargeNumber.h"
+#include <cstddef>
+#include <mutex>
+#include <unordered_set>
+
+class NumberInterner {
+public:
+
+    // Start empty
+    NumberInterner();
+
+    NumberInterner(const NumberInterner&) = delete;
+    NumberInterner& operator=(const NumberInterner&) = delete;
+
+    // Return a copy of the interned value equal to number, interning number if it is new
+    LargeNumber intern(const LargeNumber& number);
+
+    // Clear a copy returned by intern(), dropping its value if nothing outside the table
+    // shares it any more
+    void release(LargeNumber& number);
+
+    // Drop the values nothing outside the table shares any more; returns how many were dropped
+    size_t prune();
+
+    // Drop every value
+    void clear();
+
+    // Values held, and the bytes of their blocks
+    size_t getSize() const;
+    size_t getMemoryBytes() const;
+
+private:
+    mutable std::mutex lock;
+    std::unordered_set<LargeNumber> values;
+    size_t memoryBytes;
+};
+
+#endif // NUMBER_INTERNER_H
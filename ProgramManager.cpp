@@ -7,19 +7,35 @@
     program flow, and output formatting for the large number
     arithmetic calculator. It manages the interaction between
     the user and the LargeNumber operations.
-    It requires ProgramManager.h, <iostream>, <iomanip>,
-    <limits>, <algorithm>, and <stdexcept> to run.
+    Batch mode skips the banners and node dumps: results are
+    rendered into one output buffer that is written in large
+    chunks, and a failing line is reported in the output
+    without stopping the batch.
+    The pipelined batch runs the same parse, apply, and format
+    steps through BatchPipeline when it is built. The batch mul
+    uses an installed ResultCache.
+    It requires ProgramManager.h, BatchPipeline.h, LargeNumberStats.h, ResultCache.h, <iostream>,
+    <iomanip>, <limits>, <algorithm>, <chrono>, <stdexcept>, and
+    <vector> to run.
 -------------------------------------------------- */
 
 #include "ProgramManager.h"
+#include "BatchPipeline.h"
+#include "LargeNumberStats.h"
+#include "ResultCache.h"
 #include <iostream>
 #include <iomanip> // For formatting (setw() and setfill())
 #include <limits> // For numeric limits
-#include <algorithm> // For element ranges (all_of())
-#include <stdexcept> // For exceptions (out_of_range)
+#include <algorithm> // For element ranges (all_of() and find())
+#include <chrono> // For batch throughput (steady_clock)
+#include <stdexcept> // For exceptions (out_of_range and domain_error)
+#include <vector>
 
 using namespace std;
 
+// Batch output is flushed to the stream once it passes this many bytes
+static const size_t BATCH_FLUSH_BYTES = 1 << 16;
+
 // Run main program loop
 void ProgramManager::run() {
     cout << "\n+---------------------------------------------+" << endl;
@@ -34,31 +50,49 @@ void ProgramManager::run() {
         cout << "+--- Menu ------------------------------------+" << endl;
         cout << "| 1. Add to Number                            |" << endl;
         cout << "| 2. Subtract from Number                     |" << endl;
-        cout << "| 3. Insert a Node                            |" << endl;
-        cout << "| 4. Delete a Node                            |" << endl;
-        cout << "| 5. Modify a Node                            |" << endl;
-        cout << "| 6. Exit                                     |" << endl;
+        cout << "| 3. Multiply Number                          |" << endl;
+        cout << "| 4. Divide Number                            |" << endl;
+        cout << "| 5. Modulo Number                            |" << endl;
+        cout << "| 6. Insert a Node                            |" << endl;
+        cout << "| 7. Delete a Node                            |" << endl;
+        cout << "| 8. Modify a Node                            |" << endl;
+        cout << "| 9. Show Statistics                          |" << endl;
+        cout << "| 10. Exit                                    |" << endl;
         cout << "+---------------------------------------------+" << endl;
 
-        int choice = getValidIntegerInput("| Enter your choice: ", 1, 6);
+        int choice = getValidIntegerInput("| Enter your choice: ", 1, 10);
 
         switch (choice) {
         case 1:
-            number = performAddition(number);
+            performAddition(number);
             break;
         case 2:
-            number = performSubtraction(number);
+            performSubtraction(number);
             break;
         case 3:
-            manipulateNode(number, "Insert");
+            performMultiplication(number);
             break;
         case 4:
-            manipulateNode(number, "Delete");
+            performDivision(number);
             break;
         case 5:
-            manipulateNode(number, "Modify");
+            performModulo(number);
             break;
         case 6:
+            manipulateNode(number, "Insert");
+            break;
+        case 7:
+            manipulateNode(number, "Delete");
+            break;
+        case 8:
+            manipulateNode(number, "Modify");
+            break;
+        case 9:
+            cout << "+--- Statistics ------------------------------+" << endl;
+            printStatistics(cout);
+            cout << "+---------------------------------------------+" << endl;
+            break;
+        case 10:
             cout << "+--- Thank You -------------------------------+" << endl;
             cout << "| Thank you for using the program.            |" << endl;
             cout << "| Goodbye!                                    |" << endl;
@@ -68,22 +102,336 @@ void ProgramManager::run() {
     }
 }
 
-// Perform addition
-LargeNumber ProgramManager::performAddition(const LargeNumber& number) {
+// Run a batch of operations, one per line; blank lines and lines starting with # are skipped
+size_t ProgramManager::runBatch(istream& input, ostream& output, ostream& log) {
+    LargeNumber number("0");
+    string line;
+    string buffer;
+    Tokens tokens;
+    size_t lineNumber = 0;
+    size_t operations = 0;
+    size_t errors = 0;
+    size_t bytes = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    while (getline(input, line)) {
+        lineNumber++;
+        bytes += line.size() + 1;
+        splitTokens(line, tokens);
+        if (tokens.empty() || line[tokens[0].first] == '#') {
+            continue;
+        }
+        operations++;
+
+        // Report a failing line and keep going with the number unchanged
+        try {
+            runBatchOperation(line, tokens, number, buffer);
+        }
+        catch (const exception& e) {
+            errors++;
+            buffer += "error line " + to_string(lineNumber) + ": " + e.what() + "\n";
+        }
+
+        if (buffer.size() >= BATCH_FLUSH_BYTES) {
+            output.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    output.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+    output.flush();
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    reportBatch(log, "Batch", operations, errors, bytes, seconds);
+    return errors;
+}
+
+// Run a batch with its steps overlapped on separate threads when the pipeline is built
+size_t ProgramManager::runPipelinedBatch(istream& input, ostream& output, ostream& log) {
+#ifdef LARGE_NUMBER_PIPELINE
+    return BatchPipeline::run(input, output, log);
+#else
+    log << "Pipelined batches need a compiler with C++20 coroutines; running a plain batch" << endl;
+    return runBatch(input, output, log);
+#endif
+}
+
+// Run one batch operation outside a batch, such as a service request
+void ProgramManager::runOperation(const string& line, LargeNumber& number, string& output, bool allowFiles) {
+    Tokens tokens;
+    splitTokens(line, tokens);
+    if (tokens.empty() || line[tokens[0].first] == '#') {
+        return;
+    }
+    string operation = line.substr(tokens[0].first, tokens[0].second);
+    if (!allowFiles && isFileOperation(operation)) {
+        throw invalid_argument("File operation \"" + operation + "\" is not allowed");
+    }
+    runBatchOperation(line, tokens, number, output);
+}
+
+// Write the statistics snapshot and the installed cache's counters
+void ProgramManager::printStatistics(ostream& output) {
+    LargeNumberStats::print(LargeNumberStats::getStats(), output);
+    ResultCache* cache = ResultCache::getInstalled();
+    if (cache) {
+        output << "Result cache: " << cache->getHitCount() << " hits, " << cache->getMissCount() << " misses, "
+            << cache->getEvictionCount() << " evictions, " << cache->getEntryCount() << " entries in "
+            << cache->getMemoryBytes() << " bytes" << endl;
+    }
+}
+
+// Report a batch's throughput without disturbing the log's formatting
+void ProgramManager::reportBatch(ostream& log, const char* label, size_t operations, size_t errors, size_t bytes, double seconds) {
+    double rate = seconds > 0 ? operations / seconds : 0;
+    ios::fmtflags flags = log.flags();
+    streamsize precision = log.precision();
+    log << label << ": " << operations << " operations (" << errors << " failed) in "
+        << fixed << setprecision(3) << seconds << " s, " << setprecision(0) << rate << " ops/s, "
+        << setprecision(2) << (seconds > 0 ? bytes / seconds / 1e6 : 0) << " MB/s of input" << endl;
+    log.flags(flags);
+    log.precision(precision);
+}
+
+// Split a line on blank space
+void ProgramManager::splitTokens(const string& line, Tokens& tokens) {
+    tokens.clear();
+    size_t position = line.find_first_not_of(" \t\r\f\v");
+    while (position != string::npos) {
+        size_t end = line.find_first_of(" \t\r\f\v", position);
+        size_t length = (end == string::npos ? line.size() : end) - position;
+        tokens.emplace_back(position, length);
+        position = line.find_first_not_of(" \t\r\f\v", position + length);
+    }
+}
+
+// Apply one batch operation and append its result line to the buffer
+void ProgramManager::runBatchOperation(const string& line, const Tokens& tokens, LargeNumber& number, string& buffer) {
+    BatchStep step;
+    parseBatchOperation(line, tokens, step);
+    applyBatchOperation(step, number);
+    formatBatchResult(step, number, buffer);
+}
+
+// Check a batch line's operation name, then its operands, and parse them without touching the current number
+void ProgramManager::parseBatchOperation(const string& line, const Tokens& tokens, BatchStep& step) {
+    string& operation = step.operation;
+    operation = line.substr(tokens[0].first, tokens[0].second);
+    if (!isBatchOperation(operation)) {
+        throw invalid_argument("Unknown operation \"" + operation + "\"");
+    }
+    size_t operands = operation == "print" ? 0 : (operation == "delete" ? 1 : (operation == "insert" || operation == "modify" || operation == "powmod" || operation == "binomial" ? 2 : 1));
+    if (tokens.size() != operands + 1) {
+        throw invalid_argument("Expected " + to_string(operands) + " operand(s) for \"" + operation + "\"");
+    }
+
+    // Node edits use the menu's 1-based positions (insert accepts 0 for the front)
+    if (operation == "insert" || operation == "modify") {
+        step.position = parsePosition(line, tokens[1]);
+        step.value = parsePosition(line, tokens[2]);
+    }
+    else if (operation == "delete") {
+        step.position = parsePosition(line, tokens[1]);
+    }
+    else if (operation == "powmod") {
+        step.operands.emplace_back(line.data() + tokens[1].first, tokens[1].second);
+        step.operands.emplace_back(line.data() + tokens[2].first, tokens[2].second);
+    }
+    else if (isFileOperation(operation)) {
+        step.path = line.substr(tokens[1].first, tokens[1].second);
+    }
+
+    // Generators take plain counts rather than numbers
+    else if (isGeneratorOperation(operation)) {
+        for (size_t i = 1; i < tokens.size(); i++) {
+            step.counts.push_back(parseCount(line, tokens[i]));
+        }
+    }
+    else if (operation != "print") {
+        step.operands.emplace_back(line.data() + tokens[1].first, tokens[1].second);
+    }
+}
+
+// Apply a parsed batch operation to the current number
+void ProgramManager::applyBatchOperation(BatchStep& step, LargeNumber& number) {
+    const string& operation = step.operation;
+    if (operation == "insert") {
+        number.insertNode(step.position, step.value);
+    }
+    else if (operation == "delete") {
+        number.deleteNode(step.position - 1);
+    }
+    else if (operation == "modify") {
+        number.modifyNode(step.position - 1, step.value);
+    }
+
+    // Raise the current number to an exponent modulo a modulus
+    else if (operation == "powmod") {
+        number = LargeNumber::powmod(number, step.operands[0], step.operands[1]);
+    }
+    else if (operation == "factorial") {
+        number = LargeNumber::factorial(step.counts[0]);
+    }
+    else if (operation == "binomial") {
+        number = LargeNumber::binomial(step.counts[0], step.counts[1]);
+    }
+    else if (operation == "fibonacci") {
+        number = LargeNumber::fibonacci(step.counts[0]);
+    }
+    else if (operation == "pow") {
+        number = LargeNumber::pow(number, step.counts[0]);
+    }
+    else if (operation == "load") {
+        number = LargeNumber::loadFromFile(step.path);
+    }
+    else if (operation == "loadbin") {
+        number = LargeNumber::loadBinary(step.path);
+    }
+    else if (operation == "save") {
+        number.saveToFile(step.path);
+    }
+    else if (operation == "savebin") {
+        number.saveBinary(step.path);
+    }
+    else if (operation == "set") {
+        number = move(step.operands[0]);
+    }
+
+    else if (operation == "add") {
+        number += step.operands[0];
+    }
+    else if (operation == "sub") {
+        number -= step.operands[0];
+    }
+
+    // Products go through a ResultCache when one is installed
+    else if (operation == "mul") {
+        ResultCache* cache = ResultCache::getInstalled();
+        if (cache) {
+            number = cache->multiply(number, step.operands[0]);
+        }
+        else {
+            number *= step.operands[0];
+        }
+    }
+    else if (operation == "div") {
+        LargeNumber::divmod(number, step.operands[0], number, step.remainder);
+    }
+    else if (operation == "mod") {
+        number %= step.operands[0];
+    }
+}
+
+// Append the result line of an applied batch operation
+void ProgramManager::formatBatchResult(const BatchStep& step, const LargeNumber& number, string& buffer) {
+
+    // Digit and binary files may be huge, so loading and saving only confirm the path
+    if (isFileOperation(step.operation)) {
+        buffer += (step.operation.compare(0, 4, "load") == 0 ? "loaded " : "saved ") + step.path + "\n";
+        return;
+    }
+    buffer += number.toString();
+    if (step.operation == "div") {
+        buffer += ' ';
+        buffer += step.remainder.toString();
+    }
+    buffer += '\n';
+}
+
+// Check for an operation batch mode knows
+bool ProgramManager::isBatchOperation(const string& operation) {
+    static const char* const names[] = {
+        "set", "add", "sub", "mul", "div", "mod", "powmod", "print", "insert", "delete", "modify",
+        "factorial", "binomial", "fibonacci", "pow", "load", "save", "loadbin", "savebin"
+    };
+    return find(begin(names), end(names), operation) != end(names);
+}
+
+// Check for the operations that load or save the number
+bool ProgramManager::isFileOperation(const string& operation) {
+    return operation == "load" || operation == "save" || operation == "loadbin" || operation == "savebin";
+}
+
+// Check for the operations that replace or raise the number by a count
+bool ProgramManager::isGeneratorOperation(const string& operation) {
+    return operation == "factorial" || operation == "binomial" || operation == "fibonacci" || operation == "pow";
+}
+
+// Read a node position or group value token (an int, so larger values are rejected too)
+int ProgramManager::parsePosition(const string& line, const pair<size_t, size_t>& token) {
+    string text = line.substr(token.first, token.second);
+    if (isValidInteger(text)) {
+        try {
+            return stoi(text);
+        }
+        catch (const out_of_range&) {
+        }
+    }
+    throw invalid_argument("Invalid integer \"" + text + "\"");
+}
+
+// Read a count token, such as a factorial's n (up to 2^64 - 1)
+uint64_t ProgramManager::parseCount(const string& line, const pair<size_t, size_t>& token) {
+    string text = line.substr(token.first, token.second);
+    bool digits = all_of(text.begin(), text.end(), [](char c) { return c >= '0' && c <= '9'; });
+    if (!digits || text.empty() || text.size() > 20 || (text.size() == 20 && text > "18446744073709551615")) {
+        throw invalid_argument("Invalid count \"" + text + "\"");
+    }
+    return stoull(text);
+}
+
+// Perform addition in place
+void ProgramManager::performAddition(LargeNumber& number) {
     cout << "+--- Addition ---------------------------------+" << endl;
     LargeNumber secondNumber = getInputNumber();
-    LargeNumber result = number + secondNumber;
-    printResult(result);
-    return result;
+    number += secondNumber;
+    printResult(number);
 }
 
-// Perform subtraction
-LargeNumber ProgramManager::performSubtraction(const LargeNumber& number) {
+// Perform subtraction in place
+void ProgramManager::performSubtraction(LargeNumber& number) {
     cout << "+--- Subtraction ------------------------------+" << endl;
     LargeNumber secondNumber = getInputNumber();
-    LargeNumber result = number - secondNumber;
-    printResult(result);
-    return result;
+    number -= secondNumber;
+    printResult(number);
+}
+
+// Perform multiplication
+void ProgramManager::performMultiplication(LargeNumber& number) {
+    cout << "+--- Multiplication ---------------------------+" << endl;
+    LargeNumber secondNumber = getInputNumber();
+    number *= secondNumber;
+    printResult(number);
+}
+
+// Perform division, keeping the number when the divisor is zero
+void ProgramManager::performDivision(LargeNumber& number) {
+    cout << "+--- Division ---------------------------------+" << endl;
+    LargeNumber secondNumber = getInputNumber();
+    try {
+        LargeNumber remainder;
+        LargeNumber::divmod(number, secondNumber, number, remainder);
+        printResult(number);
+        cout << "| Remainder: " << remainder << endl;
+        cout << "+---------------------------------------------+" << endl;
+    }
+    catch (const domain_error& e) {
+        cout << "| Error: " << e.what() << endl;
+        cout << "+---------------------------------------------+" << endl;
+    }
+}
+
+// Perform modulo, keeping the number when the divisor is zero
+void ProgramManager::performModulo(LargeNumber& number) {
+    cout << "+--- Modulo -----------------------------------+" << endl;
+    LargeNumber secondNumber = getInputNumber();
+    try {
+        number %= secondNumber;
+        printResult(number);
+    }
+    catch (const domain_error& e) {
+        cout << "| Error: " << e.what() << endl;
+        cout << "+---------------------------------------------+" << endl;
+    }
 }
 
 // Display result
@@ -96,12 +444,9 @@ void ProgramManager::printResult(const LargeNumber& result) {
 
 // Print nodes
 void ProgramManager::printNodes(const LargeNumber& number) {
-    Node* current = number.getHead();
-    int nodeCount = 1;
-    while (current) {
-        cout << "| Node " << setw(1) << nodeCount << " = " << setfill('0') << setw(3) << current->value << setfill(' ') << endl;
-        current = current->next;
-        nodeCount++;
+    vector<int> values = number.getNodeValues();
+    for (size_t i = 0; i < values.size(); i++) {
+        cout << "| Node " << setw(1) << i + 1 << " = " << setfill('0') << setw(3) << values[i] << setfill(' ') << endl;
     }
 }
 
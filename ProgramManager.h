@@ -6,15 +6,24 @@
     which handles the main program flow, user interaction,
     and operations for the large number arithmetic calculator.
     It includes method declarations for addition, subtraction,
-    node manipulation, and input validation.
-    This file requires LargeNumber.h and <string>.
+    multiplication, division, modulo, node manipulation, and
+    input validation, plus a batch mode that reads one operation
+    per line and writes only the results, which the calculator
+    service also uses to run each request, and a statistics dump.
+    This file requires LargeNumber.h, <cstddef>, <cstdint>, <iostream>,
+    <string>, <utility>, and <vector>.
 -------------------------------------------------- */
 
 #ifndef PROGRAM_MANAGER_H
 #define PROGRAM_MANAGER_H
 
 #include "LargeNumber.h"
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
 #include <string>
+#include <utility>
+#include <vector>
 
 class ProgramManager {
 public:
@@ -25,11 +34,34 @@ public:
     // Main program loop
     void run();
 
+    // Run operations such as "add 123", "insert 2 45", "factorial 1000", or "load digits.txt"
+    // without menus, writing one result line per operation to output and the throughput to
+    // log; returns the number of lines that failed
+    size_t runBatch(std::istream& input, std::ostream& output, std::ostream& log);
+
+    // Apply one batch operation line to a number and append its result line to output;
+    // throws on an invalid line, and does nothing for blank and # lines. Callers that
+    // must not touch the file system, such as the service, pass allowFiles = false, and
+    // load, save, loadbin, and savebin then throw invalid_argument
+    static void runOperation(const std::string& line, LargeNumber& number, std::string& output,
+        bool allowFiles = true);
+
+    // Run a batch like runBatch(), but with parsing, arithmetic, and output overlapped
+    // on three threads (see BatchPipeline); without C++20 coroutines it runs runBatch()
+    size_t runPipelinedBatch(std::istream& input, std::ostream& output, std::ostream& log);
+
+    // Write the LargeNumber statistics gathered so far, and the installed ResultCache's counters
+    void printStatistics(std::ostream& output);
+
 private:
+    friend class BatchPipeline; // Runs the batch steps on separate threads
 
     // Helper methods
-    LargeNumber performAddition(const LargeNumber& number);
-    LargeNumber performSubtraction(const LargeNumber& number);
+    void performAddition(LargeNumber& number);
+    void performSubtraction(LargeNumber& number);
+    void performMultiplication(LargeNumber& number);
+    void performDivision(LargeNumber& number);
+    void performModulo(LargeNumber& number);
     void printResult(const LargeNumber& result);
     void printNodes(const LargeNumber& number);
     LargeNumber getInputNumber();
@@ -39,6 +71,30 @@ private:
     // Node manipulation method
     void manipulateNode(LargeNumber& number, const std::string& operation);
 
+    // Batch mode helpers; an operation is parsed, applied, and formatted in separate
+    // steps so the pipelined batch can run each step on its own thread
+    typedef std::vector<std::pair<size_t, size_t>> Tokens; // Offset and length in the line
+    struct BatchStep {
+        std::string operation;
+        int position = 0;                  // Node edits: 1-based group position
+        int value = 0;                     // insert and modify: group value
+        std::string path;                  // File operations
+        std::vector<LargeNumber> operands; // Parsed numeric operands
+        std::vector<uint64_t> counts;      // Generators: n (and k), or the exponent
+        LargeNumber remainder;             // div
+    };
+    static void splitTokens(const std::string& line, Tokens& tokens);
+    static void runBatchOperation(const std::string& line, const Tokens& tokens, LargeNumber& number, std::string& buffer);
+    static void parseBatchOperation(const std::string& line, const Tokens& tokens, BatchStep& step);
+    static void applyBatchOperation(BatchStep& step, LargeNumber& number);
+    static void formatBatchResult(const BatchStep& step, const LargeNumber& number, std::string& buffer);
+    static bool isBatchOperation(const std::string& operation);
+    static bool isFileOperation(const std::string& operation);
+    static bool isGeneratorOperation(const std::string& operation);
+    static void reportBatch(std::ostream& log, const char* label, size_t operations, size_t errors, size_t bytes, double seconds);
+    static int parsePosition(const std::string& line, const std::pair<size_t, size_t>& token);
+    static uint64_t parseCount(const std::string& line, const std::pair<size_t, size_t>& token);
+
     // Input validation methods
     static bool isValidNumber(const std::string& input);
     static bool isValidInteger(const std::string& input);
@@ -0,0 +1,223 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the ResultCache class defined in
+    ResultCache.h. Entries live in a list ordered by use, and a
+    multimap from key hashes to list positions finds them, so a
+    lookup compares operands only on a hash match and moving an
+    entry to the front of the list never copies it. Kept values
+    are copies of the operands and results, so they share blocks
+    with them rather than duplicating them.
+    It requires ResultCache.h, <atomic>, <cstddef>, <list>, <mutex>,
+    <utility>, and <vector> to run.
+-------------------------------------------------- */
+
+#include "ResultCache.h"
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <utility> // For moving entries (move())
+#include <vector>
+
+using namespace std;
+
+const size_t ResultCache::DEFAULT_MAX_BYTES;
+atomic<ResultCache*> ResultCache::installed{ nullptr };
+
+// Cache results within maxBytes
+ResultCache::ResultCache(size_t maxBytes, NumberInterner* interner)
+    : maxBytes(maxBytes), interner(interner), memoryBytes(0), hits(0), misses(0), evictions(0) {
+}
+
+// Sum through the cache
+LargeNumber ResultCache::add(const LargeNumber& lhs, const LargeNumber& rhs) {
+    return compute(Operation::Add, lhs, rhs);
+}
+
+// Difference through the cache
+LargeNumber ResultCache::subtract(const LargeNumber& lhs, const LargeNumber& rhs) {
+    return compute(Operation::Subtract, lhs, rhs);
+}
+
+// Product through the cache
+LargeNumber ResultCache::multiply(const LargeNumber& lhs, const LargeNumber& rhs) {
+    return compute(Operation::Multiply, lhs, rhs);
+}
+
+// Combine the operation with both operand hashes (operand order matters, even for +)
+size_t ResultCache::hashKey(Operation operation, const LargeNumber& lhs, const LargeNumber& rhs) {
+    size_t hash = lhs.getHash();
+    hash ^= rhs.getHash() + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+    return hash ^ static_cast<size_t>(operation);
+}
+
+// Look up a result, making it the most recently used
+bool ResultCache::find(Operation operation, const LargeNumber& lhs, const LargeNumber& rhs, size_t hash, LargeNumber& result) {
+    lock_guard<mutex> guard(lock);
+    auto position = locate(operation, lhs, rhs, hash);
+    if (position == index.end()) {
+        misses++;
+        return false;
+    }
+    entries.splice(entries.begin(), entries, position->second);
+    result = position->second->result;
+    hits++;
+    return true;
+}
+
+// Keep a result, evicting the least recently used entries beyond the memory cap
+void ResultCache::store(Operation operation, const LargeNumber& lhs, const LargeNumber& rhs, size_t hash, const LargeNumber& result) {
+
+    // Count the blocks and the entry with its list and index nodes
+    size_t bytes = sizeof(Entry) + 4 * sizeof(void*) + sizeof(pair<size_t, void*>)
+        + lhs.getMemoryBytes() + rhs.getMemoryBytes() + result.getMemoryBytes();
+    if (bytes > maxBytes) {
+        return;
+    }
+
+    // Values are interned and released outside the lock, so the cache never waits on the interner
+    Entry entry{ operation, lhs, rhs, result, hash, bytes };
+    if (interner) {
+        entry.lhs = interner->intern(lhs);
+        entry.rhs = interner->intern(rhs);
+        entry.result = interner->intern(result);
+    }
+    vector<Entry> evicted;
+    {
+        lock_guard<mutex> guard(lock);
+
+        // Another thread may have stored the same result since this one missed
+        auto position = locate(operation, lhs, rhs, hash);
+        if (position != index.end()) {
+            entries.splice(entries.begin(), entries, position->second);
+            evicted.push_back(move(entry));
+        }
+        else {
+            while (!entries.empty() && memoryBytes + entry.bytes > maxBytes) {
+                auto last = prev(entries.end());
+                evicted.push_back(move(*last));
+                remove(last);
+                evictions++;
+            }
+            memoryBytes += entry.bytes;
+            entries.push_front(move(entry));
+            index.emplace(hash, entries.begin());
+        }
+    }
+    for (Entry& old : evicted) {
+        release(old);
+    }
+}
+
+// Drop every entry
+void ResultCache::clear() {
+    list<Entry> dropped;
+    {
+        lock_guard<mutex> guard(lock);
+        index.clear();
+        dropped.swap(entries);
+        memoryBytes = 0;
+    }
+    for (Entry& old : dropped) {
+        release(old);
+    }
+}
+
+// Lookups answered from the cache
+size_t ResultCache::getHitCount() const {
+    lock_guard<mutex> guard(lock);
+    return hits;
+}
+
+// Lookups that found nothing
+size_t ResultCache::getMissCount() const {
+    lock_guard<mutex> guard(lock);
+    return misses;
+}
+
+// Entries dropped to stay within the memory cap
+size_t ResultCache::getEvictionCount() const {
+    lock_guard<mutex> guard(lock);
+    return evictions;
+}
+
+// Entries held
+size_t ResultCache::getEntryCount() const {
+    lock_guard<mutex> guard(lock);
+    return entries.size();
+}
+
+// Bytes counted against the memory cap
+size_t ResultCache::getMemoryBytes() const {
+    lock_guard<mutex> guard(lock);
+    return memoryBytes;
+}
+
+// Route the batch operation mul through a cache, or stop with nullptr
+void ResultCache::install(ResultCache* cache) {
+    installed.store(cache, memory_order_release);
+}
+
+// Find an entry's index position, or the end of the index
+unordered_multimap<size_t, list<ResultCache::Entry>::iterator>::iterator ResultCache::locate(Operation operation,
+    const LargeNumber& lhs, const LargeNumber& rhs, size_t hash) {
+    auto range = index.equal_range(hash);
+    for (auto position = range.first; position != range.second; ++position) {
+        const Entry& entry = *position->second;
+        if (entry.operation == operation && entry.lhs == lhs && entry.rhs == rhs) {
+            return position;
+        }
+    }
+    return index.end();
+}
+
+// Remove an entry from the list, the index, and the memory count
+void ResultCache::remove(list<Entry>::iterator entry) {
+    auto range = index.equal_range(entry->hash);
+    for (auto position = range.first; position != range.second; ++position) {
+        if (position->second == entry) {
+            index.erase(position);
+            break;
+        }
+    }
+    memoryBytes -= entry->bytes;
+    entries.erase(entry);
+}
+
+// Look a result up, or work it out and store it; values held inline skip the cache
+LargeNumber ResultCache::compute(Operation operation, const LargeNumber& lhs, const LargeNumber& rhs) {
+    if (lhs.getMemoryBytes() == 0 && rhs.getMemoryBytes() == 0) {
+        return combine(operation, lhs, rhs);
+    }
+    size_t hash = hashKey(operation, lhs, rhs);
+    LargeNumber result;
+    if (!find(operation, lhs, rhs, hash, result)) {
+        result = combine(operation, lhs, rhs);
+        store(operation, lhs, rhs, hash, result);
+    }
+    return result;
+}
+
+// Work a result out directly
+LargeNumber ResultCache::combine(Operation operation, const LargeNumber& lhs, const LargeNumber& rhs) {
+    switch (operation) {
+    case Operation::Add:
+        return lhs + rhs;
+    case Operation::Subtract:
+        return lhs - rhs;
+    case Operation::Multiply:
+        return lhs * rhs;
+    }
+    return LargeNumber();
+}
+
+// Give the interned values of an entry no longer held back to the interner
+void ResultCache::release(Entry& entry) {
+    if (interner) {
+        interner->release(entry.lhs);
+        interner->release(entry.rhs);
+        interner->release(entry.result);
+    }
+}
@@ -0,0 +1,126 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the ResultCache class, a bounded
+    memo of LargeNumber sums, differences, and products keyed by
+    the operation and both operands. Entries are kept in least
+    recently used order, and storing one evicts the oldest ones
+    until the blocks the cache holds (operands and results, with
+    shared blocks counted in full) fit its memory cap. With a
+    NumberInterner, the operands and results it keeps are
+    interned first, so a value that appears in many entries is
+    held in one set of blocks, and an entry that is evicted or
+    cleared releases its values, so the interner drops those that
+    no other entry or caller still shares.
+    Callers opt in through add(), subtract(), and multiply(),
+    which answer from the cache when an operand is held in
+    blocks; smaller values are combined directly, as that is
+    cheaper than hashing them. LargeNumber's own operators never
+    consult it. A lookup hashes both operands, which takes a
+    little longer than adding them, so for sums and differences
+    a hit saves the result's blocks rather than time: callers
+    that keep repeated results hold one set of blocks instead of
+    one each. For products, hashing is linear and multiplying is
+    not, so a hit saves the time as well; that is why an
+    installed cache (the --cache option of the calculator's batch
+    mode and of CalculatorServer) answers the batch operation mul
+    and leaves add and sub to the in-place operators. It counts
+    hits, misses, and evictions, and is safe to use from several
+    threads.
+    This file requires LargeNumber.h, NumberInterner.h, <atomic>,
+    <cstddef>, <list>, <mutex>, and <unordered_map>.
+-------------------------------------------------- */
+
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include "LargeNumber.h"
+#include "NumberInterner.h"
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+class ResultCache {
+public:
+
+    // Operations whose results are cached
+    enum class Operation {
+        Add,
+        Subtract,
+        Multiply
+    };
+
+    // Memory cap used when none is given
+    static const size_t DEFAULT_MAX_BYTES = 64 << 20;
+
+    // Cache results within maxBytes, interning what is kept when an interner is given
+    explicit ResultCache(size_t maxBytes = DEFAULT_MAX_BYTES, NumberInterner* interner = nullptr);
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    // lhs + rhs, lhs - rhs, and lhs * rhs, from the cache when they are there and stored when
+    // they are not
+    LargeNumber add(const LargeNumber& lhs, const LargeNumber& rhs);
+    LargeNumber subtract(const LargeNumber& lhs, const LargeNumber& rhs);
+    LargeNumber multiply(const LargeNumber& lhs, const LargeNumber& rhs);
+
+    // Hash of an entry's key, for find() and store()
+    static size_t hashKey(Operation operation, const LargeNumber& lhs, const LargeNumber& rhs);
+
+    // Look up a result, making it the most recently used; counts a hit or a miss
+    bool find(Operation operation, const LargeNumber& lhs, const LargeNumber& rhs, size_t hash, LargeNumber& result);
+
+    // Keep a result, evicting the least recently used entries beyond the memory cap
+    void store(Operation operation, const LargeNumber& lhs, const LargeNumber& rhs, size_t hash, const LargeNumber& result);
+
+    // Drop every entry (the counters are kept)
+    void clear();
+
+    // Counters and sizes
+    size_t getHitCount() const;
+    size_t getMissCount() const;
+    size_t getEvictionCount() const;
+    size_t getEntryCount() const;
+    size_t getMemoryBytes() const;
+    size_t getMaxBytes() const { return maxBytes; }
+
+    // Route the batch operation mul through a cache, or stop with nullptr; the cache must
+    // outlive its installation
+    static void install(ResultCache* cache);
+    static ResultCache* getInstalled() { return installed.load(std::memory_order_acquire); }
+
+private:
+    struct Entry {
+        Operation operation;
+        LargeNumber lhs;
+        LargeNumber rhs;
+        LargeNumber result;
+        size_t hash;
+        size_t bytes;
+    };
+
+    mutable std::mutex lock;
+    std::list<Entry> entries; // Most recently used first
+    std::unordered_multimap<size_t, std::list<Entry>::iterator> index;
+    size_t maxBytes;
+    NumberInterner* interner;
+    size_t memoryBytes;
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+
+    static std::atomic<ResultCache*> installed;
+
+    std::unordered_multimap<size_t, std::list<Entry>::iterator>::iterator locate(Operation operation,
+        const LargeNumber& lhs, const LargeNumber& rhs, size_t hash);
+    void remove(std::list<Entry>::iterator entry);
+    void release(Entry& entry);
+    LargeNumber compute(Operation operation, const LargeNumber& lhs, const LargeNumber& rhs);
+    static LargeNumber combine(Operation operation, const LargeNumber& lhs, const LargeNumber& rhs);
+};
+
+#endif // RESULT_CACHE_H
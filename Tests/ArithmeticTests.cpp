@@ -0,0 +1,383 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file tests LargeNumber arithmetic against
+    ReferenceArithmetic: +, -, and their in-place forms with every
+    limb kernel set the processor supports, long carry and borrow
+    runs, the parallel paths with a lowered cutoff, *, / and %
+    with their signs, and each multiplication and division
+    algorithm forced at the top level, on their own and with
+    lowered thresholds so the recursive steps mix algorithms too.
+    Operand lengths sit on both sides of the inline, limb, block,
+    and algorithm boundaries, and values of up to 72 digits must
+    be built, added, subtracted, and compared without a block.
+    It requires TestHarness.h, ReferenceArithmetic.h, Division.h,
+    LargeNumber.h, LimbKernels.h, Multiplication.h, NodePool.h, ThreadPool.h,
+    <cstdint>, <iostream>, <random>, <stdexcept>, <string>, and
+    <vector> to run.
+-------------------------------------------------- */
+
+#include "TestHarness.h"
+#include "ReferenceArithmetic.h"
+#include "../Division.h"
+#include "../LargeNumber.h"
+#include "../LimbKernels.h"
+#include "../Multiplication.h"
+#include "../NodePool.h"
+#include "../ThreadPool.h"
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept> // For the zero divisor (domain_error)
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+    // Digit counts around 18-digit limbs, the 72-digit inline limit, and 2304-digit blocks
+    const size_t ADD_LENGTHS[] = { 1, 17, 18, 19, 72, 73, 200, 2303, 2304, 2305, 5000, 20000 };
+
+    // Word counts around the default Karatsuba, Toom-3, and NTT thresholds
+    const size_t MULTIPLY_LENGTHS[] = { 1, 2, 31, 33, 255, 257, 800, 1600 };
+
+    // Check +, -, +=, and -= on one pair of operands
+    void checkAddSubtract(const string& a, const string& b) {
+        LargeNumber x(a);
+        LargeNumber y(b);
+        string sum = ReferenceArithmetic::add(a, b);
+        string difference = ReferenceArithmetic::subtract(a, b);
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(x + y), sum);
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(x - y), difference);
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(y - x), ReferenceArithmetic::subtract(b, a));
+
+        LargeNumber inPlace(x);
+        inPlace += y;
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(inPlace), sum);
+        inPlace -= y;
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(inPlace), a);
+        inPlace -= y;
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(inPlace), difference);
+    }
+
+    // Random signed pairs across ADD_LENGTHS
+    void checkRandomAddSubtract(mt19937_64& generator) {
+        for (size_t aLength : ADD_LENGTHS) {
+            for (size_t bLength : ADD_LENGTHS) {
+                checkAddSubtract(ReferenceArithmetic::randomDecimal(aLength, generator, true),
+                    ReferenceArithmetic::randomDecimal(bLength, generator, true));
+            }
+        }
+    }
+
+    // Check the forced-algorithm multiply on word operands of the given lengths
+    void checkMultiplyWords(size_t aWords, size_t bWords, MultiplicationAlgorithm algorithm, mt19937_64& generator) {
+        string a = ReferenceArithmetic::randomDecimal(aWords * 9, generator);
+        string b = ReferenceArithmetic::randomDecimal(bWords * 9, generator);
+        vector<uint32_t> product;
+        Multiplication::multiply(ReferenceArithmetic::toWords(a), ReferenceArithmetic::toWords(b), product, algorithm);
+        CHECK_EQUAL(ReferenceArithmetic::fromWords(product), ReferenceArithmetic::multiply(a, b));
+    }
+
+    // Check the forced-algorithm divide: quotient * divisor + remainder == dividend, remainder < divisor
+    void checkDivideWords(const string& dividend, const string& divisor, DivisionAlgorithm algorithm) {
+        vector<uint32_t> quotient;
+        vector<uint32_t> remainder;
+        Division::divide(ReferenceArithmetic::toWords(dividend), ReferenceArithmetic::toWords(divisor),
+            quotient, remainder, algorithm);
+        string q = ReferenceArithmetic::fromWords(quotient);
+        string r = ReferenceArithmetic::fromWords(remainder);
+        CHECK_EQUAL(ReferenceArithmetic::add(ReferenceArithmetic::multiply(q, divisor), r), dividend);
+        CHECK(ReferenceArithmetic::compare(r, divisor) < 0);
+    }
+
+    // Dividend and divisor word lengths for the division tests
+    struct DivisionShape {
+        size_t dividendWords;
+        size_t divisorWords;
+    };
+
+    const DivisionShape DIVISION_SHAPES[] = { { 1, 1 }, { 2, 1 }, { 10, 3 }, { 60, 50 }, { 200, 100 },
+        { 600, 150 }, { 1500, 500 }, { 1200, 1190 }, { 100, 120 } };
+}
+
+LARGE_NUMBER_TEST(arithmetic, add_subtract_random) {
+    mt19937_64 generator(1);
+    checkRandomAddSubtract(generator);
+}
+
+LARGE_NUMBER_TEST(arithmetic, add_subtract_carry_runs) {
+    mt19937_64 generator(2);
+    for (size_t length : ADD_LENGTHS) {
+        checkAddSubtract(string(length, '9'), "1");
+        checkAddSubtract("1" + string(length, '0'), "1");
+        for (int i = 0; i < 4; i++) {
+            checkAddSubtract(ReferenceArithmetic::runDecimal(length, generator),
+                ReferenceArithmetic::runDecimal(length, generator));
+        }
+    }
+
+    // Equal magnitudes cancel to a zero that is not negative
+    LargeNumber a("-123456789012345678901234567890123456789012345678901234567890123456789012345678901");
+    LargeNumber zero = a - a;
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(zero), string("0"));
+    CHECK(!zero.isNegative());
+}
+
+LARGE_NUMBER_TEST(arithmetic, add_subtract_each_kernel_set) {
+    LimbKernelSet detected = LimbKernels::getKernelSet();
+    const LimbKernelSet sets[] = { LimbKernelSet::Scalar, LimbKernelSet::SSE42, LimbKernelSet::AVX2 };
+    for (LimbKernelSet set : sets) {
+        if (!LimbKernels::setKernelSet(set)) {
+            cout << "    " << LimbKernels::getKernelSetName(set) << " not supported here, skipped" << endl;
+            continue;
+        }
+        mt19937_64 generator(3);
+        checkRandomAddSubtract(generator);
+        for (size_t length : ADD_LENGTHS) {
+            checkAddSubtract(ReferenceArithmetic::runDecimal(length, generator),
+                ReferenceArithmetic::runDecimal(length, generator));
+        }
+
+        // The raw kernels against limb-by-limb arithmetic, at every length up to a few vectors
+        const uint64_t base = LargeNumber::LIMB_BASE;
+        for (int count = 0; count <= 19; count++) {
+            vector<uint64_t> a(count);
+            vector<uint64_t> b(count);
+            for (int i = 0; i < count; i++) {
+                a[i] = generator() % 4 == 0 ? base - 1 : generator() % base;
+                b[i] = generator() % 4 == 0 ? base - 1 - a[i] : generator() % base;
+            }
+            vector<uint64_t> out(count);
+            uint64_t carry = LimbKernels::add(out.data(), a.data(), b.data(), count, 1);
+            uint64_t expectedCarry = 1;
+            for (int i = 0; i < count; i++) {
+                uint64_t total = a[i] + b[i] + expectedCarry;
+                expectedCarry = total >= base ? 1 : 0;
+                CHECK_EQUAL(out[i], total - expectedCarry * base);
+            }
+            CHECK_EQUAL(carry, expectedCarry);
+
+            uint64_t borrow = LimbKernels::subtract(out.data(), a.data(), b.data(), count, 1);
+            uint64_t expectedBorrow = 1;
+            for (int i = 0; i < count; i++) {
+                uint64_t subtrahend = b[i] + expectedBorrow;
+                uint64_t difference = a[i] >= subtrahend ? a[i] - subtrahend : a[i] + base - subtrahend;
+                expectedBorrow = a[i] >= subtrahend ? 0 : 1;
+                CHECK_EQUAL(out[i], difference);
+            }
+            CHECK_EQUAL(borrow, expectedBorrow);
+        }
+    }
+    LimbKernels::setKernelSet(detected);
+}
+
+LARGE_NUMBER_TEST(arithmetic, parallel_paths) {
+    size_t cutoff = ThreadPool::getParallelCutoff();
+    ThreadPool::setParallelCutoff(1000);
+    mt19937_64 generator(4);
+    const size_t lengths[] = { 999, 5000, 40000 };
+    for (size_t aLength : lengths) {
+        for (size_t bLength : lengths) {
+            string a = ReferenceArithmetic::randomDecimal(aLength, generator, true);
+            string b = ReferenceArithmetic::randomDecimal(bLength, generator, true);
+            checkAddSubtract(a, b);
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber(a)), a);
+        }
+        checkAddSubtract(string(aLength, '9'), "1");
+    }
+    ThreadPool::setParallelCutoff(cutoff);
+}
+
+LARGE_NUMBER_TEST(arithmetic, compare_magnitude) {
+    mt19937_64 generator(5);
+    for (size_t aLength : ADD_LENGTHS) {
+        for (size_t bLength : ADD_LENGTHS) {
+            string a = ReferenceArithmetic::randomDecimal(aLength, generator, true);
+            string b = ReferenceArithmetic::randomDecimal(bLength, generator, true);
+            string aMagnitude = a[0] == '-' ? a.substr(1) : a;
+            string bMagnitude = b[0] == '-' ? b.substr(1) : b;
+            int expected = ReferenceArithmetic::compare(aMagnitude, bMagnitude);
+            int actual = LargeNumber(a).compareMagnitude(LargeNumber(b));
+            CHECK_EQUAL((actual > 0) - (actual < 0), expected);
+        }
+    }
+}
+
+LARGE_NUMBER_TEST(arithmetic, small_values_take_no_blocks) {
+    mt19937_64 generator(14);
+    NodePool::resetStats();
+
+    // Every length up to 71 digits, so sums and differences stay within the 72-digit inline limit
+    for (size_t aLength = 1; aLength <= 71; aLength++) {
+        for (size_t bLength = 1; bLength <= 71; bLength += 7) {
+            string a = ReferenceArithmetic::randomDecimal(aLength, generator, true);
+            string b = ReferenceArithmetic::randomDecimal(bLength, generator, true);
+            LargeNumber x(a);
+            LargeNumber y(b);
+            LargeNumber sum = x + y;
+            LargeNumber difference = x - y;
+            LargeNumber inPlace(x);
+            inPlace += y;
+            inPlace -= y;
+            int order = x.compareMagnitude(y);
+            bool equal = x == y;
+            CHECK_EQUAL(x.getMemoryBytes() + y.getMemoryBytes() + sum.getMemoryBytes() + difference.getMemoryBytes()
+                + inPlace.getMemoryBytes(), size_t(0));
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(sum), ReferenceArithmetic::add(a, b));
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(inPlace), a);
+            CHECK(equal == (a == b));
+            string aMagnitude = a[0] == '-' ? a.substr(1) : a;
+            string bMagnitude = b[0] == '-' ? b.substr(1) : b;
+            CHECK_EQUAL((order > 0) - (order < 0), ReferenceArithmetic::compare(aMagnitude, bMagnitude));
+        }
+    }
+    CHECK_EQUAL(NodePool::getStats().nodesAllocated, size_t(0));
+
+    // 72 nines are the largest inline value; one more moves the sum into a block, and
+    // taking it away again brings the value back inline
+    LargeNumber largest(string(72, '9'));
+    LargeNumber one("1");
+    CHECK_EQUAL(largest.getMemoryBytes(), size_t(0));
+    CHECK_EQUAL(LargeNumber(string(73, '1')).getMemoryBytes(), sizeof(Node));
+    LargeNumber carried = largest + one;
+    CHECK_EQUAL(carried.getMemoryBytes(), sizeof(Node));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(carried), "1" + string(72, '0'));
+    CHECK_EQUAL((carried - one).getMemoryBytes(), size_t(0));
+    LargeNumber grown(largest);
+    grown += one;
+    CHECK_EQUAL(grown.getMemoryBytes(), sizeof(Node));
+
+    // Editing a node moves even a small value into a block
+    LargeNumber edited("123456");
+    CHECK_EQUAL(edited.getMemoryBytes(), size_t(0));
+    edited.modifyNode(0, 7);
+    CHECK_EQUAL(edited.getMemoryBytes(), sizeof(Node));
+}
+
+LARGE_NUMBER_TEST(arithmetic, multiply_operator) {
+    mt19937_64 generator(6);
+    const size_t lengths[] = { 1, 18, 72, 73, 300, 2305, 8000 };
+    for (size_t aLength : lengths) {
+        for (size_t bLength : lengths) {
+            string a = ReferenceArithmetic::randomDecimal(aLength, generator, true);
+            string b = ReferenceArithmetic::randomDecimal(bLength, generator, true);
+            LargeNumber product = LargeNumber(a) * LargeNumber(b);
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(product), ReferenceArithmetic::multiply(a, b));
+        }
+    }
+
+    LargeNumber square("-" + string(3000, '9'));
+    square *= square;
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(square), ReferenceArithmetic::multiply(string(3000, '9'), string(3000, '9')));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber("-12345") * LargeNumber("0")), string("0"));
+}
+
+LARGE_NUMBER_TEST(arithmetic, multiply_each_algorithm) {
+    mt19937_64 generator(7);
+    const MultiplicationAlgorithm algorithms[] = { MultiplicationAlgorithm::Schoolbook, MultiplicationAlgorithm::Karatsuba,
+        MultiplicationAlgorithm::ToomCook3, MultiplicationAlgorithm::NumberTheoretic };
+    for (MultiplicationAlgorithm algorithm : algorithms) {
+        for (size_t aWords : MULTIPLY_LENGTHS) {
+            for (size_t bWords : MULTIPLY_LENGTHS) {
+                checkMultiplyWords(aWords, bWords, algorithm, generator);
+            }
+        }
+    }
+}
+
+LARGE_NUMBER_TEST(arithmetic, multiply_lowered_thresholds) {
+    MultiplicationThresholds thresholds = Multiplication::getThresholds();
+    MultiplicationThresholds lowered;
+    lowered.karatsuba = 4;
+    lowered.toomCook3 = 12;
+    lowered.numberTheoretic = 100;
+    Multiplication::setThresholds(lowered);
+    mt19937_64 generator(8);
+    const MultiplicationAlgorithm algorithms[] = { MultiplicationAlgorithm::Karatsuba, MultiplicationAlgorithm::ToomCook3 };
+    const size_t lengths[] = { 5, 13, 40, 99, 101, 700 };
+    for (MultiplicationAlgorithm algorithm : algorithms) {
+        for (size_t aWords : lengths) {
+            for (size_t bWords : lengths) {
+                checkMultiplyWords(aWords, bWords, algorithm, generator);
+            }
+        }
+    }
+    Multiplication::setThresholds(thresholds);
+}
+
+LARGE_NUMBER_TEST(arithmetic, divide_each_algorithm) {
+    mt19937_64 generator(9);
+    const DivisionAlgorithm algorithms[] = { DivisionAlgorithm::Schoolbook, DivisionAlgorithm::BurnikelZiegler,
+        DivisionAlgorithm::NewtonReciprocal };
+    for (DivisionAlgorithm algorithm : algorithms) {
+        for (const DivisionShape& shape : DIVISION_SHAPES) {
+            string dividend = ReferenceArithmetic::randomDecimal(shape.dividendWords * 9, generator);
+            string divisor = ReferenceArithmetic::randomDecimal(shape.divisorWords * 9, generator);
+            checkDivideWords(dividend, divisor, algorithm);
+
+            // A divisor with a small top word, and a dividend one below a multiple of it
+            string smallTop = "1" + string(shape.divisorWords * 9 - 1, '0');
+            checkDivideWords(dividend, smallTop, algorithm);
+            string almost = ReferenceArithmetic::subtract(ReferenceArithmetic::multiply(divisor, divisor), "1");
+            checkDivideWords(almost, divisor, algorithm);
+        }
+    }
+}
+
+LARGE_NUMBER_TEST(arithmetic, divide_lowered_thresholds) {
+    DivisionThresholds thresholds = Division::getThresholds();
+    DivisionThresholds lowered;
+    lowered.burnikelZiegler = 4;
+    lowered.newtonReciprocal = 64;
+    Division::setThresholds(lowered);
+    mt19937_64 generator(10);
+    for (const DivisionShape& shape : DIVISION_SHAPES) {
+        string dividend = ReferenceArithmetic::randomDecimal(shape.dividendWords * 9, generator);
+        string divisor = ReferenceArithmetic::randomDecimal(shape.divisorWords * 9, generator);
+        checkDivideWords(dividend, divisor, Division::selectAlgorithm(shape.dividendWords, shape.divisorWords));
+    }
+    Division::setThresholds(thresholds);
+}
+
+LARGE_NUMBER_TEST(arithmetic, divide_operator_signs) {
+    mt19937_64 generator(11);
+    const size_t lengths[] = { 1, 19, 80, 2400 };
+    for (size_t aLength : lengths) {
+        for (size_t bLength : lengths) {
+            string a = ReferenceArithmetic::randomDecimal(aLength, generator, true);
+            string b = ReferenceArithmetic::randomDecimal(bLength, generator, true);
+            LargeNumber quotient;
+            LargeNumber remainder;
+            LargeNumber::divmod(LargeNumber(a), LargeNumber(b), quotient, remainder);
+            string q = ReferenceArithmetic::digitsOf(quotient);
+            string r = ReferenceArithmetic::digitsOf(remainder);
+
+            // Truncation toward zero: a == q * b + r, |r| < |b|, and r takes a's sign
+            CHECK_EQUAL(ReferenceArithmetic::add(ReferenceArithmetic::multiply(q, b), r), a);
+            CHECK(remainder.compareMagnitude(LargeNumber(b)) < 0);
+            CHECK(r == "0" || (r[0] == '-') == (a[0] == '-'));
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber(a) / LargeNumber(b)), q);
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber(a) % LargeNumber(b)), r);
+        }
+    }
+    CHECK_THROWS(LargeNumber("5") / LargeNumber("0"), domain_error);
+    CHECK_THROWS(LargeNumber("5") % LargeNumber("-0"), domain_error);
+}
+
+LARGE_NUMBER_TEST(arithmetic, parse_and_print) {
+    mt19937_64 generator(12);
+    for (size_t length : ADD_LENGTHS) {
+        string digits = ReferenceArithmetic::randomDecimal(length, generator, true);
+        LargeNumber number(digits);
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(number), digits);
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::fromWords(number.toWords(), number.isNegative())), digits);
+    }
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber("000000000000000000000000012")), string("12"));
+    CHECK_EQUAL(LargeNumber("1234567").toString(), string("1,234,567"));
+    CHECK_THROWS(LargeNumber("12a4"), invalid_argument);
+    CHECK_THROWS(LargeNumber("-"), invalid_argument);
+    CHECK_THROWS(LargeNumber(string(3000, '1') + "x"), invalid_argument);
+}
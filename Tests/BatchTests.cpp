@@ -0,0 +1,229 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file tests ProgramManager::runBatch: results of long
+    runs of set, add, sub, and mul against ReferenceArithmetic,
+    a script covering every operation with its exact output,
+    how lines are split (blank space, tabs, carriage returns,
+    blank and # lines), the per-line error report that names the
+    line and leaves the number unchanged, unknown operations
+    rejected before their operands are read, and the throughput
+    line and statistics dump of "--batch --stats".
+    It requires TestHarness.h, ReferenceArithmetic.h,
+    LargeNumberStats.h, ProgramManager.h, <algorithm>, <cstddef>,
+    <random>, <sstream>, <string>, and <vector> to run.
+-------------------------------------------------- */
+
+#include "TestHarness.h"
+#include "ReferenceArithmetic.h"
+#include "../LargeNumberStats.h"
+#include "../ProgramManager.h"
+#include <algorithm> // For dropping separators (remove())
+#include <cstddef>
+#include <random>
+#include <sstream> // For batch input and output (istringstream and ostringstream)
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+    // Run a batch, returning its output lines and error count, and its log if asked for
+    vector<string> runLines(const string& batch, size_t& errors, string* log = nullptr) {
+        ProgramManager programManager;
+        istringstream input(batch);
+        ostringstream output;
+        ostringstream report;
+        errors = programManager.runBatch(input, output, report);
+        if (log) {
+            *log = report.str();
+        }
+        vector<string> lines;
+        istringstream stream(output.str());
+        string line;
+        while (getline(stream, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    string withoutSeparators(string text) {
+        text.erase(remove(text.begin(), text.end(), ','), text.end());
+        return text;
+    }
+}
+
+LARGE_NUMBER_TEST(batch, results_against_reference) {
+    mt19937_64 generator(121);
+    string batch;
+    vector<string> expected;
+    string value = "0";
+    for (int i = 0; i < 600; i++) {
+        string operand = ReferenceArithmetic::randomDecimal(1 + generator() % 200, generator, true);
+        switch (i % 8 == 0 ? 0 : 1 + generator() % 3) {
+        case 0:
+            batch += "set " + operand + "\n";
+            value = operand;
+            break;
+        case 1:
+            batch += "add " + operand + "\n";
+            value = ReferenceArithmetic::add(value, operand);
+            break;
+        case 2:
+            batch += "sub " + operand + "\n";
+            value = ReferenceArithmetic::subtract(value, operand);
+            break;
+        default:
+            batch += "mul " + operand + "\n";
+            value = ReferenceArithmetic::multiply(value, operand);
+            break;
+        }
+        expected.push_back(value);
+    }
+
+    size_t errors;
+    vector<string> lines = runLines(batch, errors);
+    CHECK_EQUAL(errors, size_t(0));
+    CHECK_EQUAL(lines.size(), expected.size());
+    for (size_t i = 0; i < lines.size() && i < expected.size(); i++) {
+        if (withoutSeparators(lines[i]) != expected[i]) {
+            CHECK_EQUAL(withoutSeparators(lines[i]), expected[i]);
+            break;
+        }
+    }
+}
+
+LARGE_NUMBER_TEST(batch, every_operation) {
+    const char* script =
+        "set 17\n"
+        "div -5\n"
+        "set -17\n"
+        "mod 5\n"
+        "print\n"
+        "set 1234567\n"
+        "insert 0 5\n"
+        "delete 1\n"
+        "modify 2 999\n"
+        "pow 3\n"
+        "binomial 10 3\n"
+        "fibonacci 90\n"
+        "add 99999999999999999999999999999999999999999999999999999999999999999999999999999\n"
+        "sub -1\n"
+        "powmod 5 13\n"
+        "factorial 25\n";
+    const char* results[] = {
+        "17",
+        "-3 2",
+        "-17",
+        "-2",
+        "-2",
+        "1,234,567",
+        "5,001,234,567",
+        "1,234,567",
+        "1,999,567",
+        "7,994,805,124,852,817,263",
+        "120",
+        "2,880,067,194,370,816,120",
+        "100,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,002,880,067,194,370,816,119",
+        "100,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,002,880,067,194,370,816,120",
+        "12",
+        "15,511,210,043,330,985,984,000,000"
+    };
+    size_t errors;
+    vector<string> lines = runLines(script, errors);
+    CHECK_EQUAL(errors, size_t(0));
+    CHECK_EQUAL(lines.size(), sizeof(results) / sizeof(results[0]));
+    for (size_t i = 0; i < lines.size() && i < sizeof(results) / sizeof(results[0]); i++) {
+        CHECK_EQUAL(lines[i], string(results[i]));
+    }
+}
+
+LARGE_NUMBER_TEST(batch, line_splitting) {
+
+    // Tabs, runs of spaces, and Windows line endings separate tokens; blank and # lines are skipped
+    size_t errors;
+    vector<string> lines = runLines("\n# a comment\n  set\t 1000  \r\n\r\n   # indented comment\nadd    234\r\n\t\n", errors);
+    CHECK_EQUAL(errors, size_t(0));
+    CHECK_EQUAL(lines.size(), size_t(2));
+    CHECK(lines.size() == 2 && lines[0] == "1,000" && lines[1] == "1,234");
+}
+
+LARGE_NUMBER_TEST(batch, per_line_errors) {
+    const char* script =
+        "set 42\n"
+        "\n"
+        "bogus x\n"
+        "bogus 12\n"
+        "add\n"
+        "add 1 2\n"
+        "add 12x\n"
+        "insert 1 x\n"
+        "insert 99 1\n"
+        "modify 1 1000\n"
+        "factorial -1\n"
+        "binomial 5\n"
+        "div 0\n"
+        "mod 0\n"
+        "print\n";
+
+    // Messages that come from LargeNumber are only checked up to the line number
+    const char* results[] = {
+        "42",
+        "error line 3: Unknown operation \"bogus\"",
+        "error line 4: Unknown operation \"bogus\"",
+        "error line 5: Expected 1 operand(s) for \"add\"",
+        "error line 6: Expected 1 operand(s) for \"add\"",
+        "error line 7: ",
+        "error line 8: Invalid integer \"x\"",
+        "error line 9: ",
+        "error line 10: ",
+        "error line 11: Invalid count \"-1\"",
+        "error line 12: Expected 2 operand(s) for \"binomial\"",
+        "error line 13: Division by zero",
+        "error line 14: Division by zero",
+        "42"
+    };
+    const size_t count = sizeof(results) / sizeof(results[0]);
+    size_t errors;
+    string log;
+    vector<string> lines = runLines(script, errors, &log);
+    CHECK_EQUAL(errors, size_t(12));
+    CHECK_EQUAL(lines.size(), count);
+    for (size_t i = 0; i < lines.size() && i < count; i++) {
+        string prefix = results[i];
+        bool whole = prefix.back() != ' ';
+        CHECK_EQUAL(whole ? lines[i] : lines[i].substr(0, prefix.size()), prefix);
+    }
+    CHECK(log.find("Batch: 14 operations (12 failed) in ") == 0);
+}
+
+LARGE_NUMBER_TEST(batch, throughput_and_statistics) {
+    string batch;
+    for (int i = 0; i < 1000; i++) {
+        batch += "add 123456789123456789123456789\n";
+    }
+    size_t errors;
+    string log;
+    vector<string> lines = runLines(batch, errors, &log);
+    CHECK_EQUAL(errors, size_t(0));
+    CHECK_EQUAL(lines.size(), size_t(1000));
+    CHECK_EQUAL(lines.back(), string("123,456,789,123,456,789,123,456,789,000"));
+    CHECK(log.find("Batch: 1000 operations (0 failed) in ") == 0);
+    CHECK(log.find(" ops/s, ") != string::npos);
+    CHECK(log.find(" MB/s of input\n") != string::npos);
+
+    // What "--batch --stats" writes after the batch
+    ProgramManager programManager;
+    ostringstream statistics;
+    programManager.printStatistics(statistics);
+    CHECK(statistics.str().find("Nodes allocated: ") == 0);
+    if (LargeNumberStats::isEnabled()) {
+        CHECK(statistics.str().find("Node lookups: ") != string::npos);
+    }
+    else {
+        CHECK(statistics.str().find("Operation statistics are off") != string::npos);
+    }
+    CHECK(statistics.str().find("Result cache:") == string::npos);
+}
@@ -0,0 +1,176 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file tests ResultCache and NumberInterner: lookups and
+    least recently used eviction within the memory cap, sums and
+    differences through add() and subtract() while LargeNumber's
+    own operators leave an installed cache alone, batch products
+    answered by an installed cache exactly as without one, the
+    signed equality and hash the cache keys on, and an interner
+    behind the cache that gives back the values of evicted and
+    cleared entries, so it stays within the cache's bounds
+    however many results pass through.
+    It requires TestHarness.h, ReferenceArithmetic.h, LargeNumber.h,
+    NumberInterner.h, ProgramManager.h, ResultCache.h,
+    <functional>, <random>, <sstream>, and <string> to run.
+-------------------------------------------------- */
+
+#include "TestHarness.h"
+#include "ReferenceArithmetic.h"
+#include "../LargeNumber.h"
+#include "../NumberInterner.h"
+#include "../ProgramManager.h"
+#include "../ResultCache.h"
+#include <functional> // For the standard hash (hash)
+#include <random>
+#include <sstream> // For batch input and output (istringstream and ostringstream)
+#include <string>
+
+using namespace std;
+
+LARGE_NUMBER_TEST(cache, hits_misses_and_eviction) {
+    mt19937_64 generator(91);
+    LargeNumber a(ReferenceArithmetic::randomDecimal(3000, generator));
+    LargeNumber b(ReferenceArithmetic::randomDecimal(3000, generator, true));
+    ResultCache cache(1 << 16);
+    LargeNumber first = cache.add(a, b);
+    LargeNumber again = cache.add(a, b);
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(again), ReferenceArithmetic::digitsOf(a + b));
+    CHECK(first == again);
+    CHECK_EQUAL(cache.getHitCount(), size_t(1));
+    CHECK_EQUAL(cache.getMissCount(), size_t(1));
+
+    // Differences are kept apart from sums, and small values skip the cache
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(cache.subtract(a, b)), ReferenceArithmetic::digitsOf(a - b));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(cache.subtract(a, b)), ReferenceArithmetic::digitsOf(a - b));
+    CHECK_EQUAL(cache.getHitCount(), size_t(2));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(cache.add(LargeNumber("-12"), LargeNumber("5"))), string("-7"));
+    CHECK_EQUAL(cache.getMissCount(), size_t(2));
+
+    // LargeNumber's operators never consult an installed cache
+    ResultCache::install(&cache);
+    LargeNumber direct = a + b;
+    ResultCache::install(nullptr);
+    CHECK(direct == first);
+    CHECK_EQUAL(cache.getHitCount() + cache.getMissCount(), size_t(4));
+
+    // Operand order and the operation are part of the key
+    LargeNumber result;
+    CHECK(!cache.find(ResultCache::Operation::Add, b, a, ResultCache::hashKey(ResultCache::Operation::Add, b, a), result));
+    CHECK(!cache.find(ResultCache::Operation::Subtract, b, a, ResultCache::hashKey(ResultCache::Operation::Subtract, b, a), result));
+
+    // Many more results than fit leave the cache within its cap, the oldest gone first
+    for (int i = 0; i < 200; i++) {
+        cache.add(LargeNumber(ReferenceArithmetic::randomDecimal(3000, generator)), b);
+    }
+    CHECK(cache.getMemoryBytes() <= cache.getMaxBytes());
+    CHECK(cache.getEvictionCount() > 0);
+    CHECK(!cache.find(ResultCache::Operation::Add, a, b, ResultCache::hashKey(ResultCache::Operation::Add, a, b), result));
+    cache.clear();
+    CHECK_EQUAL(cache.getEntryCount(), size_t(0));
+    CHECK_EQUAL(cache.getMemoryBytes(), size_t(0));
+}
+
+LARGE_NUMBER_TEST(cache, batch_products_through_installed_cache) {
+    mt19937_64 generator(94);
+    string x = ReferenceArithmetic::randomDecimal(2000, generator);
+    string y = ReferenceArithmetic::randomDecimal(2000, generator, true);
+    string z = ReferenceArithmetic::randomDecimal(1500, generator);
+
+    // The same product three times, with sums (which skip the cache) and an inline product between
+    string batch;
+    for (int round = 0; round < 3; round++) {
+        batch += "set " + x + "\nmul " + y + "\nadd " + z + "\nsub " + z + "\nset 12\nmul -34\n";
+    }
+    batch += "set " + z + "\nmul " + x + "\n";
+    ProgramManager programManager;
+    istringstream plainInput(batch);
+    ostringstream plainOutput;
+    ostringstream log;
+    CHECK_EQUAL(programManager.runBatch(plainInput, plainOutput, log), size_t(0));
+
+    NumberInterner interner;
+    ResultCache cache(ResultCache::DEFAULT_MAX_BYTES, &interner);
+    ResultCache::install(&cache);
+    istringstream cachedInput(batch);
+    ostringstream cachedOutput;
+    CHECK_EQUAL(programManager.runBatch(cachedInput, cachedOutput, log), size_t(0));
+    ostringstream statistics;
+    programManager.printStatistics(statistics);
+    ResultCache::install(nullptr);
+
+    CHECK(cachedOutput.str() == plainOutput.str());
+    CHECK_EQUAL(cache.getMissCount(), size_t(2));
+    CHECK_EQUAL(cache.getHitCount(), size_t(2));
+    CHECK_EQUAL(cache.getEntryCount(), size_t(2));
+    CHECK(statistics.str().find("Result cache: 2 hits, 2 misses, 0 evictions, 2 entries") != string::npos);
+
+    // The cached product is the right one
+    LargeNumber product = cache.multiply(LargeNumber(x), LargeNumber(y));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(product), ReferenceArithmetic::multiply(x, y));
+    CHECK_EQUAL(cache.getHitCount(), size_t(3));
+}
+
+LARGE_NUMBER_TEST(cache, interner_gives_back_evicted_values) {
+    mt19937_64 generator(92);
+    NumberInterner interner;
+    ResultCache cache(1 << 16, &interner);
+
+    // One operand is kept by the caller throughout; the others and every result are not
+    LargeNumber kept(ReferenceArithmetic::randomDecimal(3000, generator));
+    for (int i = 0; i < 500; i++) {
+        LargeNumber operand(ReferenceArithmetic::randomDecimal(3000, generator, true));
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(cache.add(operand, kept)),
+            ReferenceArithmetic::digitsOf(operand + kept));
+        CHECK(interner.getMemoryBytes() <= cache.getMaxBytes());
+    }
+    CHECK(cache.getEvictionCount() > 0);
+    CHECK(interner.getSize() <= 2 * cache.getEntryCount() + 1);
+
+    // Clearing the cache gives back everything but the value the caller still holds
+    cache.clear();
+    CHECK_EQUAL(interner.getSize(), size_t(1));
+    kept = LargeNumber();
+    CHECK_EQUAL(interner.prune(), size_t(1));
+    CHECK_EQUAL(interner.getMemoryBytes(), size_t(0));
+
+    // Releasing the only copy outside the table drops the value
+    LargeNumber copy = interner.intern(LargeNumber(ReferenceArithmetic::randomDecimal(3000, generator)));
+    LargeNumber other = interner.intern(copy);
+    interner.release(copy);
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(copy), string("0"));
+    CHECK_EQUAL(interner.getSize(), size_t(1));
+    interner.release(other);
+    CHECK_EQUAL(interner.getSize(), size_t(0));
+}
+
+LARGE_NUMBER_TEST(cache, equality_and_hash) {
+    mt19937_64 generator(93);
+    string digits = ReferenceArithmetic::randomDecimal(3000, generator);
+    LargeNumber big(digits);
+
+    // A value worked out in blocks equals, and hashes like, the same value parsed inline
+    LargeNumber small("123456789012345678901234567890");
+    LargeNumber worked = (big + small) - big;
+    CHECK(worked == small);
+    CHECK_EQUAL(worked.getHash(), small.getHash());
+    CHECK(hash<LargeNumber>()(worked) == small.getHash());
+
+    // Leading zero groups left by node edits change neither
+    LargeNumber edited(digits);
+    edited.insertNode(0, 0);
+    CHECK(edited == big);
+    CHECK_EQUAL(edited.getHash(), big.getHash());
+
+    // Signs count, and copies sharing their blocks are equal
+    LargeNumber negated = LargeNumber("0") - big;
+    CHECK(negated != big);
+    CHECK(negated.getHash() != big.getHash());
+    CHECK(negated.compareMagnitude(big) == 0);
+    LargeNumber copy(big);
+    CHECK(copy == big);
+    int last = stoi(digits.substr(digits.size() - 3));
+    copy.modifyNode(copy.getSize() - 1, (last + 1) % 1000);
+    CHECK(copy != big);
+}
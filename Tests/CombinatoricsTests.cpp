@@ -0,0 +1,112 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file tests LargeNumber::factorial(), binomial(),
+    fibonacci(), and pow() against ReferenceArithmetic: running
+    products and sums, Pascal's rule and the row sums of binomial
+    coefficients, the Fibonacci doubling identity, powers of
+    signed bases by repeated multiplication, counts past 2^32,
+    and the length_error of results too long to hold.
+    It requires TestHarness.h, ReferenceArithmetic.h, LargeNumber.h,
+    <cstdint>, <random>, <stdexcept>, <string>, and <vector> to run.
+-------------------------------------------------- */
+
+#include "TestHarness.h"
+#include "ReferenceArithmetic.h"
+#include "../LargeNumber.h"
+#include <cstdint>
+#include <random>
+#include <stdexcept> // For results too long to hold (length_error)
+#include <string>
+#include <vector>
+
+using namespace std;
+
+LARGE_NUMBER_TEST(combinatorics, factorial_against_reference) {
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::factorial(0)), string("1"));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::factorial(20)), string("2432902008176640000"));
+
+    // Every n up to 300, then a few longer ones, against a running product
+    string expected = "1";
+    for (uint64_t n = 1; n <= 1500; n++) {
+        expected = ReferenceArithmetic::multiply(expected, to_string(n));
+        if (n <= 300 || n % 250 == 0) {
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::factorial(n)), expected);
+        }
+    }
+}
+
+LARGE_NUMBER_TEST(combinatorics, binomial_identities) {
+
+    // Pascal's triangle row by row, with each row summing to 2^n
+    vector<string> row(1, "1");
+    string power = "1";
+    for (uint64_t n = 1; n <= 120; n++) {
+        vector<string> next(n + 1, "1");
+        for (uint64_t k = 1; k < n; k++) {
+            next[k] = ReferenceArithmetic::add(row[k - 1], row[k]);
+        }
+        row.swap(next);
+        power = ReferenceArithmetic::add(power, power);
+        string total = "0";
+        for (uint64_t k = 0; k <= n; k++) {
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::binomial(n, k)), row[k]);
+            total = ReferenceArithmetic::add(total, row[k]);
+        }
+        CHECK_EQUAL(total, power);
+    }
+
+    // Symmetry, k past n, and n past 2^32, where C(n, 2) is n(n - 1)/2
+    CHECK(LargeNumber::binomial(5000, 1200) == LargeNumber::binomial(5000, 3800));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::binomial(7, 8)), string("0"));
+    uint64_t n = (1ULL << 40) + 7;
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::binomial(n, 2)),
+        ReferenceArithmetic::multiply(to_string(n), to_string((n - 1) / 2)));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::binomial(n, n - 1)), to_string(n));
+}
+
+LARGE_NUMBER_TEST(combinatorics, fibonacci_against_reference) {
+    string previous = "0";
+    string current = "1";
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::fibonacci(0)), previous);
+    for (uint64_t n = 1; n <= 2000; n++) {
+        if (n <= 200 || n % 100 == 0) {
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::fibonacci(n)), current);
+        }
+        string following = ReferenceArithmetic::add(previous, current);
+        previous = current;
+        current = following;
+    }
+
+    // F(2n) = F(n) (2 F(n + 1) - F(n)), far past the running sum
+    const uint64_t n = 30001;
+    string fn = ReferenceArithmetic::digitsOf(LargeNumber::fibonacci(n));
+    string fn1 = ReferenceArithmetic::digitsOf(LargeNumber::fibonacci(n + 1));
+    string twice = ReferenceArithmetic::multiply(fn, ReferenceArithmetic::subtract(ReferenceArithmetic::add(fn1, fn1), fn));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::fibonacci(2 * n)), twice);
+}
+
+LARGE_NUMBER_TEST(combinatorics, pow_against_reference) {
+    mt19937_64 generator(101);
+    const size_t lengths[] = { 1, 9, 19, 80, 700 };
+    for (size_t length : lengths) {
+        string base = ReferenceArithmetic::randomDecimal(length, generator, true);
+        string expected = "1";
+        for (uint64_t exponent = 0; exponent <= 24; exponent++) {
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::pow(LargeNumber(base), exponent)), expected);
+            expected = ReferenceArithmetic::multiply(expected, base);
+        }
+    }
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::pow(LargeNumber("0"), 0)), string("1"));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::pow(LargeNumber("0"), 5)), string("0"));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::pow(LargeNumber("-1"), (1ULL << 40) + 1)), string("-1"));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::pow(LargeNumber("10"), 5000)), "1" + string(5000, '0'));
+}
+
+LARGE_NUMBER_TEST(combinatorics, results_too_long) {
+    CHECK_THROWS(LargeNumber::factorial(1ULL << 40), length_error);
+    CHECK_THROWS(LargeNumber::binomial(1ULL << 62, 1ULL << 61), length_error);
+    CHECK_THROWS(LargeNumber::fibonacci(1ULL << 40), length_error);
+    CHECK_THROWS(LargeNumber::pow(LargeNumber("12345"), 1ULL << 40), length_error);
+}
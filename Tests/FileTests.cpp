@@ -0,0 +1,182 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file tests storing and loading LargeNumbers: plain digit
+    files written by saveToFile() and read back through the memory
+    mapping of loadFromFile(), including surrounding whitespace,
+    empty files, and missing ones, and binary records, one at a
+    time and several to a buffer, with every malformed header and
+    limb rejected. Files are created in the working directory and
+    removed afterwards.
+    It requires TestHarness.h, ReferenceArithmetic.h, LargeNumber.h,
+    <cstdint>, <cstdio>, <fstream>, <random>, <stdexcept>, <string>,
+    and <vector> to run.
+-------------------------------------------------- */
+
+#include "TestHarness.h"
+#include "ReferenceArithmetic.h"
+#include "../LargeNumber.h"
+#include <cstdint>
+#include <cstdio> // For removing test files (remove())
+#include <fstream>
+#include <random>
+#include <stdexcept> // For rejected files (runtime_error and invalid_argument)
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+    const char* const TEST_PATH = "LargeNumberTests.tmp";
+
+    // Digit counts from one digit to several blocks
+    const size_t FILE_LENGTHS[] = { 1, 18, 72, 73, 2304, 2305, 100000 };
+
+    // Replace the test file with the given bytes
+    void writeTestFile(const string& bytes) {
+        ofstream file(TEST_PATH, ios::binary | ios::trunc);
+        file.write(bytes.data(), static_cast<streamsize>(bytes.size()));
+    }
+
+    // Little-endian bytes of a value
+    string littleEndian(uint64_t value, size_t bytes) {
+        string text;
+        for (size_t i = 0; i < bytes; i++) {
+            text += static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+        return text;
+    }
+
+    // A binary record built byte by byte from the documented layout
+    string binaryRecord(bool negative, const vector<uint64_t>& limbs) {
+        string record = "LNUM" + littleEndian(LargeNumber::BINARY_FORMAT_VERSION, 2);
+        record += static_cast<char>(negative ? 1 : 0);
+        record += '\0';
+        record += littleEndian(limbs.size(), 8);
+        for (uint64_t limb : limbs) {
+            record += littleEndian(limb, 8);
+        }
+        return record;
+    }
+
+    // Decode a whole buffer as one record
+    LargeNumber decode(const string& record) {
+        size_t used;
+        return LargeNumber::fromBinary(record.data(), record.size(), used);
+    }
+
+    // The test file's bytes
+    string readTestFile() {
+        ifstream file(TEST_PATH, ios::binary);
+        return string((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    }
+}
+
+LARGE_NUMBER_TEST(files, digit_round_trip) {
+    mt19937_64 generator(31);
+    for (size_t length : FILE_LENGTHS) {
+        string digits = ReferenceArithmetic::randomDecimal(length, generator, true);
+        LargeNumber(digits).saveToFile(TEST_PATH);
+        CHECK_EQUAL(readTestFile(), digits + "\n");
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::loadFromFile(TEST_PATH)), digits);
+    }
+    LargeNumber().saveToFile(TEST_PATH);
+    CHECK_EQUAL(readTestFile(), string("0\n"));
+    remove(TEST_PATH);
+}
+
+LARGE_NUMBER_TEST(files, digit_files_as_written_by_hand) {
+    writeTestFile("  \n-000123456789012345678901234567890\r\n\n");
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::loadFromFile(TEST_PATH)), string("-123456789012345678901234567890"));
+    writeTestFile("");
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::loadFromFile(TEST_PATH)), string("0"));
+    writeTestFile("12 34\n");
+    CHECK_THROWS(LargeNumber::loadFromFile(TEST_PATH), invalid_argument);
+    remove(TEST_PATH);
+    CHECK_THROWS(LargeNumber::loadFromFile(TEST_PATH), runtime_error);
+}
+
+LARGE_NUMBER_TEST(files, binary_round_trip) {
+    mt19937_64 generator(32);
+    for (size_t length : FILE_LENGTHS) {
+        string digits = ReferenceArithmetic::randomDecimal(length, generator, true);
+        LargeNumber number(digits);
+        string record = number.toBinary();
+        CHECK_EQUAL(record.size(), LargeNumber::BINARY_HEADER_BYTES + 8 * ((length + 17) / 18));
+        size_t used = 0;
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::fromBinary(record.data(), record.size(), used)), digits);
+        CHECK_EQUAL(used, record.size());
+
+        number.saveBinary(TEST_PATH);
+        CHECK(readTestFile() == record);
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::loadBinary(TEST_PATH)), digits);
+    }
+    remove(TEST_PATH);
+
+    // The layout is fixed byte for byte, and zero has no limbs
+    CHECK(LargeNumber("-1000000000000000002").toBinary() == binaryRecord(true, { 2, 1 }));
+    CHECK(LargeNumber().toBinary() == binaryRecord(false, {}));
+}
+
+LARGE_NUMBER_TEST(files, binary_records_in_one_buffer) {
+    mt19937_64 generator(33);
+    vector<string> values;
+    string buffer;
+    for (size_t length : FILE_LENGTHS) {
+        values.push_back(ReferenceArithmetic::randomDecimal(length, generator, true));
+        buffer += LargeNumber(values.back()).toBinary();
+    }
+    size_t offset = 0;
+    for (const string& value : values) {
+        size_t used;
+        LargeNumber number = LargeNumber::fromBinary(buffer.data() + offset, buffer.size() - offset, used);
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(number), value);
+        offset += used;
+    }
+    CHECK_EQUAL(offset, buffer.size());
+
+    // High zero limbs are accepted and dropped
+    vector<uint64_t> padded(300, 0);
+    padded[0] = 7;
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(decode(binaryRecord(false, padded))), string("7"));
+    CHECK_EQUAL(decode(binaryRecord(false, padded)).getSize(), 1);
+}
+
+LARGE_NUMBER_TEST(files, malformed_binary_records) {
+    const uint64_t base = LargeNumber::LIMB_BASE;
+    string valid = binaryRecord(true, { 5, 6, 7, 8, 9, 10 });
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(decode(valid)).size(), size_t(1 + 5 * 18 + 2));
+
+    // Every truncation of a valid record is rejected
+    for (size_t length = 0; length < valid.size(); length++) {
+        CHECK_THROWS(decode(valid.substr(0, length)), invalid_argument);
+    }
+
+    string badMagic = valid;
+    badMagic[0] = 'X';
+    CHECK_THROWS(decode(badMagic), invalid_argument);
+    string badVersion = valid;
+    badVersion[4] = static_cast<char>(LargeNumber::BINARY_FORMAT_VERSION + 1);
+    CHECK_THROWS(decode(badVersion), invalid_argument);
+    string badFlags = valid;
+    badFlags[6] = 2;
+    CHECK_THROWS(decode(badFlags), invalid_argument);
+    string badReserved = valid;
+    badReserved[7] = 1;
+    CHECK_THROWS(decode(badReserved), invalid_argument);
+
+    // Limb counts too large for the buffer, including ones that overflow a byte count
+    string huge = valid;
+    huge.replace(8, 8, littleEndian(UINT64_MAX, 8));
+    CHECK_THROWS(decode(huge), invalid_argument);
+    huge.replace(8, 8, littleEndian(UINT64_MAX / 8 + 1, 8));
+    CHECK_THROWS(decode(huge), invalid_argument);
+
+    // Limbs outside base 10^18, inline and in blocks
+    CHECK_THROWS(decode(binaryRecord(false, { base })), invalid_argument);
+    vector<uint64_t> limbs(500, base - 1);
+    limbs[250] = UINT64_MAX;
+    CHECK_THROWS(decode(binaryRecord(false, limbs)), invalid_argument);
+}
@@ -0,0 +1,88 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file tests the FixedLargeNumber template against
+    ReferenceArithmetic at three widths: +, -, comparison, and
+    conversion to and from LargeNumber, the overflow_error of a
+    value or result wider than the template allows, and, through
+    static_assert, that the constexpr operations really run at
+    compile time.
+    It requires TestHarness.h, ReferenceArithmetic.h,
+    FixedLargeNumber.h, LargeNumber.h, <random>, <stdexcept>, and
+    <string> to run.
+-------------------------------------------------- */
+
+#include "TestHarness.h"
+#include "ReferenceArithmetic.h"
+#include "../FixedLargeNumber.h"
+#include "../LargeNumber.h"
+#include <random>
+#include <stdexcept> // For rejected values (overflow_error)
+#include <string>
+
+using namespace std;
+
+namespace {
+
+    // Compile-time arithmetic across a limb boundary
+    constexpr FixedLargeNumber<40> COMPILE_TIME_A("999999999999999999", 18);
+    constexpr FixedLargeNumber<40> COMPILE_TIME_B("1", 1);
+    constexpr FixedLargeNumber<40> COMPILE_TIME_SUM("1000000000000000000", 19);
+    constexpr FixedLargeNumber<40> COMPILE_TIME_NEGATIVE("-5", 2);
+    static_assert(COMPILE_TIME_A + COMPILE_TIME_B == COMPILE_TIME_SUM, "constexpr + across a limb");
+    static_assert(COMPILE_TIME_SUM - COMPILE_TIME_B == COMPILE_TIME_A, "constexpr - across a limb");
+    static_assert((COMPILE_TIME_B + COMPILE_TIME_NEGATIVE).isNegative(), "constexpr sign");
+    static_assert(COMPILE_TIME_NEGATIVE < COMPILE_TIME_B && COMPILE_TIME_A > COMPILE_TIME_B, "constexpr comparison");
+
+    // Check +, -, comparison, and conversions at one width against the reference
+    template <size_t Digits>
+    void checkWidth(mt19937_64& generator) {
+        for (int round = 0; round < 200; round++) {
+
+            // Operands one digit short of the width, so their sums always fit
+            string a = ReferenceArithmetic::randomDecimal(1 + generator() % (Digits - 1), generator, true);
+            string b = ReferenceArithmetic::randomDecimal(1 + generator() % (Digits - 1), generator, true);
+            FixedLargeNumber<Digits> x(a);
+            FixedLargeNumber<Digits> y(b);
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf((x + y).toLargeNumber()), ReferenceArithmetic::add(a, b));
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf((x - y).toLargeNumber()), ReferenceArithmetic::subtract(a, b));
+            CHECK_EQUAL((x + y).toString(), (LargeNumber(a) + LargeNumber(b)).toString());
+            int expected = ReferenceArithmetic::compare(a, b);
+            CHECK_EQUAL(x < y, expected < 0);
+            CHECK_EQUAL(x == y, expected == 0);
+            CHECK_EQUAL(x > y, expected > 0);
+
+            FixedLargeNumber<Digits> inPlace(x);
+            inPlace += y;
+            inPlace -= y;
+            CHECK(inPlace == x);
+            CHECK(FixedLargeNumber<Digits>(LargeNumber(a)) == x);
+        }
+
+        // The widest value fits; one more digit, or a sum that carries past the width, does not
+        string widest(Digits, '9');
+        FixedLargeNumber<Digits> largest(widest);
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(largest.toLargeNumber()), widest);
+        CHECK_THROWS(FixedLargeNumber<Digits>("1" + widest), overflow_error);
+        CHECK_THROWS(FixedLargeNumber<Digits>(LargeNumber("1" + widest)), overflow_error);
+        CHECK_THROWS(largest + FixedLargeNumber<Digits>("1"), overflow_error);
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf((largest - largest).toLargeNumber()), string("0"));
+        CHECK(!(largest - largest).isNegative());
+    }
+}
+
+LARGE_NUMBER_TEST(fixed, widths_against_reference) {
+    mt19937_64 generator(41);
+    checkWidth<10>(generator);
+    checkWidth<100>(generator);
+    checkWidth<1000>(generator);
+}
+
+LARGE_NUMBER_TEST(fixed, parse_and_print) {
+    CHECK_EQUAL(FixedLargeNumber<30>("-0001234567").toString(), string("-1,234,567"));
+    CHECK_EQUAL(FixedLargeNumber<30>("-0").toString(), string("0"));
+    CHECK(!FixedLargeNumber<30>("-0").isNegative());
+    CHECK_THROWS(FixedLargeNumber<30>("12x"), invalid_argument);
+    CHECK_THROWS(FixedLargeNumber<30>("-"), invalid_argument);
+}
@@ -0,0 +1,125 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file tests ModularContext and LargeNumber::powmod()
+    against ReferenceArithmetic: modular products with both
+    reductions, exponentiation compared with a plain
+    square-and-multiply over the reference operations, Fermat's
+    little theorem for a known prime, and the rejection of bad
+    moduli and exponents.
+    It requires TestHarness.h, ReferenceArithmetic.h, LargeNumber.h,
+    ModularContext.h, <random>, <stdexcept>, <string>, and <vector>
+    to run.
+-------------------------------------------------- */
+
+#include "TestHarness.h"
+#include "ReferenceArithmetic.h"
+#include "../LargeNumber.h"
+#include "../ModularContext.h"
+#include <random>
+#include <stdexcept> // For rejected arguments (domain_error and invalid_argument)
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+    // Modulus lengths in digits, on both sides of MONTGOMERY_MAX_WORDS (192 words)
+    const size_t MODULUS_LENGTHS[] = { 1, 9, 10, 40, 300, 1727, 1729 };
+
+    // value mod modulus in [0, modulus), through the library's division only for the remainder
+    string referenceReduce(const string& value, const string& modulus) {
+        LargeNumber remainder = LargeNumber(value) % LargeNumber(modulus);
+        string digits = ReferenceArithmetic::digitsOf(remainder);
+        return remainder.isNegative() ? ReferenceArithmetic::add(digits, modulus) : digits;
+    }
+
+    // base^exponent mod modulus by right-to-left square-and-multiply on a small exponent
+    string referencePow(const string& base, unsigned long long exponent, const string& modulus) {
+        string result = referenceReduce("1", modulus);
+        string square = referenceReduce(base, modulus);
+        for (; exponent > 0; exponent /= 2) {
+            if (exponent % 2 == 1) {
+                result = referenceReduce(ReferenceArithmetic::multiply(result, square), modulus);
+            }
+            square = referenceReduce(ReferenceArithmetic::multiply(square, square), modulus);
+        }
+        return result;
+    }
+
+    // An odd modulus not divisible by 5, so Montgomery applies
+    string coprimeModulus(size_t digits, mt19937_64& generator) {
+        string modulus = ReferenceArithmetic::randomDecimal(digits, generator);
+        char last = "1379"[generator() % 4];
+        modulus.back() = digits == 1 && last == '1' ? '3' : last;
+        return modulus;
+    }
+}
+
+LARGE_NUMBER_TEST(modular, multiply_both_reductions) {
+    mt19937_64 generator(61);
+    const ModularReduction reductions[] = { ModularReduction::Montgomery, ModularReduction::Barrett };
+    for (size_t length : MODULUS_LENGTHS) {
+        string modulus = coprimeModulus(length, generator);
+        for (ModularReduction reduction : reductions) {
+            ModularContext context((LargeNumber(modulus)), reduction);
+            CHECK(context.getReduction() == reduction);
+            for (int round = 0; round < 5; round++) {
+                string a = ReferenceArithmetic::randomDecimal(1 + generator() % (2 * length), generator, true);
+                string b = ReferenceArithmetic::randomDecimal(1 + generator() % length, generator, true);
+                string expected = referenceReduce(ReferenceArithmetic::multiply(a, b), modulus);
+                CHECK_EQUAL(ReferenceArithmetic::digitsOf(context.multiply(LargeNumber(a), LargeNumber(b))), expected);
+                CHECK_EQUAL(ReferenceArithmetic::digitsOf(context.reduce(LargeNumber(a))), referenceReduce(a, modulus));
+            }
+        }
+    }
+}
+
+LARGE_NUMBER_TEST(modular, pow_against_reference) {
+    mt19937_64 generator(62);
+    for (size_t length : MODULUS_LENGTHS) {
+        if (length > 300) {
+            continue;
+        }
+        string odd = coprimeModulus(length, generator);
+        string even = ReferenceArithmetic::randomDecimal(length + 1, generator);
+        even.back() = '0';
+        const string moduli[] = { odd, even };
+        for (const string& modulus : moduli) {
+            for (int round = 0; round < 3; round++) {
+                string base = ReferenceArithmetic::randomDecimal(1 + generator() % (length + 20), generator, true);
+                unsigned long long exponent = generator() % 5000;
+                string expected = referencePow(base, exponent, modulus);
+                LargeNumber result = LargeNumber::powmod(LargeNumber(base), LargeNumber(to_string(exponent)), LargeNumber(modulus));
+                CHECK_EQUAL(ReferenceArithmetic::digitsOf(result), expected);
+                CHECK_EQUAL(ReferenceArithmetic::digitsOf(ModularContext(LargeNumber(modulus)).pow(LargeNumber(base),
+                    LargeNumber(to_string(exponent)))), expected);
+            }
+        }
+    }
+}
+
+LARGE_NUMBER_TEST(modular, fermat_and_edge_cases) {
+
+    // 2^127 - 1 is prime, so a^(p-1) is 1 and a^p is a for every a it does not divide
+    LargeNumber prime("170141183460469231731687303715884105727");
+    LargeNumber exponent = prime - LargeNumber("1");
+    mt19937_64 generator(63);
+    for (int round = 0; round < 5; round++) {
+        LargeNumber base(ReferenceArithmetic::randomDecimal(30, generator));
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::powmod(base, exponent, prime)), string("1"));
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::powmod(base, prime, prime)), ReferenceArithmetic::digitsOf(base));
+    }
+
+    // Exponent zero, modulus one, and a negative base
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::powmod(LargeNumber("12345"), LargeNumber("0"), LargeNumber("7"))), string("1"));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::powmod(LargeNumber("12345"), LargeNumber("9"), LargeNumber("1"))), string("0"));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::powmod(LargeNumber("-2"), LargeNumber("3"), LargeNumber("7"))), string("6"));
+
+    CHECK_THROWS(ModularContext(LargeNumber("0")), domain_error);
+    CHECK_THROWS(ModularContext(LargeNumber("-7")), domain_error);
+    CHECK_THROWS(ModularContext(LargeNumber("10"), ModularReduction::Montgomery), invalid_argument);
+    CHECK_THROWS(LargeNumber::powmod(LargeNumber("2"), LargeNumber("-1"), LargeNumber("7")), invalid_argument);
+}
@@ -0,0 +1,214 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file tests the node manipulation methods against a plain
+    vector of 3-digit groups: random inserts, deletes, and
+    modifications on numbers from a single inline limb to many
+    blocks, batches of edits through applyNodeEdits() compared with
+    the same edits applied one group at a time, the rejection of
+    invalid positions, values, and conflicting edits, and
+    arithmetic on a number after its nodes were edited, and the
+    sign of a negative value edited down to zero.
+    It requires TestHarness.h, ReferenceArithmetic.h, LargeNumber.h,
+    <algorithm>, <random>, <stdexcept>, <string>, and <vector> to run.
+-------------------------------------------------- */
+
+#include "TestHarness.h"
+#include "ReferenceArithmetic.h"
+#include "../LargeNumber.h"
+#include <algorithm> // For ordering edits (stable_sort())
+#include <random>
+#include <stdexcept> // For rejected edits (out_of_range and invalid_argument)
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+    // Group counts: inside one limb, at the inline limit, and across several 768-group blocks
+    const int GROUP_COUNTS[] = { 1, 5, 24, 25, 768, 769, 4000 };
+
+    // Decimal digits of a group list, most significant group first
+    string digitsOfGroups(const vector<int>& groups) {
+        string digits;
+        for (int group : groups) {
+            string text = to_string(group);
+            digits += string(3 - text.size(), '0') + text;
+        }
+        size_t first = digits.find_first_not_of('0');
+        return first == string::npos ? "0" : digits.substr(first);
+    }
+
+    // Check a number against its reference groups
+    void checkGroups(const LargeNumber& number, const vector<int>& groups) {
+        CHECK_EQUAL(number.getSize(), static_cast<int>(groups.size()));
+        CHECK(number.getNodeValues() == groups);
+        string digits = ReferenceArithmetic::digitsOf(number);
+        CHECK_EQUAL(digits[0] == '-' ? digits.substr(1) : digits, digitsOfGroups(groups));
+    }
+
+    // Apply a batch of edits to reference groups, as applyNodeEdits() documents it
+    vector<int> applyEdits(const vector<int>& groups, vector<NodeEdit> edits) {
+        stable_sort(edits.begin(), edits.end(), [](const NodeEdit& a, const NodeEdit& b) {
+            if (a.position != b.position) {
+                return a.position < b.position;
+            }
+            return a.kind == NodeEditKind::Insert && b.kind != NodeEditKind::Insert;
+        });
+        vector<int> result;
+        size_t next = 0;
+        for (int position = 0; position <= static_cast<int>(groups.size()); position++) {
+            bool replaced = false;
+            for (; next < edits.size() && edits[next].position == position; next++) {
+                if (edits[next].kind != NodeEditKind::Delete) {
+                    result.push_back(edits[next].value);
+                }
+                if (edits[next].kind != NodeEditKind::Insert) {
+                    replaced = true;
+                }
+            }
+            if (position < static_cast<int>(groups.size()) && !replaced) {
+                result.push_back(groups[position]);
+            }
+        }
+        return result;
+    }
+}
+
+LARGE_NUMBER_TEST(node_edits, single_edits_random) {
+    mt19937_64 generator(21);
+    for (int count : GROUP_COUNTS) {
+        LargeNumber number(ReferenceArithmetic::randomDecimal(static_cast<size_t>(count) * 3, generator));
+        vector<int> groups = number.getNodeValues();
+        CHECK_EQUAL(static_cast<int>(groups.size()), count);
+        for (int step = 0; step < 300; step++) {
+            int value = static_cast<int>(generator() % 1000);
+            int size = static_cast<int>(groups.size());
+            switch (generator() % 3) {
+            case 0: {
+                int position = static_cast<int>(generator() % (size + 1));
+                number.insertNode(position, value);
+                groups.insert(groups.begin() + position, value);
+                break;
+            }
+            case 1:
+                if (size > 1) {
+                    int position = static_cast<int>(generator() % size);
+                    number.deleteNode(position);
+                    groups.erase(groups.begin() + position);
+                }
+                break;
+            default: {
+                int position = static_cast<int>(generator() % size);
+                number.modifyNode(position, value);
+                groups[position] = value;
+                break;
+            }
+            }
+        }
+        checkGroups(number, groups);
+    }
+}
+
+LARGE_NUMBER_TEST(node_edits, batch_matches_reference) {
+    mt19937_64 generator(22);
+    for (int count : GROUP_COUNTS) {
+        for (int round = 0; round < 5; round++) {
+            LargeNumber number(ReferenceArithmetic::randomDecimal(static_cast<size_t>(count) * 3, generator));
+            vector<int> groups = number.getNodeValues();
+
+            // Inserts may share any position; deletes and modifications take distinct ones
+            vector<NodeEdit> edits;
+            vector<bool> taken(groups.size(), false);
+            for (int i = 0; i < count / 4 + 3; i++) {
+                int value = static_cast<int>(generator() % 1000);
+                if (generator() % 2 == 0) {
+                    edits.push_back(NodeEdit{ NodeEditKind::Insert, static_cast<int>(generator() % (groups.size() + 1)), value });
+                    continue;
+                }
+                int position = static_cast<int>(generator() % groups.size());
+                if (taken[position] || groups.size() == 1) {
+                    continue;
+                }
+                taken[position] = true;
+                NodeEditKind kind = generator() % 2 == 0 ? NodeEditKind::Delete : NodeEditKind::Modify;
+                edits.push_back(NodeEdit{ kind, position, value });
+            }
+            number.applyNodeEdits(edits);
+            checkGroups(number, applyEdits(groups, edits));
+        }
+    }
+}
+
+LARGE_NUMBER_TEST(node_edits, invalid_edits_change_nothing) {
+    LargeNumber number("123456789");
+    CHECK_THROWS(number.insertNode(-1, 1), out_of_range);
+    CHECK_THROWS(number.insertNode(4, 1), out_of_range);
+    CHECK_THROWS(number.insertNode(0, 1000), out_of_range);
+    CHECK_THROWS(number.deleteNode(3), out_of_range);
+    CHECK_THROWS(number.modifyNode(0, -1), out_of_range);
+
+    vector<NodeEdit> outOfRange = { NodeEdit{ NodeEditKind::Modify, 0, 5 }, NodeEdit{ NodeEditKind::Delete, 3, 0 } };
+    CHECK_THROWS(number.applyNodeEdits(outOfRange), out_of_range);
+    vector<NodeEdit> conflicting = { NodeEdit{ NodeEditKind::Modify, 1, 5 }, NodeEdit{ NodeEditKind::Delete, 1, 0 } };
+    CHECK_THROWS(number.applyNodeEdits(conflicting), invalid_argument);
+    checkGroups(number, vector<int>{ 123, 456, 789 });
+}
+
+LARGE_NUMBER_TEST(node_edits, arithmetic_after_edits) {
+    mt19937_64 generator(23);
+    for (int count : GROUP_COUNTS) {
+        LargeNumber number(ReferenceArithmetic::randomDecimal(static_cast<size_t>(count) * 3, generator));
+        vector<int> groups = number.getNodeValues();
+        for (int step = 0; step < 20; step++) {
+            int position = static_cast<int>(generator() % (groups.size() + 1));
+            int value = static_cast<int>(generator() % 999) + 1;
+            number.insertNode(position, value);
+            groups.insert(groups.begin() + position, value);
+        }
+        string digits = digitsOfGroups(groups);
+        string other = ReferenceArithmetic::randomDecimal(static_cast<size_t>(count) * 3 + 40, generator);
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(number + LargeNumber(other)), ReferenceArithmetic::add(digits, other));
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(number - LargeNumber(other)), ReferenceArithmetic::subtract(digits, other));
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(number * LargeNumber(other)), ReferenceArithmetic::multiply(digits, other));
+    }
+}
+
+LARGE_NUMBER_TEST(node_edits, edits_to_zero_clear_the_sign) {
+    LargeNumber zero("0");
+
+    // Every way of editing a negative value down to zero leaves plain, positive zero
+    LargeNumber modified("-5");
+    modified.modifyNode(0, 0);
+    LargeNumber deleted("-5");
+    deleted.deleteNode(0);
+    LargeNumber batched("-5000000");
+    batched.applyNodeEdits({ NodeEdit{ NodeEditKind::Modify, 0, 0 }, NodeEdit{ NodeEditKind::Delete, 2, 0 } });
+    LargeNumber emptied("-123456");
+    emptied.applyNodeEdits({ NodeEdit{ NodeEditKind::Delete, 0, 0 }, NodeEdit{ NodeEditKind::Delete, 1, 0 } });
+    LargeNumber long_("-" + string(3000, '7'));
+    vector<NodeEdit> zeros;
+    for (int position = 0; position < long_.getSize(); position++) {
+        zeros.push_back(NodeEdit{ NodeEditKind::Modify, position, 0 });
+    }
+    long_.applyNodeEdits(zeros);
+    const LargeNumber* edited[] = { &modified, &deleted, &batched, &emptied, &long_ };
+    for (const LargeNumber* number : edited) {
+        CHECK(!number->isNegative());
+        CHECK(number->toString()[0] != '-');
+        CHECK(*number == zero);
+        CHECK_EQUAL(number->getHash(), zero.getHash());
+    }
+
+    // Inserting into a value emptied by deletes starts a positive value
+    deleted.insertNode(0, 7);
+    CHECK_EQUAL(deleted.toString(), string("7"));
+
+    // A value that only passes through zero groups keeps its sign
+    LargeNumber kept("-5005");
+    kept.modifyNode(1, 0);
+    CHECK_EQUAL(kept.toString(), string("-5,000"));
+    CHECK(kept.isNegative());
+}
@@ -0,0 +1,91 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file tests the NodePool counters: once a warm-up has
+    reserved the slabs, repeated sums, += and -=, and node edits
+    take every node from the free lists without another slab,
+    and resetStats() zeroes the view while leaving the reserved
+    slabs alone, including the nodes counted by threads that
+    have exited since.
+    It requires TestHarness.h, ReferenceArithmetic.h, LargeNumber.h,
+    NodePool.h, <cstddef>, <random>, <string>, and <thread> to run.
+-------------------------------------------------- */
+
+#include "TestHarness.h"
+#include "ReferenceArithmetic.h"
+#include "../LargeNumber.h"
+#include "../NodePool.h"
+#include <cstddef>
+#include <random>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+LARGE_NUMBER_TEST(node_pool, steady_state_takes_no_slabs) {
+    mt19937_64 generator(131);
+    LargeNumber a(ReferenceArithmetic::randomDecimal(20000, generator));
+    LargeNumber b(ReferenceArithmetic::randomDecimal(20000, generator));
+    LargeNumber total(a);
+
+    // One round of everything reserves what the loop below needs
+    for (int i = 0; i < 3; i++) {
+        LargeNumber sum = a + b;
+        total += a;
+        total -= a;
+        total.insertNode(1, 123);
+        total.deleteNode(1);
+    }
+    NodePool::resetStats();
+
+    for (int i = 0; i < 100; i++) {
+        LargeNumber sum = a + b;
+        total += a;
+        total -= a;
+        total.insertNode(1, 123);
+        total.deleteNode(1);
+    }
+    NodePoolStats stats = NodePool::getStats();
+    CHECK_EQUAL(stats.slabAllocations, size_t(0));
+    CHECK(stats.nodesAllocated >= 100 * static_cast<size_t>(a.getMemoryBytes() / sizeof(Node)));
+    CHECK_EQUAL(stats.nodesReleased, stats.nodesAllocated);
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(total), ReferenceArithmetic::digitsOf(a));
+}
+
+LARGE_NUMBER_TEST(node_pool, reset_zeroes_the_view) {
+    mt19937_64 generator(132);
+    string digits = ReferenceArithmetic::randomDecimal(50000, generator);
+
+    // Nodes counted by a thread that has exited are part of what a reset hides
+    thread worker([&digits]() {
+        LargeNumber number(digits);
+        LargeNumber doubled = number + number;
+    });
+    worker.join();
+    NodePoolStats before = NodePool::getStats();
+    CHECK(before.nodesAllocated > 0);
+    NodePool::resetStats();
+    NodePoolStats stats = NodePool::getStats();
+    CHECK_EQUAL(stats.nodesAllocated, size_t(0));
+    CHECK_EQUAL(stats.nodesReleased, size_t(0));
+    CHECK_EQUAL(stats.slabAllocations, size_t(0));
+    CHECK_EQUAL(stats.bytesReserved, before.bytesReserved);
+
+    // Counting starts again from zero, on this thread and on a new one
+    size_t nodes;
+    {
+        LargeNumber number(digits);
+        nodes = number.getMemoryBytes() / sizeof(Node);
+        stats = NodePool::getStats();
+        CHECK_EQUAL(stats.nodesAllocated, nodes);
+        CHECK_EQUAL(stats.nodesReleased, size_t(0));
+    }
+    thread other([&digits]() {
+        LargeNumber number(digits);
+    });
+    other.join();
+    stats = NodePool::getStats();
+    CHECK_EQUAL(stats.nodesAllocated, 2 * nodes);
+    CHECK_EQUAL(stats.nodesReleased, 2 * nodes);
+}
@@ -0,0 +1,175 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file tests BatchPipeline against ProgramManager::runBatch:
+    a mixed batch of arithmetic, division with its remainder,
+    modulo, node edits, generators, comments, and failing lines
+    must produce the same output line for line and the same
+    error count through the pipeline, whether its channels hold
+    one line (so every stage keeps waiting on its neighbours),
+    two, or the default number, and an empty batch must write
+    nothing.
+    It is built only when the compiler supports coroutines.
+    It requires TestHarness.h, ReferenceArithmetic.h,
+    BatchPipeline.h, ProgramManager.h, <cstddef>, <random>,
+    <sstream>, <string>, and <vector> to run.
+-------------------------------------------------- */
+
+#include "TestHarness.h"
+#include "ReferenceArithmetic.h"
+#include "../BatchPipeline.h"
+#include "../ProgramManager.h"
+#include <cstddef>
+#include <random>
+#include <sstream> // For batch input and output (istringstream and ostringstream)
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+    // A batch mixing every kind of line, about one in ten of them failing
+    string mixedBatch(size_t lines, mt19937_64& generator) {
+        static const char* const failures[] = {
+            "div 0", "mod 0", "add 12x", "bogus 5", "mul", "delete 999999", "modify 1 1000", "factorial -1"
+        };
+        string batch = "# mixed batch\nset 1\n\n";
+        for (size_t i = 0; i < lines; i++) {
+            string operand = ReferenceArithmetic::randomDecimal(1 + generator() % 120, generator, true);
+            switch (generator() % 12) {
+            case 0:
+                batch += "set " + operand + "\n";
+                break;
+            case 1:
+                batch += "add " + operand + "\n";
+                break;
+            case 2:
+                batch += "sub " + operand + "\n";
+                break;
+            case 3:
+                batch += "mul " + operand + "\n";
+                break;
+            case 4:
+                batch += "div " + operand.substr(0, 1 + operand.size() / 3) + "\n";
+                break;
+            case 5:
+                batch += "mod " + operand.substr(0, 1 + operand.size() / 4) + "\n";
+                break;
+            case 6:
+                batch += "insert 1 " + to_string(generator() % 1000) + "\n";
+                break;
+            case 7:
+                batch += "modify 1 " + to_string(generator() % 1000) + "\n";
+                break;
+            case 8:
+                batch += "delete 1\n";
+                break;
+            case 9:
+                batch += generator() % 2 == 0 ? "factorial " + to_string(generator() % 60) + "\n"
+                    : "fibonacci " + to_string(generator() % 300) + "\n";
+                break;
+            case 10:
+                batch += "print\n";
+                break;
+            default:
+                batch += failures[generator() % (sizeof(failures) / sizeof(failures[0]))];
+                batch += "\n";
+                break;
+            }
+
+            // Keep the number from growing without bound under repeated products
+            if (i % 16 == 15) {
+                batch += "set " + operand + "\n";
+            }
+        }
+        return batch;
+    }
+
+    vector<string> splitLines(const string& text) {
+        vector<string> lines;
+        istringstream stream(text);
+        string line;
+        while (getline(stream, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    // Check that two outputs match line for line, reporting the first difference only
+    void checkSameLines(const string& actual, const string& expected) {
+        vector<string> actualLines = splitLines(actual);
+        vector<string> expectedLines = splitLines(expected);
+        CHECK_EQUAL(actualLines.size(), expectedLines.size());
+        for (size_t i = 0; i < actualLines.size() && i < expectedLines.size(); i++) {
+            if (actualLines[i] != expectedLines[i]) {
+                CHECK_EQUAL(actualLines[i], expectedLines[i]);
+                break;
+            }
+        }
+    }
+}
+
+LARGE_NUMBER_TEST(pipeline, matches_plain_batch) {
+    mt19937_64 generator(111);
+    string batch = mixedBatch(3000, generator);
+
+    ProgramManager programManager;
+    istringstream plainInput(batch);
+    ostringstream plainOutput;
+    ostringstream plainLog;
+    size_t plainErrors = programManager.runBatch(plainInput, plainOutput, plainLog);
+    CHECK(plainErrors > 0);
+    CHECK(plainOutput.str().find("error line ") != string::npos);
+    CHECK(plainOutput.str().find("Division by zero") != string::npos);
+
+    // One line per channel makes every stage wait on its neighbours again and again
+    const size_t capacities[] = { 1, 2, BatchPipeline::DEFAULT_CAPACITY };
+    for (size_t capacity : capacities) {
+        istringstream input(batch);
+        ostringstream output;
+        ostringstream log;
+        CHECK_EQUAL(BatchPipeline::run(input, output, log, capacity), plainErrors);
+        checkSameLines(output.str(), plainOutput.str());
+        CHECK(log.str().compare(0, 16, "Pipelined batch:") == 0);
+    }
+}
+
+LARGE_NUMBER_TEST(pipeline, division_and_long_operands) {
+    mt19937_64 generator(112);
+
+    // div writes the quotient and remainder; operands of thousands of digits cross many blocks
+    string batch;
+    for (int i = 0; i < 40; i++) {
+        string dividend = ReferenceArithmetic::randomDecimal(4000 + generator() % 4000, generator, true);
+        string divisor = ReferenceArithmetic::randomDecimal(1 + generator() % 3000, generator, true);
+        batch += "set " + dividend + "\ndiv " + divisor + "\nset " + dividend + "\nmod " + divisor + "\n";
+        batch += "mul " + dividend + "\nsub " + divisor + "\n";
+    }
+    ProgramManager programManager;
+    istringstream plainInput(batch);
+    ostringstream plainOutput;
+    ostringstream log;
+    CHECK_EQUAL(programManager.runBatch(plainInput, plainOutput, log), size_t(0));
+    vector<string> lines = splitLines(plainOutput.str());
+    CHECK_EQUAL(lines.size(), size_t(240));
+    CHECK(lines.size() > 1 && lines[1].find(' ') != string::npos);
+
+    const size_t capacities[] = { 1, 3 };
+    for (size_t capacity : capacities) {
+        istringstream input(batch);
+        ostringstream output;
+        CHECK_EQUAL(BatchPipeline::run(input, output, log, capacity), size_t(0));
+        checkSameLines(output.str(), plainOutput.str());
+    }
+}
+
+LARGE_NUMBER_TEST(pipeline, empty_batch) {
+    istringstream input("\n# nothing to do\n   \n");
+    ostringstream output;
+    ostringstream log;
+    CHECK_EQUAL(BatchPipeline::run(input, output, log, 1), size_t(0));
+    CHECK_EQUAL(output.str(), string(""));
+    CHECK(log.str().find("0 operations (0 failed)") != string::npos);
+}
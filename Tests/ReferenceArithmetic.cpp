@@ -0,0 +1,217 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the ReferenceArithmetic class defined
+    in ReferenceArithmetic.h. Magnitudes are base 10^9 words;
+    signs are handled by comparing magnitudes and choosing
+    between adding and subtracting them, as on paper.
+    It requires ReferenceArithmetic.h, <algorithm>, <cstdint>,
+    <random>, <string>, and <vector> to run.
+-------------------------------------------------- */
+
+#include "ReferenceArithmetic.h"
+#include <algorithm> // For removing commas (remove())
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+    const uint64_t BASE = 1000000000;
+
+    typedef vector<uint32_t> Magnitude;
+
+    void trim(Magnitude& words) {
+        while (!words.empty() && words.back() == 0) {
+            words.pop_back();
+        }
+    }
+
+    int compareMagnitudes(const Magnitude& a, const Magnitude& b) {
+        if (a.size() != b.size()) {
+            return a.size() < b.size() ? -1 : 1;
+        }
+        for (size_t i = a.size(); i > 0; i--) {
+            if (a[i - 1] != b[i - 1]) {
+                return a[i - 1] < b[i - 1] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    Magnitude addMagnitudes(const Magnitude& a, const Magnitude& b) {
+        Magnitude sum(max(a.size(), b.size()) + 1, 0);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < sum.size(); i++) {
+            uint64_t total = carry + (i < a.size() ? a[i] : 0) + (i < b.size() ? b[i] : 0);
+            sum[i] = static_cast<uint32_t>(total % BASE);
+            carry = total / BASE;
+        }
+        trim(sum);
+        return sum;
+    }
+
+    // larger - smaller, where larger is at least smaller
+    Magnitude subtractMagnitudes(const Magnitude& larger, const Magnitude& smaller) {
+        Magnitude difference(larger.size(), 0);
+        int64_t borrow = 0;
+        for (size_t i = 0; i < larger.size(); i++) {
+            int64_t value = static_cast<int64_t>(larger[i]) - borrow - (i < smaller.size() ? smaller[i] : 0);
+            borrow = value < 0 ? 1 : 0;
+            difference[i] = static_cast<uint32_t>(value + borrow * static_cast<int64_t>(BASE));
+        }
+        trim(difference);
+        return difference;
+    }
+
+    Magnitude multiplyMagnitudes(const Magnitude& a, const Magnitude& b) {
+        if (a.empty() || b.empty()) {
+            return Magnitude();
+        }
+        Magnitude product(a.size() + b.size(), 0);
+        for (size_t i = 0; i < a.size(); i++) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < b.size(); j++) {
+                uint64_t total = static_cast<uint64_t>(a[i]) * b[j] + product[i + j] + carry;
+                product[i + j] = static_cast<uint32_t>(total % BASE);
+                carry = total / BASE;
+            }
+            for (size_t k = i + b.size(); carry > 0; k++) {
+                uint64_t total = product[k] + carry;
+                product[k] = static_cast<uint32_t>(total % BASE);
+                carry = total / BASE;
+            }
+        }
+        trim(product);
+        return product;
+    }
+
+    // Split a signed decimal into its sign and magnitude
+    Magnitude split(const string& value, bool& negative) {
+        negative = !value.empty() && value[0] == '-';
+        Magnitude words = ReferenceArithmetic::toWords(negative ? value.substr(1) : value);
+        if (words.empty()) {
+            negative = false;
+        }
+        return words;
+    }
+
+    string join(const Magnitude& words, bool negative) {
+        string digits = ReferenceArithmetic::fromWords(words);
+        return negative && digits != "0" ? "-" + digits : digits;
+    }
+
+    // a + b, or a - b when subtract is set
+    string combine(const string& a, const string& b, bool subtract) {
+        bool aNegative;
+        bool bNegative;
+        Magnitude aWords = split(a, aNegative);
+        Magnitude bWords = split(b, bNegative);
+        if (subtract) {
+            bNegative = !bNegative;
+        }
+        if (aNegative == bNegative) {
+            return join(addMagnitudes(aWords, bWords), aNegative);
+        }
+        if (compareMagnitudes(aWords, bWords) >= 0) {
+            return join(subtractMagnitudes(aWords, bWords), aNegative);
+        }
+        return join(subtractMagnitudes(bWords, aWords), bNegative);
+    }
+}
+
+// a + b
+string ReferenceArithmetic::add(const string& a, const string& b) {
+    return combine(a, b, false);
+}
+
+// a - b
+string ReferenceArithmetic::subtract(const string& a, const string& b) {
+    return combine(a, b, true);
+}
+
+// a * b
+string ReferenceArithmetic::multiply(const string& a, const string& b) {
+    bool aNegative;
+    bool bNegative;
+    Magnitude aWords = split(a, aNegative);
+    Magnitude bWords = split(b, bNegative);
+    return join(multiplyMagnitudes(aWords, bWords), aNegative != bNegative);
+}
+
+// Compare signed decimals
+int ReferenceArithmetic::compare(const string& a, const string& b) {
+    bool aNegative;
+    bool bNegative;
+    Magnitude aWords = split(a, aNegative);
+    Magnitude bWords = split(b, bNegative);
+    if (aNegative != bNegative) {
+        return aNegative ? -1 : 1;
+    }
+    int magnitude = compareMagnitudes(aWords, bWords);
+    return aNegative ? -magnitude : magnitude;
+}
+
+// Decimal magnitude to words, 9 digits per word from the least significant end
+vector<uint32_t> ReferenceArithmetic::toWords(const string& digits) {
+    Magnitude words;
+    for (size_t end = digits.size(); end > 0;) {
+        size_t start = end >= 9 ? end - 9 : 0;
+        words.push_back(static_cast<uint32_t>(stoul(digits.substr(start, end - start))));
+        end = start;
+    }
+    trim(words);
+    return words;
+}
+
+// Words to a decimal magnitude, with every word but the top one padded to 9 digits
+string ReferenceArithmetic::fromWords(const vector<uint32_t>& words) {
+    Magnitude trimmed(words);
+    trim(trimmed);
+    if (trimmed.empty()) {
+        return "0";
+    }
+    string digits = to_string(trimmed.back());
+    for (size_t i = trimmed.size() - 1; i > 0; i--) {
+        string word = to_string(trimmed[i - 1]);
+        digits += string(9 - word.size(), '0') + word;
+    }
+    return digits;
+}
+
+// Random decimal of exactly the given length
+string ReferenceArithmetic::randomDecimal(size_t digits, mt19937_64& generator, bool allowNegative) {
+    string value(digits, '0');
+    for (char& digit : value) {
+        digit = static_cast<char>('0' + generator() % 10);
+    }
+    if (!value.empty()) {
+        value[0] = static_cast<char>('1' + generator() % 9);
+    }
+    if (allowNegative && generator() % 2 == 1) {
+        value = "-" + value;
+    }
+    return value;
+}
+
+// Random decimal of the given length made mostly of 9s or 0s
+string ReferenceArithmetic::runDecimal(size_t digits, mt19937_64& generator) {
+    char fill = generator() % 2 == 0 ? '9' : '0';
+    string value(digits, fill);
+    for (size_t i = 0; i < digits / 50 + 1; i++) {
+        value[generator() % digits] = static_cast<char>('0' + generator() % 10);
+    }
+    value[0] = static_cast<char>('1' + generator() % 9);
+    return value;
+}
+
+// A LargeNumber's value as a plain signed decimal
+string ReferenceArithmetic::digitsOf(const LargeNumber& number) {
+    string text = number.toString();
+    text.erase(remove(text.begin(), text.end(), ','), text.end());
+    return text;
+}
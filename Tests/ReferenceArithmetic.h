@@ -0,0 +1,54 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the ReferenceArithmetic class, a
+    deliberately plain implementation of signed decimal +, -,
+    and * that the tests compare the library against. It shares
+    no code with the library: values are decimal strings with an
+    optional leading minus sign, converted to base 10^9 words and
+    multiplied by schoolbook only, so it is slow but easy to
+    trust. It also builds random operands and strips the commas
+    LargeNumber prints.
+    This file requires LargeNumber.h, <cstdint>, <random>, <string>,
+    and <vector>.
+-------------------------------------------------- */
+
+#ifndef REFERENCE_ARITHMETIC_H
+#define REFERENCE_ARITHMETIC_H
+
+#include "../LargeNumber.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+class ReferenceArithmetic {
+public:
+
+    // Signed decimal arithmetic ("-0" is never produced)
+    static std::string add(const std::string& a, const std::string& b);
+    static std::string subtract(const std::string& a, const std::string& b);
+    static std::string multiply(const std::string& a, const std::string& b);
+
+    // Compare signed decimals: negative, zero, or positive
+    static int compare(const std::string& a, const std::string& b);
+
+    // Conversion between decimal magnitudes and base 10^9 words, least significant first
+    static std::vector<uint32_t> toWords(const std::string& digits);
+    static std::string fromWords(const std::vector<uint32_t>& words);
+
+    // Random decimal of exactly the given length (no leading zero), negative half the time if allowed
+    static std::string randomDecimal(size_t digits, std::mt19937_64& generator, bool allowNegative = false);
+
+    // Random decimal of the given length made mostly of 9s or 0s, to force long carry and borrow runs
+    static std::string runDecimal(size_t digits, std::mt19937_64& generator);
+
+    // A LargeNumber's value as a plain signed decimal
+    static std::string digitsOf(const LargeNumber& number);
+
+private:
+    ReferenceArithmetic() = delete;
+};
+
+#endif // REFERENCE_ARITHMETIC_H
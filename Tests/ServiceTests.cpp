@@ -0,0 +1,140 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file tests CalculatorService through real connections to
+    a socket in the working directory: replies to arithmetic
+    requests, the refusal of file operations, the mode of the
+    socket file, and clients that pipeline without reading their
+    replies, which must not keep the workers from other clients.
+    It is built on Unix-like systems only.
+    It requires TestHarness.h, ReferenceArithmetic.h,
+    CalculatorService.h, LargeNumber.h, <cstdio>, <random>,
+    <string>, <sys/socket.h>, <sys/stat.h>, <sys/time.h>, and
+    <unistd.h> to run.
+-------------------------------------------------- */
+
+#include "TestHarness.h"
+#include "ReferenceArithmetic.h"
+#include "../CalculatorService.h"
+#include "../LargeNumber.h"
+#include <cstdio> // For removing test files (remove())
+#include <random>
+#include <string>
+#include <sys/socket.h> // For reading replies (recv() and setsockopt())
+#include <sys/stat.h> // For the socket file's mode (stat())
+#include <sys/time.h> // For the reply timeout (timeval)
+#include <unistd.h> // For closing connections (close())
+
+using namespace std;
+
+namespace {
+
+    const char* const SOCKET_PATH = "LargeNumberTests.sock";
+    const char* const SAVED_PATH = "LargeNumberTests.saved";
+
+    // Read one whole reply frame from a blocking socket; returns false if the service hung up
+    bool readReply(int socket, string& inbox, string& reply) {
+        size_t offset = 0;
+        while (!CalculatorService::takeFrame(inbox, offset, reply)) {
+            char chunk[4096];
+            ssize_t received = recv(socket, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                return false;
+            }
+            inbox.append(chunk, static_cast<size_t>(received));
+        }
+        inbox.erase(0, offset);
+        return true;
+    }
+
+    // Send one request and wait for its reply
+    string request(int socket, string& inbox, const string& line) {
+        string frame;
+        CalculatorService::appendFrame(frame, line.data(), line.size());
+        CalculatorService::sendAll(socket, frame.data(), frame.size());
+        string reply;
+        return readReply(socket, inbox, reply) ? reply : string("(hung up)");
+    }
+
+    // Queue requests without reading any replies
+    void sendRequests(int socket, const string& line, size_t count) {
+        string frames;
+        for (size_t i = 0; i < count; i++) {
+            CalculatorService::appendFrame(frames, line.data(), line.size());
+        }
+        CalculatorService::sendAll(socket, frames.data(), frames.size());
+    }
+
+    // A successful reply
+    string ok(const string& result) {
+        return string(1, CalculatorService::REPLY_OK) + result;
+    }
+}
+
+LARGE_NUMBER_TEST(service, arithmetic_and_refused_files) {
+    CalculatorService service(SOCKET_PATH, 2);
+    service.start();
+
+    // Only the owner may read or write the socket
+    struct stat status;
+    CHECK(stat(SOCKET_PATH, &status) == 0);
+    CHECK_EQUAL(status.st_mode & 0777, static_cast<mode_t>(0600));
+
+    int socket = CalculatorService::connectTo(SOCKET_PATH);
+    string inbox;
+    CHECK_EQUAL(request(socket, inbox, "add 123456789012345678901234567890"), ok("123,456,789,012,345,678,901,234,567,890"));
+    CHECK_EQUAL(request(socket, inbox, "mul -2"), ok("-246,913,578,024,691,357,802,469,135,780"));
+
+    // File operations are refused without touching the number or the file system
+    const char* const refused[] = { "save ", "savebin ", "load ", "loadbin " };
+    for (const char* operation : refused) {
+        string reply = request(socket, inbox, operation + string(SAVED_PATH));
+        CHECK(!reply.empty() && reply[0] == CalculatorService::REPLY_ERROR);
+        CHECK(access(SAVED_PATH, F_OK) != 0);
+    }
+    CHECK_EQUAL(request(socket, inbox, "print"), ok("-246,913,578,024,691,357,802,469,135,780"));
+    close(socket);
+
+    service.stop();
+    CHECK(access(SOCKET_PATH, F_OK) != 0);
+    remove(SAVED_PATH);
+}
+
+LARGE_NUMBER_TEST(service, clients_that_stop_reading) {
+    CalculatorService service(SOCKET_PATH, 2);
+    service.start();
+
+    // As many clients as workers each ask for far more replies than a socket holds, and read none
+    mt19937_64 generator(81);
+    string digits = ReferenceArithmetic::randomDecimal(100000, generator);
+    string printed = LargeNumber(digits).toString();
+    const size_t prints = 200;
+    int slow[2];
+    for (int& socket : slow) {
+        socket = CalculatorService::connectTo(SOCKET_PATH);
+        sendRequests(socket, "add " + digits, 1);
+        sendRequests(socket, "print", prints);
+    }
+
+    // Another client is still answered, and gives up rather than hang if it is not
+    int socket = CalculatorService::connectTo(SOCKET_PATH);
+    timeval timeout = { 20, 0 };
+    setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    string inbox;
+    CHECK_EQUAL(request(socket, inbox, "add 42"), ok("42"));
+    close(socket);
+
+    // The slow clients still get every reply, in order, once they read
+    for (int socket : slow) {
+        string slowInbox;
+        string reply;
+        size_t correct = 0;
+        for (size_t i = 0; i <= prints && readReply(socket, slowInbox, reply); i++) {
+            correct += reply == ok(printed) ? 1 : 0;
+        }
+        CHECK_EQUAL(correct, prints + 1);
+        close(socket);
+    }
+    service.stop();
+}
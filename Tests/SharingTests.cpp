@@ -0,0 +1,138 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file tests that copies sharing blocks stay independent:
+    every way of changing a number in place (node edits, batches
+    of edits, +=, -=, *=, /=, %=, and assignment) must leave its
+    copies as they were, whichever side of the copy changes, and
+    copies changed on several threads at once must not disturb
+    each other or the original.
+    It requires TestHarness.h, ReferenceArithmetic.h, LargeNumber.h,
+    <functional>, <random>, <string>, <thread>, <utility>, and
+    <vector> to run.
+-------------------------------------------------- */
+
+#include "TestHarness.h"
+#include "ReferenceArithmetic.h"
+#include "../LargeNumber.h"
+#include <functional> // For the list of edits (function)
+#include <random>
+#include <string>
+#include <thread>
+#include <utility> // For moving numbers (move())
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+    // One way of changing a number in place
+    struct InPlaceEdit {
+        const char* name;
+        function<void(LargeNumber&)> apply;
+    };
+
+    vector<InPlaceEdit> inPlaceEdits() {
+        LargeNumber operand("-987654321987654321987654321");
+        return {
+            { "insertNode", [](LargeNumber& number) { number.insertNode(number.getSize() / 2, 123); } },
+            { "deleteNode", [](LargeNumber& number) { number.deleteNode(number.getSize() - 1); } },
+            { "modifyNode", [](LargeNumber& number) { number.modifyNode(0, 999); } },
+            { "applyNodeEdits", [](LargeNumber& number) {
+                number.applyNodeEdits({ NodeEdit{ NodeEditKind::Modify, 1, 1 }, NodeEdit{ NodeEditKind::Insert, 0, 5 } }); } },
+            { "+=", [operand](LargeNumber& number) { number += operand; } },
+            { "-=", [operand](LargeNumber& number) { number -= operand; } },
+            { "*=", [operand](LargeNumber& number) { number *= operand; } },
+            { "/=", [operand](LargeNumber& number) { number /= operand; } },
+            { "%=", [operand](LargeNumber& number) { number %= operand; } },
+            { "self +=", [](LargeNumber& number) { number += number; } },
+            { "assignment", [operand](LargeNumber& number) { number = operand; } }
+        };
+    }
+
+    // Digit counts for an inline value, one block, and several blocks
+    const size_t SHARING_LENGTHS[] = { 40, 2000, 20000 };
+}
+
+LARGE_NUMBER_TEST(sharing, edits_leave_copies_alone) {
+    mt19937_64 generator(71);
+    for (size_t length : SHARING_LENGTHS) {
+        string digits = ReferenceArithmetic::randomDecimal(length, generator, true);
+        for (const InPlaceEdit& edit : inPlaceEdits()) {
+
+            // The expected result of the edit, on a number that shares nothing
+            LargeNumber alone(digits);
+            edit.apply(alone);
+            string edited = ReferenceArithmetic::digitsOf(alone);
+
+            // Change the copy: the original keeps its value
+            LargeNumber original(digits);
+            LargeNumber copy(original);
+            LargeNumber assigned;
+            assigned = original;
+            edit.apply(copy);
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(copy), edited);
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(original), digits);
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(assigned), digits);
+
+            // Change the original: both copies keep its old value
+            edit.apply(original);
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(original), edited);
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(assigned), digits);
+            CHECK(edited != digits);
+        }
+    }
+}
+
+LARGE_NUMBER_TEST(sharing, moved_and_reassigned_copies) {
+    mt19937_64 generator(72);
+    string digits = ReferenceArithmetic::randomDecimal(10000, generator);
+    LargeNumber original(digits);
+    LargeNumber copy(original);
+    LargeNumber moved(move(copy));
+    moved.modifyNode(0, 1);
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(original), digits);
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(moved), "1" + digits.substr(1));
+
+    // A chain of copies, each changed once, keeps every earlier value
+    vector<LargeNumber> chain(1, original);
+    vector<string> expected(1, digits);
+    for (int i = 0; i < 10; i++) {
+        chain.push_back(chain.back());
+        chain.back().insertNode(chain.back().getSize(), 100 + i);
+        expected.push_back(expected.back() + to_string(100 + i));
+    }
+    for (size_t i = 0; i < chain.size(); i++) {
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(chain[i]), expected[i]);
+    }
+}
+
+LARGE_NUMBER_TEST(sharing, copies_changed_on_threads) {
+    mt19937_64 generator(73);
+    string digits = ReferenceArithmetic::randomDecimal(50000, generator);
+    LargeNumber original(digits);
+    const int threadCount = 8;
+    vector<string> results(threadCount);
+    vector<thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&original, &results, t]() {
+            for (int round = 0; round < 20; round++) {
+                LargeNumber copy(original);
+                copy.modifyNode(t, t);
+                LargeNumber again(copy);
+                again += original;
+                results[t] = ReferenceArithmetic::digitsOf(copy);
+            }
+        });
+    }
+    for (thread& worker : threads) {
+        worker.join();
+    }
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(original), digits);
+    for (int t = 0; t < threadCount; t++) {
+        LargeNumber expected(digits);
+        expected.modifyNode(t, t);
+        CHECK_EQUAL(results[t], ReferenceArithmetic::digitsOf(expected));
+    }
+}
@@ -0,0 +1,109 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file tests LargeNumberStats: what record() and add()
+    leave in getStats() from this thread and from threads that
+    have exited, the histogram and slowest call, a resetStats()
+    that zeroes the view and restarts the slowest call, and
+    resets made while another thread keeps recording, which must
+    never bring back counts from before them.
+    It requires TestHarness.h, LargeNumberStats.h, <atomic>,
+    <cstdint>, and <thread> to run.
+-------------------------------------------------- */
+
+#include "TestHarness.h"
+#include "../LargeNumberStats.h"
+#include <atomic> // For the recording thread's progress (atomic)
+#include <cstdint>
+#include <thread>
+
+using namespace std;
+
+LARGE_NUMBER_TEST(stats, record_and_reset) {
+    LargeNumberStats::resetStats();
+    LargeNumberStatsSnapshot stats = LargeNumberStats::getStats();
+    CHECK_EQUAL(stats.operation(LargeNumberOperation::Add).calls, uint64_t(0));
+    CHECK_EQUAL(stats.counter(LargeNumberCounter::Lookups), uint64_t(0));
+
+    // Three fast calls and one slow one, each in its power-of-two bucket
+    for (int i = 0; i < 3; i++) {
+        LargeNumberStats::record(LargeNumberOperation::Add, 10, 100);
+    }
+    LargeNumberStats::record(LargeNumberOperation::Add, 4, 5000);
+    LargeNumberStats::add(LargeNumberCounter::Lookups, 7);
+    stats = LargeNumberStats::getStats();
+    const OperationStats& add = stats.operation(LargeNumberOperation::Add);
+    CHECK_EQUAL(add.calls, uint64_t(4));
+    CHECK_EQUAL(add.limbs, uint64_t(34));
+    CHECK_EQUAL(add.totalNanoseconds, uint64_t(5300));
+    CHECK_EQUAL(add.maxNanoseconds, uint64_t(5000));
+    CHECK_EQUAL(add.buckets[6], uint64_t(3));
+    CHECK_EQUAL(add.buckets[12], uint64_t(1));
+    CHECK_EQUAL(add.percentileNanoseconds(0.5), uint64_t(128));
+    CHECK_EQUAL(add.percentileNanoseconds(0.99), uint64_t(5000));
+    CHECK_EQUAL(stats.operation(LargeNumberOperation::Subtract).calls, uint64_t(0));
+    CHECK_EQUAL(stats.counter(LargeNumberCounter::Lookups), uint64_t(7));
+
+    // Counts of a thread that has exited are kept
+    thread worker([]() {
+        for (int i = 0; i < 5; i++) {
+            LargeNumberStats::record(LargeNumberOperation::Add, 1, 20000);
+        }
+    });
+    worker.join();
+    stats = LargeNumberStats::getStats();
+    CHECK_EQUAL(stats.operation(LargeNumberOperation::Add).calls, uint64_t(9));
+    CHECK_EQUAL(stats.operation(LargeNumberOperation::Add).maxNanoseconds, uint64_t(20000));
+
+    // A reset zeroes everything, and the slowest call starts over
+    LargeNumberStats::resetStats();
+    stats = LargeNumberStats::getStats();
+    CHECK_EQUAL(stats.operation(LargeNumberOperation::Add).calls, uint64_t(0));
+    CHECK_EQUAL(stats.operation(LargeNumberOperation::Add).limbs, uint64_t(0));
+    CHECK_EQUAL(stats.operation(LargeNumberOperation::Add).maxNanoseconds, uint64_t(0));
+    CHECK_EQUAL(stats.operation(LargeNumberOperation::Add).buckets[6], uint64_t(0));
+    CHECK_EQUAL(stats.counter(LargeNumberCounter::Lookups), uint64_t(0));
+    LargeNumberStats::record(LargeNumberOperation::Add, 2, 300);
+    stats = LargeNumberStats::getStats();
+    CHECK_EQUAL(stats.operation(LargeNumberOperation::Add).calls, uint64_t(1));
+    CHECK_EQUAL(stats.operation(LargeNumberOperation::Add).limbs, uint64_t(2));
+    CHECK_EQUAL(stats.operation(LargeNumberOperation::Add).maxNanoseconds, uint64_t(300));
+}
+
+LARGE_NUMBER_TEST(stats, reset_while_recording) {
+    LargeNumberStats::resetStats();
+    atomic<uint64_t> recorded(0);
+    atomic<bool> stop(false);
+    thread worker([&recorded, &stop]() {
+        while (!stop.load()) {
+            LargeNumberStats::record(LargeNumberOperation::Print, 1, 50);
+            recorded.fetch_add(1);
+        }
+    });
+
+    while (recorded.load() == 0) {
+        this_thread::yield();
+    }
+
+    // A reset can only keep calls that finish after it starts
+    bool keptOldCalls = false;
+    for (int round = 0; round < 2000 && !keptOldCalls; round++) {
+        uint64_t before = recorded.load();
+        LargeNumberStats::resetStats();
+        uint64_t calls = LargeNumberStats::getStats().operation(LargeNumberOperation::Print).calls;
+        uint64_t after = recorded.load();
+        keptOldCalls = calls > after - before + 1;
+        this_thread::yield();
+    }
+    stop.store(true);
+    worker.join();
+    CHECK(!keptOldCalls);
+
+    // Once recording stops, the counts since the last reset add up exactly
+    LargeNumberStats::resetStats();
+    for (int i = 0; i < 10; i++) {
+        LargeNumberStats::record(LargeNumberOperation::Print, 1, 50);
+    }
+    CHECK_EQUAL(LargeNumberStats::getStats().operation(LargeNumberOperation::Print).calls, uint64_t(10));
+}
@@ -0,0 +1,212 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file tests the ways of adding many numbers at once
+    against ReferenceArithmetic: LargeNumber::sum() over mixed
+    signs and lengths, ExpressionGraph evaluation of random
+    expressions of +, -, and *, with shared subexpressions, stored
+    results, and invalidation after a variable changes, and
+    LargeNumberAccumulator with its pending carries and borrows,
+    merging, and the threaded range sum.
+    It requires TestHarness.h, ReferenceArithmetic.h,
+    ExpressionGraph.h, LargeNumber.h, LargeNumberAccumulator.h,
+    ThreadPool.h, <random>, <string>, and <vector> to run.
+-------------------------------------------------- */
+
+#include "TestHarness.h"
+#include "ReferenceArithmetic.h"
+#include "../ExpressionGraph.h"
+#include "../LargeNumber.h"
+#include "../LargeNumberAccumulator.h"
+#include "../ThreadPool.h"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+    // Operand lengths mixing inline values, single blocks, and several blocks
+    const size_t SUM_LENGTHS[] = { 1, 18, 40, 73, 500, 2305, 6000 };
+
+    // Random operands with their reference digits
+    void makeOperands(size_t count, mt19937_64& generator, vector<LargeNumber>& numbers, vector<string>& digits) {
+        numbers.clear();
+        digits.clear();
+        for (size_t i = 0; i < count; i++) {
+            size_t length = SUM_LENGTHS[generator() % (sizeof(SUM_LENGTHS) / sizeof(SUM_LENGTHS[0]))];
+            digits.push_back(generator() % 8 == 0 ? ReferenceArithmetic::runDecimal(length, generator)
+                : ReferenceArithmetic::randomDecimal(length, generator, true));
+            numbers.push_back(LargeNumber(digits.back()));
+        }
+    }
+}
+
+LARGE_NUMBER_TEST(sums, sum_against_reference) {
+    mt19937_64 generator(51);
+    vector<LargeNumber> numbers;
+    vector<string> digits;
+    const size_t counts[] = { 0, 1, 2, 3, 10, 100 };
+    for (size_t count : counts) {
+        makeOperands(count, generator, numbers, digits);
+        vector<SumTerm> terms;
+        string expected = "0";
+        for (size_t i = 0; i < count; i++) {
+            bool subtract = generator() % 2 == 0;
+            terms.push_back(SumTerm{ &numbers[i], subtract });
+            expected = subtract ? ReferenceArithmetic::subtract(expected, digits[i]) : ReferenceArithmetic::add(expected, digits[i]);
+        }
+        LargeNumber total = LargeNumber::sum(terms);
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(total), expected);
+        CHECK(expected != "0" || !total.isNegative());
+    }
+
+    // Terms that cancel exactly
+    LargeNumber a("-" + string(3000, '7'));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumber::sum({ SumTerm{ &a, false }, SumTerm{ &a, true } })), string("0"));
+}
+
+LARGE_NUMBER_TEST(sums, expression_graph_against_reference) {
+    mt19937_64 generator(52);
+    for (int round = 0; round < 20; round++) {
+        vector<LargeNumber> numbers;
+        vector<string> digits;
+        makeOperands(6, generator, numbers, digits);
+
+        // Build random expressions bottom up, keeping each one's reference value
+        ExpressionGraph graph;
+        vector<Expression> expressions;
+        vector<string> values;
+        for (size_t i = 0; i < numbers.size(); i++) {
+            expressions.push_back(graph.variable(numbers[i]));
+            values.push_back(digits[i]);
+        }
+        for (int step = 0; step < 30; step++) {
+            size_t left = generator() % expressions.size();
+            size_t right = generator() % expressions.size();
+            int operation = static_cast<int>(generator() % 5);
+
+            // Products are rare and only of short operands, so values stay a reasonable length
+            if (operation == 4 && values[left].size() + values[right].size() < 20000) {
+                expressions.push_back(expressions[left] * expressions[right]);
+                values.push_back(ReferenceArithmetic::multiply(values[left], values[right]));
+            }
+            else if (operation % 2 == 0) {
+                expressions.push_back(expressions[left] + expressions[right]);
+                values.push_back(ReferenceArithmetic::add(values[left], values[right]));
+            }
+            else {
+                expressions.push_back(expressions[left] - expressions[right]);
+                values.push_back(ReferenceArithmetic::subtract(values[left], values[right]));
+            }
+        }
+        for (size_t i = 0; i < expressions.size(); i++) {
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(expressions[i].evaluate()), values[i]);
+        }
+
+        // Building the same operation again returns the existing node
+        Expression first = expressions[0] + expressions[1];
+        ExpressionGraphStats before = graph.getStats();
+        Expression again = expressions[0] + expressions[1];
+        CHECK_EQUAL(graph.getStats().nodes, before.nodes);
+        CHECK_EQUAL(graph.getStats().sharedBuilds, before.sharedBuilds + 1);
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(first.evaluate()), ReferenceArithmetic::digitsOf(again.evaluate()));
+        CHECK_EQUAL(ReferenceArithmetic::digitsOf(again.evaluate()), ReferenceArithmetic::add(values[0], values[1]));
+    }
+}
+
+LARGE_NUMBER_TEST(sums, expression_graph_invalidation) {
+    LargeNumber x("1000000000000000000000000000000000000000000000000000000000000000000000000000");
+    LargeNumber y("-1");
+    ExpressionGraph graph;
+    Expression a = graph.variable(x);
+    Expression b = graph.variable(y);
+    Expression total = (a + b) * (a - b) + a;
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(total.evaluate()),
+        ReferenceArithmetic::add(ReferenceArithmetic::multiply(ReferenceArithmetic::digitsOf(x + y), ReferenceArithmetic::digitsOf(x - y)),
+            ReferenceArithmetic::digitsOf(x)));
+    size_t hits = graph.getStats().cacheHits;
+    total.evaluate();
+    CHECK(graph.getStats().cacheHits > hits);
+
+    // A changed variable is read again once invalidated
+    y = LargeNumber("12345");
+    graph.invalidate(y);
+    string expected = ReferenceArithmetic::add(ReferenceArithmetic::multiply(ReferenceArithmetic::digitsOf(x + y),
+        ReferenceArithmetic::digitsOf(x - y)), ReferenceArithmetic::digitsOf(x));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(total.evaluate()), expected);
+    x.modifyNode(0, 7);
+    graph.invalidate();
+    expected = ReferenceArithmetic::add(ReferenceArithmetic::multiply(ReferenceArithmetic::digitsOf(x + y),
+        ReferenceArithmetic::digitsOf(x - y)), ReferenceArithmetic::digitsOf(x));
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(total.evaluate()), expected);
+}
+
+LARGE_NUMBER_TEST(sums, accumulator_against_reference) {
+    mt19937_64 generator(53);
+    vector<LargeNumber> numbers;
+    vector<string> digits;
+    makeOperands(300, generator, numbers, digits);
+
+    // Add and subtract one at a time, reading the value part way through
+    LargeNumberAccumulator accumulator;
+    LargeNumberAccumulator other;
+    string expected = "0";
+    string otherExpected = "0";
+    for (size_t i = 0; i < numbers.size(); i++) {
+        bool subtract = generator() % 3 == 0;
+        LargeNumberAccumulator& target = i % 2 == 0 ? accumulator : other;
+        string& total = i % 2 == 0 ? expected : otherExpected;
+        if (subtract) {
+            target -= numbers[i];
+            total = ReferenceArithmetic::subtract(total, digits[i]);
+        }
+        else {
+            target += numbers[i];
+            total = ReferenceArithmetic::add(total, digits[i]);
+        }
+        if (i % 50 == 0) {
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(target.getValue()), total);
+        }
+    }
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(accumulator.getValue()), expected);
+    accumulator.merge(other);
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(accumulator.getValue()), ReferenceArithmetic::add(expected, otherExpected));
+    CHECK_EQUAL(accumulator.getTermCount(), numbers.size());
+
+    // Borrows that run the whole length, and a total that returns to zero
+    accumulator.clear();
+    LargeNumber one("1");
+    LargeNumber nines(string(5000, '9'));
+    accumulator += one;
+    accumulator -= nines;
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(accumulator.getValue()), ReferenceArithmetic::subtract("1", string(5000, '9')));
+    accumulator += nines;
+    accumulator -= one;
+    CHECK_EQUAL(ReferenceArithmetic::digitsOf(accumulator.getValue()), string("0"));
+    CHECK(!accumulator.getValue().isNegative());
+}
+
+LARGE_NUMBER_TEST(sums, accumulator_range_sum) {
+    mt19937_64 generator(54);
+    size_t cutoff = ThreadPool::getParallelCutoff();
+    const size_t cutoffs[] = { cutoff, 1000 };
+    for (size_t parallelCutoff : cutoffs) {
+        ThreadPool::setParallelCutoff(parallelCutoff);
+        const size_t counts[] = { 0, 1, 7, 500 };
+        for (size_t count : counts) {
+            vector<LargeNumber> numbers;
+            vector<string> digits;
+            makeOperands(count, generator, numbers, digits);
+            string expected = "0";
+            for (const string& value : digits) {
+                expected = ReferenceArithmetic::add(expected, value);
+            }
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumberAccumulator::sum(numbers)), expected);
+            CHECK_EQUAL(ReferenceArithmetic::digitsOf(LargeNumberAccumulator::sum(numbers.begin(), numbers.end())), expected);
+        }
+    }
+    ThreadPool::setParallelCutoff(cutoff);
+}
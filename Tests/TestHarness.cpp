@@ -0,0 +1,96 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the TestHarness class defined in
+    TestHarness.h and the entry point of LargeNumberTests.
+    Usage: LargeNumberTests [suite]
+    A test that throws counts as failed, and the program exits
+    with 1 if any test failed or the suite name matched nothing.
+    It requires TestHarness.h, <exception>, <iostream>, <string>,
+    and <vector> to run.
+-------------------------------------------------- */
+
+#include "TestHarness.h"
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+    struct TestCase {
+        const char* suite;
+        const char* name;
+        void (*run)();
+    };
+
+    // Checks print at most this many characters, so failures on long numbers stay readable
+    const size_t MAX_MESSAGE_LENGTH = 400;
+
+    // Registered tests, built during static initialization
+    vector<TestCase>& registry() {
+        static vector<TestCase> tests;
+        return tests;
+    }
+
+    int failedChecks = 0;
+}
+
+// Add a test to the registry
+bool TestHarness::add(const char* suite, const char* name, void (*run)()) {
+    registry().push_back(TestCase{ suite, name, run });
+    return true;
+}
+
+// Record a failed check for the running test
+void TestHarness::fail(const char* file, int line, const string& message) {
+    failedChecks++;
+    cout << "    " << file << ":" << line << ": ";
+    if (message.size() > MAX_MESSAGE_LENGTH) {
+        cout << message.substr(0, MAX_MESSAGE_LENGTH) << "...";
+    }
+    else {
+        cout << message;
+    }
+    cout << endl;
+}
+
+// Run the tests of one suite, or every suite when suite is empty
+int TestHarness::run(const string& suite) {
+    int ran = 0;
+    int failedTests = 0;
+    for (const TestCase& test : registry()) {
+        if (!suite.empty() && suite != test.suite) {
+            continue;
+        }
+        cout << test.suite << "." << test.name << endl;
+        int failedBefore = failedChecks;
+        try {
+            test.run();
+        }
+        catch (const exception& e) {
+            fail(__FILE__, __LINE__, string("Unexpected exception: ") + e.what());
+        }
+        catch (...) {
+            fail(__FILE__, __LINE__, "Unexpected exception");
+        }
+        if (failedChecks > failedBefore) {
+            failedTests++;
+        }
+        ran++;
+    }
+    if (ran == 0) {
+        cout << "No tests in suite \"" << suite << "\"" << endl;
+        return 1;
+    }
+    cout << ran - failedTests << " of " << ran << " tests passed" << endl;
+    return failedTests;
+}
+
+int main(int argc, char* argv[]) {
+    string suite = argc > 1 ? argv[1] : "";
+    return TestHarness::run(suite) == 0 ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the small test harness behind the
+    LargeNumberTests program. Tests register themselves under a
+    suite name with LARGE_NUMBER_TEST, and the CHECK macros
+    record a failure with its file and line and carry on, so one
+    run reports every broken case. CTest runs each suite as its
+    own test by passing the suite name on the command line.
+    This file requires <sstream> and <string>.
+-------------------------------------------------- */
+
+#ifndef TEST_HARNESS_H
+#define TEST_HARNESS_H
+
+#include <sstream>
+#include <string>
+
+class TestHarness {
+public:
+
+    // Add a test to the registry (used by LARGE_NUMBER_TEST); always returns true
+    static bool add(const char* suite, const char* name, void (*run)());
+
+    // Record a failed check for the running test
+    static void fail(const char* file, int line, const std::string& message);
+
+    // Run the tests of one suite, or every suite when suite is empty; returns the failed test count
+    static int run(const std::string& suite);
+
+private:
+    TestHarness() = delete;
+};
+
+// Define and register a test function
+#define LARGE_NUMBER_TEST(suite, name) \
+    static void suite##_##name(); \
+    static const bool suite##_##name##_registered = TestHarness::add(#suite, #name, suite##_##name); \
+    static void suite##_##name()
+
+// Check a condition
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            TestHarness::fail(__FILE__, __LINE__, "CHECK(" #condition ")"); \
+        } \
+    } while (false)
+
+// Check that two printable values are equal, reporting both when they differ
+#define CHECK_EQUAL(actual, expected) \
+    do { \
+        auto actualValue = (actual); \
+        auto expectedValue = (expected); \
+        if (!(actualValue == expectedValue)) { \
+            std::ostringstream message; \
+            message << "CHECK_EQUAL(" #actual ", " #expected "): got " << actualValue \
+                << ", expected " << expectedValue; \
+            TestHarness::fail(__FILE__, __LINE__, message.str()); \
+        } \
+    } while (false)
+
+// Check that a statement throws an exception of the given type
+#define CHECK_THROWS(statement, exceptionType) \
+    do { \
+        bool thrown = false; \
+        try { \
+            statement; \
+        } \
+        catch (const exceptionType&) { \
+            thrown = true; \
+        } \
+        catch (...) { \
+        } \
+        if (!thrown) { \
+            TestHarness::fail(__FILE__, __LINE__, "CHECK_THROWS(" #statement ", " #exceptionType ")"); \
+        } \
+    } while (false)
+
+#endif // TEST_HARNESS_H
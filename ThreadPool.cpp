@@ -0,0 +1,219 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the ThreadPool and TaskGroup classes
+    defined in ThreadPool.h. Every worker owns a mutex-guarded
+    deque; threads outside the pool share one extra deque. Idle
+    workers sleep on a condition variable until the count of
+    queued tasks is nonzero.
+    It requires ThreadPool.h and <algorithm> to run.
+-------------------------------------------------- */
+
+#include "ThreadPool.h"
+#include <algorithm> // For element ranges (max())
+
+using namespace std;
+
+namespace {
+
+    // Pool and deque index of the current thread, if it is a worker
+    thread_local ThreadPool* currentPool = nullptr;
+    thread_local size_t currentIndex = 0;
+
+    // Shared pool configuration
+    mutex sharedLock;
+    unique_ptr<ThreadPool> sharedPool;
+    atomic<size_t> sharedThreadCount{ ThreadPool::getDefaultThreadCount() };
+    atomic<size_t> parallelCutoff{ 1000000 };
+}
+
+// Start threadCount - 1 workers; the waiting thread is the last one
+ThreadPool::ThreadPool(size_t threadCount) : queued(0), stopping(false) {
+    size_t workerCount = max<size_t>(threadCount, 1) - 1;
+    for (size_t i = 0; i <= workerCount; i++) {
+        queues.emplace_back(new WorkerQueue());
+    }
+    for (size_t i = 0; i < workerCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+// Finish queued tasks, then stop and join the workers
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    // Without workers, anything still queued runs here
+    function<void()> task;
+    while (takeTask(queues.size() - 1, task)) {
+        task();
+    }
+}
+
+void ThreadPool::submit(function<void()> task) {
+    size_t target = currentPool == this ? currentIndex : queues.size() - 1;
+    {
+        lock_guard<mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(move(task));
+    }
+    queued.fetch_add(1);
+    {
+        lock_guard<mutex> guard(sleepLock);
+    }
+    wakeUp.notify_one();
+}
+
+bool ThreadPool::runPendingTask() {
+    function<void()> task;
+    if (!takeTask(currentPool == this ? currentIndex : queues.size() - 1, task)) {
+        return false;
+    }
+    task();
+    return true;
+}
+
+void ThreadPool::parallelFor(size_t count, const function<void(size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    TaskGroup group(*this);
+    for (size_t i = 1; i < count; i++) {
+        group.run([&body, i]() { body(i); });
+    }
+    group.run([&body]() { body(0); });
+    group.wait();
+}
+
+// Newest task from the preferred deque, otherwise the oldest task of another deque
+bool ThreadPool::takeTask(size_t preferred, function<void()>& task) {
+    if (queued.load() == 0) {
+        return false;
+    }
+    {
+        WorkerQueue& own = *queues[preferred];
+        lock_guard<mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = move(own.tasks.back());
+            own.tasks.pop_back();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < queues.size(); offset++) {
+        WorkerQueue& victim = *queues[(preferred + offset) % queues.size()];
+        lock_guard<mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentIndex = index;
+    while (true) {
+        function<void()> task;
+        if (takeTask(index, task)) {
+            task();
+            continue;
+        }
+        unique_lock<mutex> guard(sleepLock);
+        wakeUp.wait(guard, [this]() { return stopping.load() || queued.load() > 0; });
+        if (stopping.load() && queued.load() == 0) {
+            return;
+        }
+    }
+}
+
+// Create the shared pool on first use
+ThreadPool& ThreadPool::shared() {
+    lock_guard<mutex> guard(sharedLock);
+    if (!sharedPool) {
+        sharedPool.reset(new ThreadPool(sharedThreadCount.load()));
+    }
+    return *sharedPool;
+}
+
+// Rebuild the shared pool with a new thread count (0 means one per hardware thread)
+void ThreadPool::setThreadCount(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = getDefaultThreadCount();
+    }
+    lock_guard<mutex> guard(sharedLock);
+    sharedPool.reset();
+    sharedThreadCount.store(threadCount);
+}
+
+size_t ThreadPool::getDefaultThreadCount() {
+    return max<size_t>(thread::hardware_concurrency(), 1);
+}
+
+void ThreadPool::setParallelCutoff(size_t digits) {
+    parallelCutoff.store(digits, memory_order_relaxed);
+}
+
+size_t ThreadPool::getParallelCutoff() {
+    return parallelCutoff.load(memory_order_relaxed);
+}
+
+// True when an operand of this many digits should be split across threads
+bool ThreadPool::shouldParallelize(size_t digits) {
+    return digits >= parallelCutoff.load(memory_order_relaxed) && sharedThreadCount.load(memory_order_relaxed) > 1;
+}
+
+TaskGroup::TaskGroup(ThreadPool& pool) : pool(pool), pending(0) {}
+
+// Tasks refer to the group, so it must not go away before they finish
+TaskGroup::~TaskGroup() {
+    try {
+        wait();
+    }
+    catch (...) {
+    }
+}
+
+// Queue a task, recording the first exception it throws
+void TaskGroup::run(function<void()> task) {
+    pending.fetch_add(1);
+    pool.submit([this, task]() {
+        try {
+            task();
+        }
+        catch (...) {
+            lock_guard<mutex> guard(errorLock);
+            if (!error) {
+                error = current_exception();
+            }
+        }
+        pending.fetch_sub(1);
+    });
+}
+
+// Help with queued tasks until this group's tasks are done
+void TaskGroup::wait() {
+    while (pending.load() > 0) {
+        if (!pool.runPendingTask()) {
+            this_thread::yield();
+        }
+    }
+    exception_ptr failure;
+    {
+        lock_guard<mutex> guard(errorLock);
+        failure = error;
+        error = nullptr;
+    }
+    if (failure) {
+        rethrow_exception(failure);
+    }
+}
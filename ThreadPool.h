@@ -0,0 +1,98 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the ThreadPool and TaskGroup classes
+    used to spread very large arithmetic across cores. Each worker
+    keeps its own task deque: it takes its newest task first and,
+    when empty, steals the oldest task from another worker. A
+    thread waiting on a TaskGroup runs queued tasks meanwhile, so
+    recursive algorithms can fork inside tasks without deadlock.
+    The shared pool has a configurable thread count and a size
+    cutoff, in decimal digits, below which arithmetic stays on
+    the calling thread.
+    This file requires <atomic>, <cstddef>, <deque>, <exception>,
+    <functional>, <memory>, <mutex>, <condition_variable>, <thread>,
+    and <vector>.
+-------------------------------------------------- */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+
+    // Pool with threadCount threads in total, counting the thread that waits on tasks
+    explicit ThreadPool(size_t threadCount);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t getThreadCount() const { return workers.size() + 1; }
+
+    // Queue a task; a worker thread pushes onto its own deque
+    void submit(std::function<void()> task);
+
+    // Run one queued task on the calling thread, returning false if none was found
+    bool runPendingTask();
+
+    // Run body(i) for every i in [0, count) and wait for all of them
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    // Shared pool used by the arithmetic (reconfigure only while no arithmetic is running)
+    static ThreadPool& shared();
+    static void setThreadCount(size_t threadCount);
+    static size_t getDefaultThreadCount();
+
+    // Operands shorter than the cutoff, in decimal digits, stay single-threaded
+    static void setParallelCutoff(size_t digits);
+    static size_t getParallelCutoff();
+    static bool shouldParallelize(size_t digits);
+
+private:
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkerQueue>> queues; // One per worker, plus one for outside threads
+    std::mutex sleepLock;
+    std::condition_variable wakeUp;
+    std::atomic<size_t> queued;
+    std::atomic<bool> stopping;
+
+    void workerLoop(size_t index);
+    bool takeTask(size_t preferred, std::function<void()>& task);
+};
+
+// Fork-join helper: run tasks on a pool and wait for them, rethrowing the first failure
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool);
+    ~TaskGroup();
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(std::function<void()> task);
+    void wait();
+
+private:
+    ThreadPool& pool;
+    std::atomic<size_t> pending;
+    std::mutex errorLock;
+    std::exception_ptr error;
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,140 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This file implements the WordArithmetic helpers defined
+    in WordArithmetic.h. Every result is trimmed of high zero
+    words so that the length of a magnitude is meaningful.
+    It requires WordArithmetic.h and <algorithm> to run.
+-------------------------------------------------- */
+
+#include "WordArithmetic.h"
+#include <algorithm> // For element ranges (min())
+
+using namespace std;
+
+const uint32_t WordArithmetic::BASE;
+
+// Drop high zero words
+void WordArithmetic::trim(Words& words) {
+    while (!words.empty() && words.back() == 0) {
+        words.pop_back();
+    }
+}
+
+// Copy words [from, to) of a magnitude, clamped to its length
+Words WordArithmetic::slice(const Words& words, size_t from, size_t to) {
+    from = min(from, words.size());
+    to = min(to, words.size());
+    Words part(words.begin() + from, words.begin() + to);
+    trim(part);
+    return part;
+}
+
+// Multiply by BASE^count
+Words WordArithmetic::shiftLeft(const Words& words, size_t count) {
+    if (words.empty()) {
+        return Words();
+    }
+    Words shifted(count, 0);
+    shifted.insert(shifted.end(), words.begin(), words.end());
+    return shifted;
+}
+
+// Divide by BASE^count, discarding the remainder
+Words WordArithmetic::shiftRight(const Words& words, size_t count) {
+    return slice(words, count, words.size());
+}
+
+int WordArithmetic::compare(const Words& a, const Words& b) {
+    if (a.size() != b.size()) {
+        return a.size() < b.size() ? -1 : 1;
+    }
+    for (size_t i = a.size(); i > 0; i--) {
+        if (a[i - 1] != b[i - 1]) {
+            return a[i - 1] < b[i - 1] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+Words WordArithmetic::add(const Words& a, const Words& b) {
+    Words sum(a);
+    addInPlace(sum, b);
+    return sum;
+}
+
+void WordArithmetic::addInPlace(Words& a, const Words& b) {
+    addShifted(a, b, 0);
+}
+
+// Add a magnitude multiplied by BASE^shift into out
+void WordArithmetic::addShifted(Words& out, const Words& value, size_t shift) {
+    if (value.empty()) {
+        return;
+    }
+    if (out.size() < value.size() + shift) {
+        out.resize(value.size() + shift, 0);
+    }
+    uint32_t carry = 0;
+    size_t i = 0;
+    for (; i < value.size(); i++) {
+        uint32_t sum = out[i + shift] + value[i] + carry;
+        carry = sum >= BASE ? 1 : 0;
+        out[i + shift] = carry ? sum - BASE : sum;
+    }
+    for (i += shift; carry; i++) {
+        if (i == out.size()) {
+            out.push_back(0);
+        }
+        uint32_t sum = out[i] + carry;
+        carry = sum >= BASE ? 1 : 0;
+        out[i] = carry ? sum - BASE : sum;
+    }
+}
+
+// Subtract b from a in place (a must not be smaller than b)
+void WordArithmetic::subtractInPlace(Words& a, const Words& b) {
+    uint32_t borrow = 0;
+    for (size_t i = 0; i < a.size() && (i < b.size() || borrow); i++) {
+        uint32_t subtrahend = (i < b.size() ? b[i] : 0) + borrow;
+        borrow = a[i] < subtrahend ? 1 : 0;
+        a[i] = borrow ? a[i] + BASE - subtrahend : a[i] - subtrahend;
+    }
+    trim(a);
+}
+
+void WordArithmetic::increment(Words& a) {
+    addShifted(a, Words(1, 1), 0);
+}
+
+// Subtract one (a must be positive)
+void WordArithmetic::decrement(Words& a) {
+    subtractInPlace(a, Words(1, 1));
+}
+
+Words WordArithmetic::multiplySmall(const Words& a, uint32_t factor) {
+    Words product(a.size() + 1);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        uint64_t value = static_cast<uint64_t>(a[i]) * factor + carry;
+        product[i] = static_cast<uint32_t>(value % BASE);
+        carry = value / BASE;
+    }
+    product[a.size()] = static_cast<uint32_t>(carry);
+    trim(product);
+    return product;
+}
+
+// Divide by a single word, returning the remainder
+uint32_t WordArithmetic::divideSmall(const Words& a, uint32_t divisor, Words& quotient) {
+    quotient.assign(a.size(), 0);
+    uint64_t remainder = 0;
+    for (size_t i = a.size(); i > 0; i--) {
+        uint64_t value = remainder * BASE + a[i - 1];
+        quotient[i - 1] = static_cast<uint32_t>(value / divisor);
+        remainder = value % divisor;
+    }
+    trim(quotient);
+    return static_cast<uint32_t>(remainder);
+}
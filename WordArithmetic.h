@@ -0,0 +1,48 @@
+/*  LV Marlowe
+    SDEV-345: Data Structures & Algorithms
+    Week 7: Assignment
+    13 Oct 2024
+    This header file defines the WordArithmetic class, a set
+    of helpers shared by the multiplication and division kernels.
+    They work on magnitudes stored as base 10^9 words, least
+    significant word first, with no high zero words.
+    This file requires <cstddef>, <cstdint>, and <vector>.
+-------------------------------------------------- */
+
+#ifndef WORD_ARITHMETIC_H
+#define WORD_ARITHMETIC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+typedef std::vector<uint32_t> Words;
+
+class WordArithmetic {
+public:
+    static const uint32_t BASE = 1000000000;
+
+    // Shape helpers
+    static void trim(Words& words);
+    static Words slice(const Words& words, size_t from, size_t to);
+    static Words shiftLeft(const Words& words, size_t count);
+    static Words shiftRight(const Words& words, size_t count);
+
+    // Comparison and linear arithmetic
+    static int compare(const Words& a, const Words& b);
+    static Words add(const Words& a, const Words& b);
+    static void addInPlace(Words& a, const Words& b);
+    static void addShifted(Words& out, const Words& value, size_t shift);
+    static void subtractInPlace(Words& a, const Words& b);
+    static void increment(Words& a);
+    static void decrement(Words& a);
+
+    // Arithmetic with a single word
+    static Words multiplySmall(const Words& a, uint32_t factor);
+    static uint32_t divideSmall(const Words& a, uint32_t divisor, Words& quotient);
+
+private:
+    WordArithmetic() = delete;
+};
+
+#endif // WORD_ARITHMETIC_H